@@ -374,6 +374,8 @@ static gboolean get_window_frame(GtkWindow *win, int *x, int *y, int *w, int *h)
   return TRUE;
 }
 
+static void run_action(PROCESS_ACTION *a);
+
 static gboolean repeat_cb(gpointer data) {
   //
   // This is periodically called to execute the same action
@@ -384,9 +386,8 @@ static gboolean repeat_cb(gpointer data) {
     repeat_timer = 0;
     return G_SOURCE_REMOVE;
   }
-  PROCESS_ACTION *a = g_new(PROCESS_ACTION, 1);
-  *a = repeat_action;
-  process_action(a);                 // übernimmt g_free()
+  PROCESS_ACTION a = repeat_action;
+  run_action(&a);
   return G_SOURCE_CONTINUE;
 }
 
@@ -451,11 +452,171 @@ static inline double KnobOrWheel(const PROCESS_ACTION *a, double oldval, double
 }
 
 //
-// This interface puts an "action" into the GTK idle queue,
+// Action queue.
+//
+// schedule_action() is called from the GTK thread and from the MIDI, GPIO,
+// CAT and TCI threads. Actions are put into a fixed-size lock-free ring
+// (bounded multi-producer queue, one sequence number per slot) and a single
+// idle callback drains the ring on the GTK thread. While draining,
+// consecutive RELATIVE (ABSOLUTE) events for the same action are merged
+// such that a fast spun knob results in one action with the summed
+// increments (the last value).
+//
+// If the ring is full, the action is scheduled via its own g_idle_add().
+//
+#define ACTION_QUEUE_SIZE 256
+#define ACTION_QUEUE_MASK (ACTION_QUEUE_SIZE - 1)
+
+typedef struct {
+  gint seq;
+  PROCESS_ACTION a;
+  gint64 t_queued;
+} ACTION_SLOT;
+
+static ACTION_SLOT action_ring[ACTION_QUEUE_SIZE];
+static gint action_head = 0;          // next slot to fill (producers)
+static gint action_tail = 0;          // next slot to drain (GTK thread only)
+static gint action_drain_pending = 0;
+
+// producer side statistics (atomic)
+static gint aq_queued = 0;
+static gint aq_overflow = 0;
+static gint aq_depth_max = 0;
+// consumer side statistics (GTK thread)
+static unsigned long aq_executed = 0;
+static unsigned long aq_merged = 0;
+static gint64 aq_lat_sum_us = 0;
+static gint64 aq_lat_max_us = 0;
+
+static void action_queue_init(void) {
+  static gsize initialized = 0;
+  if (g_once_init_enter(&initialized)) {
+    for (int i = 0; i < ACTION_QUEUE_SIZE; i++) {
+      g_atomic_int_set(&action_ring[i].seq, i);
+    }
+    g_once_init_leave(&initialized, 1);
+  }
+}
+
+static gboolean action_queue_push(const PROCESS_ACTION *a) {
+  ACTION_SLOT *slot;
+  guint pos = (guint) g_atomic_int_get(&action_head);
+  for (;;) {
+    slot = &action_ring[pos & ACTION_QUEUE_MASK];
+    gint diff = (gint)((guint) g_atomic_int_get(&slot->seq) - pos);
+    if (diff == 0) {
+      if (g_atomic_int_compare_and_exchange(&action_head, (gint) pos, (gint)(pos + 1))) {
+        break;
+      }
+    } else if (diff < 0) {
+      return FALSE;                   // queue full
+    }
+    pos = (guint) g_atomic_int_get(&action_head);
+  }
+  slot->a = *a;
+  slot->t_queued = g_get_monotonic_time();
+  g_atomic_int_set(&slot->seq, (gint)(pos + 1));
+  gint depth = (gint)(pos + 1 - (guint) g_atomic_int_get(&action_tail));
+  gint old = g_atomic_int_get(&aq_depth_max);
+  while (depth > old && !g_atomic_int_compare_and_exchange(&aq_depth_max, old, depth)) {
+    old = g_atomic_int_get(&aq_depth_max);
+  }
+  g_atomic_int_inc(&aq_queued);
+  return TRUE;
+}
+
+static gboolean action_queue_pop(PROCESS_ACTION *a, gint64 *t_queued) {
+  guint tail = (guint) g_atomic_int_get(&action_tail);
+  ACTION_SLOT *slot = &action_ring[tail & ACTION_QUEUE_MASK];
+  if ((guint) g_atomic_int_get(&slot->seq) != tail + 1) {
+    return FALSE;                     // empty, or producer still writing
+  }
+  *a = slot->a;
+  *t_queued = slot->t_queued;
+  g_atomic_int_set(&slot->seq, (gint)(tail + ACTION_QUEUE_SIZE));
+  g_atomic_int_set(&action_tail, (gint)(tail + 1));
+  return TRUE;
+}
+
+static void action_queue_execute(PROCESS_ACTION *a, gint64 t_queued) {
+  gint64 us = g_get_monotonic_time() - t_queued;
+  aq_executed++;
+  aq_lat_sum_us += us;
+  if (us > aq_lat_max_us) { aq_lat_max_us = us; }
+  run_action(a);
+}
+
+//
+// These actions take the value of a RELATIVE event as the turning
+// speed, not as a number of steps, so their events must not be summed up.
+//
+static gboolean action_can_merge(const PROCESS_ACTION *a) {
+  switch (a->action) {
+  case MNF_CENTER:
+  case MNF_BW:
+  case VFO_FIX:
+    return a->mode == ABSOLUTE;
+  default:
+    return a->mode == RELATIVE || a->mode == ABSOLUTE;
+  }
+}
+
+static gboolean action_queue_drain(gpointer data) {
+  PROCESS_ACTION cur, next;
+  gint64 t_cur = 0, t_next;
+  int have = 0;
+  //
+  // Clear the flag first: actions queued from now on schedule
+  // a new drain, so at most ACTION_QUEUE_SIZE entries are handled here.
+  //
+  g_atomic_int_set(&action_drain_pending, 0);
+  for (int n = 0; n < ACTION_QUEUE_SIZE && action_queue_pop(&next, &t_next); n++) {
+    if (have && next.action == cur.action && next.mode == cur.mode && action_can_merge(&cur)) {
+      if (cur.mode == RELATIVE) {
+        cur.val += next.val;
+      } else {
+        cur.val = next.val;
+      }
+      aq_merged++;
+      continue;
+    }
+    if (have) {
+      action_queue_execute(&cur, t_cur);
+    }
+    cur = next;
+    t_cur = t_next;
+    have = 1;
+  }
+  if (have) {
+    action_queue_execute(&cur, t_cur);
+  }
+  return G_SOURCE_REMOVE;
+}
+
+void action_queue_get_stats(ACTION_QUEUE_STATS *stats) {
+  stats->queued = (unsigned long) g_atomic_int_get(&aq_queued);
+  stats->overflow = (unsigned long) g_atomic_int_get(&aq_overflow);
+  stats->depth_max = (unsigned int) g_atomic_int_get(&aq_depth_max);
+  stats->executed = aq_executed;
+  stats->merged = aq_merged;
+  stats->avg_ms = aq_executed > 0 ? 0.001 * (double) aq_lat_sum_us / (double) aq_executed : 0.0;
+  stats->max_ms = 0.001 * (double) aq_lat_max_us;
+  g_atomic_int_set(&aq_queued, 0);
+  g_atomic_int_set(&aq_overflow, 0);
+  g_atomic_int_set(&aq_depth_max, 0);
+  aq_executed = 0;
+  aq_merged = 0;
+  aq_lat_sum_us = 0;
+  aq_lat_max_us = 0;
+}
+
+//
+// This interface puts an "action" into the action queue,
 // but "CW key" actions are processed immediately
 //
 void schedule_action(enum ACTION action, enum ACTION_MODE mode, int val) {
   PROCESS_ACTION *a;
+  PROCESS_ACTION qa;
   switch (action) {
   case CW_LEFT:
   case CW_RIGHT:
@@ -483,19 +644,33 @@ void schedule_action(enum ACTION action, enum ACTION_MODE mode, int val) {
     break;
   default:
     //
-    // schedule action through GTK idle queue
+    // schedule action through the action queue
     //
-    a = g_new(PROCESS_ACTION, 1);
-    a->action = action;
-    a->mode = mode;
-    a->val = val;
-    g_idle_add(process_action, a);
+    action_queue_init();
+    qa.action = action;
+    qa.mode = mode;
+    qa.val = val;
+    if (action_queue_push(&qa)) {
+      if (g_atomic_int_compare_and_exchange(&action_drain_pending, 0, 1)) {
+        g_idle_add(action_queue_drain, NULL);
+      }
+    } else {
+      g_atomic_int_inc(&aq_overflow);
+      a = g_new(PROCESS_ACTION, 1);
+      *a = qa;
+      g_idle_add(process_action, a);
+    }
     break;
   }
 }
 
 int process_action(void *data) {
-  PROCESS_ACTION *a = (PROCESS_ACTION *) data;
+  run_action((PROCESS_ACTION *) data);
+  g_free(data);
+  return 0;
+}
+
+static void run_action(PROCESS_ACTION *a) {
   double value;
   int i;
   //t_print("%s: a=%p action=%d mode=%d value=%d\n",__func__,a,a->action,a->mode,a->val);
@@ -1374,12 +1549,11 @@ int process_action(void *data) {
       multi_action = KnobOrWheel(a, multi_action, 0, VMAXMULTIACTION - 1, 1);
       g_idle_add(ext_vfo_update, NULL);
     } else {
-      PROCESS_ACTION *multifunction_action;
-      multifunction_action = g_new(PROCESS_ACTION, 1);
-      multifunction_action->mode = a->mode;
-      multifunction_action->val = a->val;
-      multifunction_action->action = multi_action_table[multi_action].action;
-      process_action((void *) multifunction_action);
+      PROCESS_ACTION multifunction_action;
+      multifunction_action.mode = a->mode;
+      multifunction_action.val = a->val;
+      multifunction_action.action = multi_action_table[multi_action].action;
+      run_action(&multifunction_action);
     }
     g_idle_add(ext_vfo_update, NULL);
     break;
@@ -2196,8 +2370,6 @@ int process_action(void *data) {
     }
     break;
   }
-  g_free(data);
-  return 0;
 }
 
 //
@@ -294,11 +294,22 @@ typedef struct process_action {
   int val;
 } PROCESS_ACTION;
 
+typedef struct {
+  unsigned long queued;     // actions put into the action queue
+  unsigned long executed;   // actions executed (after merging)
+  unsigned long merged;     // knob/wheel events merged into the preceding one
+  unsigned long overflow;   // queue full, scheduled by g_idle_add instead
+  unsigned int depth_max;   // max. queue depth
+  double avg_ms;            // avg. time from schedule_action() to execution
+  double max_ms;
+} ACTION_QUEUE_STATS;
+
 extern ACTION_TABLE ActionTable[ACTIONS + 1];
 extern int is_cap;
 
 extern int process_action(void *data);
 extern void schedule_action(enum ACTION action, enum ACTION_MODE mode, int val);
+extern void action_queue_get_stats(ACTION_QUEUE_STATS *stats);
 extern void Action2String(const int id, char *str, size_t len);
 extern int  String2Action(const char *str);
 extern void GetMultifunctionString(char *str, size_t len);
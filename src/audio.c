@@ -62,6 +62,7 @@ static const int cw_high_water = 1152;                // high water mark for CW
 #include "mode.h"
 #include "vfo.h"
 #include "message.h"
+#include "thread_role.h"
 
 int audio = 0;
 GMutex audio_mutex;
@@ -727,6 +728,7 @@ int audio_write(RECEIVER *rx, float left_sample, float right_sample) {
 }
 
 static void *mic_read_thread(gpointer arg) {
+  thread_role_enter(THREAD_ROLE_AUDIO, "ALSA mic");
   int rc;
   const float *float_buffer;
   const int32_t *long_buffer;
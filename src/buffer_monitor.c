@@ -19,12 +19,16 @@
 #include <gtk/gtk.h>
 #include <math.h>
 #include <string.h>
+#include <wdsp.h>
 
+#include "actions.h"
 #include "audio.h"
 #include "buffer_monitor.h"
 #include "main.h"
 #include "new_protocol.h"
+#include "old_protocol.h"
 #include "radio.h"
+#include "transmitter.h"
 
 #define BUFFER_MONITOR_WIDTH   390
 #define BUFFER_MONITOR_ROW_H    48
@@ -133,6 +137,50 @@ static void buffer_monitor_collect(void) {
       }
     }
   }
+  if (protocol == ORIGINAL_PROTOCOL && n < BUFFER_MONITOR_MAX_ROWS) {
+    //
+    // Time from marking a C&C register group dirty until it is sent
+    //
+    P1_CC_DIAG diag;
+    char value[64];
+    old_protocol_get_cc_diag(&diag);
+    if (diag.updates > 0) {
+      g_snprintf(value, sizeof(value), "%.1f ms   max %.1f ms", diag.avg_ms, diag.max_ms);
+    } else {
+      g_snprintf(value, sizeof(value), "idle");
+    }
+    row_update(n++, "P1 C&C Update", value, diag.avg_ms, diag.avg_ms / 10.0, diag.updates > 0);
+  }
+  if (n < BUFFER_MONITOR_MAX_ROWS) {
+    //
+    // Time from schedule_action() until the action is executed
+    //
+    ACTION_QUEUE_STATS stats;
+    char value[64];
+    action_queue_get_stats(&stats);
+    if (stats.executed > 0) {
+      g_snprintf(value, sizeof(value), "%.1f ms   max %.1f ms   depth %u",
+                 stats.avg_ms, stats.max_ms, stats.depth_max);
+    } else {
+      g_snprintf(value, sizeof(value), "idle");
+    }
+    row_update(n++, "Action Queue", value, stats.avg_ms, stats.avg_ms / 20.0, stats.executed > 0);
+  }
+  if (can_transmit && transmitter->puresignal && n < BUFFER_MONITOR_MAX_ROWS) {
+    //
+    // Time spent by the PS worker per feedback block
+    //
+    PS_FEEDBACK_STATS stats;
+    char value[64];
+    tx_ps_feedback_get_stats(&stats);
+    if (stats.blocks > 0 || stats.dropped > 0) {
+      g_snprintf(value, sizeof(value), "%.1f ms   max %.1f ms   drop %lu",
+                 stats.avg_ms, stats.max_ms, stats.dropped);
+    } else {
+      g_snprintf(value, sizeof(value), "idle");
+    }
+    row_update(n++, "PS Feedback", value, stats.avg_ms, stats.avg_ms / 10.0, stats.blocks > 0);
+  }
   for (int rx = 0; rx < receivers && n < BUFFER_MONITOR_MAX_ROWS; rx++) {
     if (receiver[rx] == NULL) {
       continue;
@@ -193,6 +241,38 @@ static void buffer_monitor_collect(void) {
                  (double)diag.queued / scale, 1);
     }
   }
+  for (int rx = 0; rx < receivers && n < BUFFER_MONITOR_MAX_ROWS; rx++) {
+    //
+    // WDSP time per RXA block, summed over the active stages,
+    // and the most expensive stage
+    //
+    if (receiver[rx] == NULL) {
+      continue;
+    }
+    char name[32];
+    char value[64];
+    double total = 0.0, top = 0.0;
+    int top_stage = -1;
+    for (int st = 0; st < GetRXAStageCount(); st++) {
+      long calls;
+      double avg_us, max_us;
+      if (!GetRXAStageProfile(receiver[rx]->id, st, &calls, &avg_us, &max_us)) {
+        continue;
+      }
+      total += avg_us;
+      if (avg_us > top) {
+        top = avg_us;
+        top_stage = st;
+      }
+    }
+    g_snprintf(name, sizeof(name), "RX%d DSP", rx + 1);
+    if (top_stage >= 0) {
+      g_snprintf(value, sizeof(value), "%.0f us   %s %.0f us", total, GetRXAStageName(top_stage), top);
+    } else {
+      g_snprintf(value, sizeof(value), "idle");
+    }
+    row_update(n++, name, value, total, total / 1000.0, top_stage >= 0);
+  }
   if (radio_is_transmitting()) {
     have_rx_buffered_latency = 0;
   }
@@ -320,11 +400,20 @@ static gboolean buffer_monitor_update_cb(gpointer data) {
   return G_SOURCE_CONTINUE;
 }
 
+static void buffer_monitor_set_profile(int run) {
+  for (int rx = 0; rx < receivers; rx++) {
+    if (receiver[rx] != NULL) {
+      SetRXAStageProfile(receiver[rx]->id, run);
+    }
+  }
+}
+
 static void buffer_monitor_destroy_cb(GtkWidget *widget, gpointer data) {
   if (buffer_monitor_timer_id != 0) {
     g_source_remove(buffer_monitor_timer_id);
     buffer_monitor_timer_id = 0;
   }
+  buffer_monitor_set_profile(0);
   buffer_monitor_window = NULL;
   buffer_monitor_area = NULL;
   memset(rows, 0, sizeof(rows));
@@ -417,6 +506,7 @@ static void buffer_monitor_create(void) {
     buffer_monitor_position();
     gtk_window_present(GTK_WINDOW(top_window));
   }
+  buffer_monitor_set_profile(1);
   buffer_monitor_collect();
   buffer_monitor_timer_id =
           g_timeout_add(BUFFER_MONITOR_REFRESH, buffer_monitor_update_cb, NULL);
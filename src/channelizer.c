@@ -0,0 +1,330 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Shared wideband channelizer (fast-convolution filter bank).
+ *
+ * One complex input stream is transformed with a single N-point FFT per
+ * hop of N/2 samples (overlap-save with 50 % overlap). Each attached output
+ * channel picks the M = N / decimation bins around its center frequency,
+ * multiplies them with the spectrum of a low-pass FIR (N/2 taps) and
+ * transforms them back with an M-point inverse FFT, the second half of
+ * which are M/2 new output samples at the decimated rate.
+ *
+ * So the forward FFT is shared, and each channel costs one short IFFT plus
+ * M complex multiplies per hop, independent of the input sample rate.
+ *
+ * The channel center is snapped to an even FFT bin (this keeps the bin
+ * shift phase-continuous from hop to hop), the remainder is removed by an
+ * NCO at the output rate. The FIR mask is centered at the exact channel
+ * frequency, so the passband does not move with the snapping.
+ */
+
+#include <glib.h>
+#include <math.h>
+#include <string.h>
+#include <fftw3.h>
+
+#include "channelizer.h"
+#include "message.h"
+
+typedef struct {
+  int used;
+  int valid;                  // channel lies within the input band
+  int in_rate;
+  int out_rate;
+  int m;                      // IFFT size (N / decimation)
+  int bin;                    // center bin (even)
+  double offset;
+  double nco_step;            // residual offset (rad per output sample)
+  double nco_phase;
+  double *taps;               // low-pass FIR prototype, N/2 taps
+  fftw_complex *mask;         // N-point FFT of the shifted FIR
+  fftw_complex *spare;        // next mask, computed outside the lock
+  fftw_complex *sub;          // selected bins, in-place IFFT
+  fftw_plan inv;
+  double *out;                // output samples of the last hop (I/Q interleaved)
+  CHANNELIZER_SINK sink;
+  void *arg;
+} CHANNEL;
+
+struct _channelizer {
+  GMutex mutex;
+  int size;                   // FFT size N, power of two
+  int fill;                   // samples in the current hop
+  fftw_complex *in;           // previous hop + current hop
+  fftw_complex *spec;
+  fftw_plan fwd;
+  fftw_complex *mask_in;      // scratch for the mask FFT (configuring thread only)
+  fftw_plan mask_plan;
+  CHANNEL ch[CHANNELIZER_MAX_CHANNELS];
+};
+
+CHANNELIZER *channelizer_create(int size) {
+  CHANNELIZER *c;
+  if (size < 16 || (size & (size - 1)) != 0) {
+    t_print("%s: invalid FFT size %d\n", __func__, size);
+    return NULL;
+  }
+  c = g_new0(CHANNELIZER, 1);
+  g_mutex_init(&c->mutex);
+  c->size = size;
+  c->in = fftw_malloc(size * sizeof(fftw_complex));
+  c->spec = fftw_malloc(size * sizeof(fftw_complex));
+  c->mask_in = fftw_malloc(size * sizeof(fftw_complex));
+  memset(c->in, 0, size * sizeof(fftw_complex));
+  c->fwd = fftw_plan_dft_1d(size, c->in, c->spec, FFTW_FORWARD, FFTW_ESTIMATE);
+  //
+  // The mask plan is executed with fftw_execute_dft() into the channel's
+  // mask, so its output array only serves for planning.
+  //
+  c->mask_plan = fftw_plan_dft_1d(size, c->mask_in, c->spec, FFTW_FORWARD, FFTW_ESTIMATE);
+  return c;
+}
+
+static void channelizer_free_channel(CHANNEL *ch) {
+  if (ch->inv != NULL) {
+    fftw_destroy_plan(ch->inv);
+    ch->inv = NULL;
+  }
+  fftw_free(ch->mask);
+  fftw_free(ch->spare);
+  fftw_free(ch->sub);
+  g_free(ch->taps);
+  g_free(ch->out);
+  memset(ch, 0, sizeof(CHANNEL));
+}
+
+void channelizer_destroy(CHANNELIZER *c) {
+  if (c == NULL) {
+    return;
+  }
+  for (int k = 0; k < CHANNELIZER_MAX_CHANNELS; k++) {
+    channelizer_free_channel(&c->ch[k]);
+  }
+  fftw_destroy_plan(c->fwd);
+  fftw_destroy_plan(c->mask_plan);
+  fftw_free(c->in);
+  fftw_free(c->spec);
+  fftw_free(c->mask_in);
+  g_mutex_clear(&c->mutex);
+  g_free(c);
+}
+
+int channelizer_attach(CHANNELIZER *c, CHANNELIZER_SINK sink, void *arg) {
+  int ret = -1;
+  if (c == NULL || sink == NULL) {
+    return -1;
+  }
+  g_mutex_lock(&c->mutex);
+  for (int k = 0; k < CHANNELIZER_MAX_CHANNELS; k++) {
+    CHANNEL *ch = &c->ch[k];
+    if (ch->used) { continue; }
+    //
+    // All buffers are allocated for the largest possible IFFT (no decimation)
+    // and never re-allocated, such that channelizer_add() can hand out the
+    // output buffer without holding the lock.
+    //
+    ch->mask = fftw_malloc(c->size * sizeof(fftw_complex));
+    ch->spare = fftw_malloc(c->size * sizeof(fftw_complex));
+    ch->sub = fftw_malloc(c->size * sizeof(fftw_complex));
+    ch->taps = g_new0(double, c->size / 2);
+    ch->out = g_new0(double, c->size);
+    ch->sink = sink;
+    ch->arg = arg;
+    ch->used = 1;
+    ret = k;
+    break;
+  }
+  g_mutex_unlock(&c->mutex);
+  return ret;
+}
+
+void channelizer_detach(CHANNELIZER *c, int k) {
+  if (c == NULL || k < 0 || k >= CHANNELIZER_MAX_CHANNELS) {
+    return;
+  }
+  g_mutex_lock(&c->mutex);
+  channelizer_free_channel(&c->ch[k]);
+  g_mutex_unlock(&c->mutex);
+}
+
+//
+// Blackman-Harris windowed sinc, -6 dB at 45 % of the output rate,
+// unity gain at DC.
+//
+static void channelizer_design(CHANNEL *ch, int ntaps) {
+  double fc = 0.45 * (double) ch->out_rate / (double) ch->in_rate;
+  double sum = 0.0;
+  for (int n = 0; n < ntaps; n++) {
+    double x = (double) n - 0.5 * (double)(ntaps - 1);
+    double w = 2.0 * M_PI * (double) n / (double)(ntaps - 1);
+    double win = 0.35875 - 0.48829 * cos(w) + 0.14128 * cos(2.0 * w) - 0.01168 * cos(3.0 * w);
+    double s = (x == 0.0) ? 2.0 * fc : sin(2.0 * M_PI * fc * x) / (M_PI * x);
+    ch->taps[n] = s * win;
+    sum += ch->taps[n];
+  }
+  for (int n = 0; n < ntaps; n++) {
+    ch->taps[n] /= sum;
+  }
+}
+
+//
+// Called from one (the GTK) thread only. The new mask is computed without
+// holding the lock, which channelizer_add() takes on the receive thread for
+// every hop, and then swapped in.
+//
+int channelizer_configure(CHANNELIZER *c, int k, int in_rate, int out_rate, double offset) {
+  int n = c != NULL ? c->size : 0;
+  int h = n / 2;
+  int decim;
+  int valid;
+  int bin;
+  double bin_hz;
+  double residual;
+  fftw_complex *mask;
+  if (c == NULL || k < 0 || k >= CHANNELIZER_MAX_CHANNELS || in_rate <= 0 || out_rate <= 0) {
+    return -1;
+  }
+  decim = in_rate / out_rate;
+  if (in_rate % out_rate != 0 || (decim & (decim - 1)) != 0 || decim > n / 4) {
+    t_print("%s: cannot derive %d Hz from %d Hz\n", __func__, out_rate, in_rate);
+    return -1;
+  }
+  g_mutex_lock(&c->mutex);
+  CHANNEL *ch = &c->ch[k];
+  if (!ch->used) {
+    g_mutex_unlock(&c->mutex);
+    return -1;
+  }
+  if (ch->in_rate != in_rate || ch->out_rate != out_rate) {
+    ch->in_rate = in_rate;
+    ch->out_rate = out_rate;
+    ch->m = n / decim;
+    if (ch->inv != NULL) {
+      fftw_destroy_plan(ch->inv);
+    }
+    ch->inv = fftw_plan_dft_1d(ch->m, ch->sub, ch->sub, FFTW_BACKWARD, FFTW_ESTIMATE);
+    channelizer_design(ch, h);
+    ch->offset = NAN;
+    ch->valid = 0;            // no output until the new mask is in place
+  }
+  if (ch->offset == offset) {
+    valid = ch->valid;
+    g_mutex_unlock(&c->mutex);
+    return valid ? 0 : -1;
+  }
+  mask = ch->spare;
+  g_mutex_unlock(&c->mutex);
+  valid = fabs(offset) + 0.5 * (double) out_rate <= 0.5 * (double) in_rate;
+  bin_hz = (double) in_rate / (double) n;
+  bin = 2 * (int) lround(offset / (2.0 * bin_hz));
+  residual = offset - (double) bin * bin_hz;
+  //
+  // Shift the prototype by the residual offset, such that the passband
+  // is centered at the exact channel frequency, and transform it.
+  //
+  for (int i = 0; i < n; i++) {
+    if (i < h) {
+      double phi = 2.0 * M_PI * residual * (double) i / (double) in_rate;
+      c->mask_in[i][0] = ch->taps[i] * cos(phi);
+      c->mask_in[i][1] = ch->taps[i] * sin(phi);
+    } else {
+      c->mask_in[i][0] = 0.0;
+      c->mask_in[i][1] = 0.0;
+    }
+  }
+  fftw_execute_dft(c->mask_plan, c->mask_in, mask);
+  g_mutex_lock(&c->mutex);
+  ch->spare = ch->mask;
+  ch->mask = mask;
+  ch->offset = offset;
+  ch->valid = valid;
+  ch->bin = bin;
+  ch->nco_step = -2.0 * M_PI * residual / (double) out_rate;
+  ch->nco_phase = 0.0;
+  g_mutex_unlock(&c->mutex);
+  return valid ? 0 : -1;
+}
+
+static int channelizer_run_channel(CHANNELIZER *c, CHANNEL *ch) {
+  int n = c->size;
+  int m = ch->m;
+  double scale = 1.0 / (double) n;
+  if (ch->inv == NULL) {
+    return 0;
+  }
+  if (!ch->valid) {
+    memset(ch->out, 0, m * sizeof(double));
+    return m / 2;
+  }
+  for (int j = 0; j < m; j++) {
+    int f = (j < m / 2) ? j : j - m;
+    int s = (ch->bin + f) & (n - 1);
+    int w = f & (n - 1);
+    double xr = c->spec[s][0];
+    double xi = c->spec[s][1];
+    ch->sub[j][0] = xr * ch->mask[w][0] - xi * ch->mask[w][1];
+    ch->sub[j][1] = xr * ch->mask[w][1] + xi * ch->mask[w][0];
+  }
+  fftw_execute(ch->inv);
+  for (int j = 0; j < m / 2; j++) {
+    double yr = scale * ch->sub[m / 2 + j][0];
+    double yi = scale * ch->sub[m / 2 + j][1];
+    double cs = cos(ch->nco_phase);
+    double sn = sin(ch->nco_phase);
+    ch->out[2 * j] = yr * cs - yi * sn;
+    ch->out[2 * j + 1] = yr * sn + yi * cs;
+    ch->nco_phase += ch->nco_step;
+  }
+  ch->nco_phase = fmod(ch->nco_phase, 2.0 * M_PI);
+  return m / 2;
+}
+
+//
+// Called for each wideband sample (from the receive thread). Output samples
+// are handed to the channel sinks once per hop, outside the lock.
+//
+void channelizer_add(CHANNELIZER *c, double i_sample, double q_sample) {
+  int h = c->size / 2;
+  int count[CHANNELIZER_MAX_CHANNELS];
+  CHANNELIZER_SINK sink[CHANNELIZER_MAX_CHANNELS];
+  void *arg[CHANNELIZER_MAX_CHANNELS];
+  c->in[h + c->fill][0] = i_sample;
+  c->in[h + c->fill][1] = q_sample;
+  if (++c->fill < h) {
+    return;
+  }
+  c->fill = 0;
+  g_mutex_lock(&c->mutex);
+  fftw_execute(c->fwd);
+  memmove(c->in, c->in + h, h * sizeof(fftw_complex));
+  for (int k = 0; k < CHANNELIZER_MAX_CHANNELS; k++) {
+    CHANNEL *ch = &c->ch[k];
+    count[k] = ch->used ? channelizer_run_channel(c, ch) : 0;
+    sink[k] = ch->sink;
+    arg[k] = ch->arg;
+  }
+  g_mutex_unlock(&c->mutex);
+  for (int k = 0; k < CHANNELIZER_MAX_CHANNELS; k++) {
+    const double *out = c->ch[k].out;
+    for (int j = 0; j < count[k]; j++) {
+      sink[k](arg[k], out[2 * j], out[2 * j + 1]);
+    }
+  }
+}
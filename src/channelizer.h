@@ -0,0 +1,38 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef _CHANNELIZER_H
+#define _CHANNELIZER_H
+
+//
+// Max. number of narrow output channels derived from one wideband stream
+//
+#define CHANNELIZER_MAX_CHANNELS 4
+
+typedef void (*CHANNELIZER_SINK)(void *arg, double i_sample, double q_sample);
+
+typedef struct _channelizer CHANNELIZER;
+
+extern CHANNELIZER *channelizer_create(int size);
+extern void channelizer_destroy(CHANNELIZER *c);
+extern int  channelizer_attach(CHANNELIZER *c, CHANNELIZER_SINK sink, void *arg);
+extern void channelizer_detach(CHANNELIZER *c, int ch);
+extern int  channelizer_configure(CHANNELIZER *c, int ch, int in_rate, int out_rate, double offset);
+extern void channelizer_add(CHANNELIZER *c, double i_sample, double q_sample);
+
+#endif
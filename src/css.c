@@ -29,6 +29,7 @@
 #include "main.h"
 #include "toolset.h"
 #include "property.h"
+#include "thread_role.h"
 
 const char *css_filename = "deskhpsdr.css";
 
@@ -1348,6 +1349,7 @@ void StartConfigSave(void) {
     snprintf(name, sizeof(name), "p2_ddc%d_adc", i);
     SetPropI0(name, p2_ddc_adc_map[i]);
   }
+  thread_role_save_state();
   saveProperties(filename);
 }
 
@@ -1371,6 +1373,7 @@ void StartConfigLoad(void) {
     GetPropI0(name, p2_ddc_adc_map[i]);
     p2_ddc_adc_map[i] = p2_ddc_adc_map[i] ? 1 : 0;
   }
+  thread_role_restore_state();
   if (iaru_region < 1 || iaru_region > 3) {
     iaru_region = 2;
   }
@@ -38,6 +38,7 @@
 #include "discovered.h"
 #include "old_discovery.h"
 #include "new_discovery.h"
+#include "net_discovery.h"
 #include "main.h"
 #include "radio.h"
 #ifdef USBOZY
@@ -73,6 +74,12 @@ int active_device_index;
 
 int discover_only_stemlab = 0;
 
+//
+// The fast reconnect to the last radio is only tried for the first
+// discovery after program start, such that "Discover" always shows the list
+//
+static int fast_reconnect_armed = 1;
+
 int delayed_discovery(gpointer data);
 
 int discovery_resolve_target(const char *host,
@@ -195,6 +202,7 @@ static gboolean start_cb(GtkWidget *widget, GdkEventButton *event, gpointer data
   radio = &discovered[selected_device];
   t_print("%s: selected_device=%d protocol=%d device=%d name=%s\n",
           __func__, selected_device, radio->protocol, radio->device, radio->name);
+  net_discovery_remember(radio);
   if (!(radio->protocol == NEW_PROTOCOL && radio->device == NEW_DEVICE_ANGELIA)) {
     p2_angelia_ddc0_map = 0;
   }
@@ -258,7 +266,9 @@ static gboolean start_cb(GtkWidget *widget, GdkEventButton *event, gpointer data
   //
   status_text("Starting Radio ...\n");
   g_timeout_add(100, ext_start_radio, NULL);
-  gtk_widget_destroy(discovery_dialog);
+  if (discovery_dialog != NULL) {
+    gtk_widget_destroy(discovery_dialog);
+  }
   return TRUE;
 }
 
@@ -423,6 +433,17 @@ void discovery(void) {
     }
     fclose(fp);
   }
+  if (fast_reconnect && fast_reconnect_armed && !discover_only_stemlab) {
+    fast_reconnect_armed = 0;
+    status_text("Looking for last used radio ...");
+    if (net_discovery_last_radio(enable_protocol_1, enable_protocol_2)
+        && discovered[devices - 1].status == STATE_AVAILABLE) {
+      discovery_dialog = NULL;
+      start_cb(NULL, NULL, GINT_TO_POINTER(devices - 1));
+      return;
+    }
+    devices = 0;
+  }
 #ifdef USBOZY
   if (enable_usbozy && !discover_only_stemlab) {
     //
@@ -467,17 +488,12 @@ void discovery(void) {
     stemlab_discovery();
   }
 #endif
-  if (enable_protocol_1 || discover_only_stemlab) {
-    if (discover_only_stemlab) {
-      status_text("Stemlab ... Looking for SDR apps");
-    } else {
-      status_text("Protocol 1 ... Discovering Devices (Wait for up to 5 seconds)");
-    }
+  if (discover_only_stemlab) {
+    status_text("Stemlab ... Looking for SDR apps");
     old_discovery();
-  }
-  if (enable_protocol_2 && !discover_only_stemlab) {
-    status_text("Protocol 2 ... Discovering Devices (Wait for up to 5 seconds)");
-    new_discovery();
+  } else if (enable_protocol_1 || enable_protocol_2) {
+    status_text("Discovering Devices (Wait for up to 5 seconds)");
+    net_discovery(enable_protocol_1, enable_protocol_2);
   }
   status_text("Discovery completed.");
   // subsequent discoveries check all protocols enabled.
@@ -36,6 +36,7 @@
 #include "ext.h"
 #include "message.h"
 #include "main.h"
+#include "notify_bus.h"
 
 #include <math.h>
 
@@ -218,15 +219,17 @@ void set_diversity(int state) {
     rx_change_sample_rate(receiver[1], receiver[0]->sample_rate);
   }
   //
-  // If we have only one receiver, then changing diversity
-  // changes the number of HPSR receivers so we restart the
-  // original protocol
+  // If we have only one receiver, or RX2 is derived from RX1 by the
+  // channelizer, then changing diversity changes the number of HPSR
+  // receivers so we restart the original protocol
   //
-  int restart_old_protocol = protocol == ORIGINAL_PROTOCOL && receivers == 1 && diversity_enabled != state;
+  int restart_old_protocol = protocol == ORIGINAL_PROTOCOL && (receivers == 1 || rx_channelizer)
+                             && diversity_enabled != state;
   if (restart_old_protocol) {
     old_protocol_stop();
   }
   diversity_enabled = state;
+  notify_post(NOTIFY_DIVERSITY);
   if (receivers > 1 && receiver[1] != NULL) {
     rx_vfo_changed(receiver[1]);
   }
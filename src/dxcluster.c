@@ -31,12 +31,22 @@
 #include <sys/socket.h>
 #include <netdb.h>
 #include <fcntl.h>
+#include <poll.h>
 
 #include <libtelnet.h>
 #include "dxcluster.h"
 #include "radio.h"
 #include "rx_panadapter.h"
+#include "spotfeed.h"
 
+#define DXCLUSTER_POLL_MS 200
+
+/*
+ * Socket-I/O, Telnet-Dekodierung und Zeilenparser laufen in einem eigenen
+ * Thread. DX-Spots gehen gebündelt über spotfeed_push() an den Panadapter,
+ * der empfangene Text wird gesammelt und höchstens alle SPOTFEED_FLUSH_MS
+ * im GTK-Thread an das Textfenster angehängt.
+ */
 typedef struct {
   GtkWidget      *window;
   GtkWidget      *text_view;
@@ -44,12 +54,16 @@ typedef struct {
   GtkWidget      *entry;
   telnet_t       *telnet;
   int             sockfd;
-  GIOChannel     *gio;
   GtkTextTag     *tag_dx;
   GtkTextTag     *tag_self;
   char           *callsign;
-  guint           io_watch_id;   /* GSource-ID von g_io_add_watch */
   GString        *linebuf;       /* Puffer für unvollständige Telnet-Zeilen */
+  GThread        *thread;        /* Empfangs-Thread */
+  volatile int    running;
+  GMutex          telnet_mutex;  /* schützt telnet (Thread und Eingabezeile) */
+  GMutex          text_mutex;    /* schützt pending_text, flush_id */
+  GString        *pending_text;  /* noch nicht angezeigter Text */
+  guint           flush_id;      /* GSource-ID des Text-Flush-Timers */
 } DxClusterCtx;
 
 /* Singleton-Kontext */
@@ -123,8 +137,8 @@ static void dxcluster_process_line(DxClusterCtx *ctx, const char *line) {
   if (i == 0) {
     return;
   }
-  /* DX-Spot als Label in den Panadapter pushen */
-  pan_add_dx_spot(freq_khz, dxcall);
+  /* DX-Spot gebündelt an den Panadapter übergeben */
+  spotfeed_push(freq_khz, dxcall, PAN_SPOT_SOURCE_CLUSTER);
 }
 
 /* Telnet-Datenstrom in Zeilen zerlegen und je Zeile dxcluster_process_line() rufen */
@@ -210,6 +224,34 @@ dxcluster_append_text(DxClusterCtx *ctx, const char *data, size_t len) {
   gtk_text_buffer_delete_mark(ctx->text_buffer, mark);
 }
 
+/* Läuft im GTK-Thread: gesammelten Text ins Fenster übernehmen */
+static gboolean
+dxcluster_flush_cb(gpointer data) {
+  DxClusterCtx *ctx = (DxClusterCtx *) data;
+  GString *text;
+  g_mutex_lock(&ctx->text_mutex);
+  ctx->flush_id = 0;
+  text = ctx->pending_text;
+  ctx->pending_text = g_string_new(NULL);
+  g_mutex_unlock(&ctx->text_mutex);
+  if (text->len > 0) {
+    dxcluster_append_text(ctx, text->str, text->len);
+  }
+  g_string_free(text, TRUE);
+  return G_SOURCE_REMOVE;
+}
+
+/* Text aus dem Empfangs-Thread für die Anzeige vormerken */
+static void
+dxcluster_queue_text(DxClusterCtx *ctx, const char *data, size_t len) {
+  g_mutex_lock(&ctx->text_mutex);
+  g_string_append_len(ctx->pending_text, data, (gssize) len);
+  if (ctx->flush_id == 0) {
+    ctx->flush_id = g_timeout_add(SPOTFEED_FLUSH_MS, dxcluster_flush_cb, ctx);
+  }
+  g_mutex_unlock(&ctx->text_mutex);
+}
+
 /* -------------------------------------------------------------------------- */
 
 static void
@@ -217,11 +259,6 @@ dxcluster_disconnect(DxClusterCtx *ctx) {
   if (!ctx) {
     return;
   }
-  if (ctx->gio) {
-    g_io_channel_shutdown(ctx->gio, FALSE, NULL);
-    g_io_channel_unref(ctx->gio);
-    ctx->gio = NULL;
-  }
   if (ctx->sockfd >= 0) {
     close(ctx->sockfd);
     ctx->sockfd = -1;
@@ -240,11 +277,10 @@ dxcluster_telnet_event_handler(telnet_t *telnet, telnet_event_t *ev, void *user_
   (void) telnet;
   switch (ev->type) {
   case TELNET_EV_DATA:
-    // dxcluster_append_text(ctx, ev->data.buffer, ev->data.size);
     /* Rohdaten an den Zeilenparser für DX-Spots übergeben */
     dxcluster_feed_parser(ctx, ev->data.buffer, ev->data.size);
     /* Und unverändert im Fenster anzeigen */
-    dxcluster_append_text(ctx, ev->data.buffer, ev->data.size);
+    dxcluster_queue_text(ctx, ev->data.buffer, ev->data.size);
     break;
   case TELNET_EV_SEND: {
     ssize_t rs = send(ctx->sockfd, ev->data.buffer, ev->data.size, 0);
@@ -266,44 +302,57 @@ dxcluster_telnet_event_handler(telnet_t *telnet, telnet_event_t *ev, void *user_
 
 /* -------------------------------------------------------------------------- */
 
-static gboolean
-dxcluster_socket_cb(GIOChannel *source, GIOCondition cond, gpointer data) {
+static gpointer
+dxcluster_thread(gpointer data) {
   DxClusterCtx *ctx = (DxClusterCtx *) data;
-  int fd = g_io_channel_unix_get_fd(source);
-  if (cond & (G_IO_HUP | G_IO_ERR | G_IO_NVAL)) {
-    dxcluster_append_text(ctx, "\n[Verbindung geschlossen]\n",
-                          strlen("\n[Verbindung geschlossen]\n"));
-    dxcluster_disconnect(ctx);
-    ctx->io_watch_id = 0;
-    return FALSE;   /* Watch entfernen */
-  }
-  if ((cond & G_IO_IN) && ctx->telnet) {
-    char buf[2048];
-    for (;;) {
-      ssize_t len = recv(fd, buf, sizeof(buf), 0);
-      if (len > 0) {
-        if (ctx->telnet) {
-          telnet_recv(ctx->telnet, buf, len);
-        }
-      } else if (len == 0) {
-        dxcluster_append_text(ctx,
-                              "\n[Server hat die Verbindung beendet]\n",
-                              strlen("\n[Server hat die Verbindung beendet]\n"));
-        dxcluster_disconnect(ctx);
-        ctx->io_watch_id = 0;
-        return FALSE;
-      } else {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-          break;
-        }
-        g_warning("recv() failed: %s", g_strerror(errno));
-        dxcluster_disconnect(ctx);
-        ctx->io_watch_id = 0;
-        return FALSE;
+  char buf[2048];
+  const char *msg = NULL;
+  while (ctx->running) {
+    struct pollfd pfd;
+    pfd.fd = ctx->sockfd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    int rc = poll(&pfd, 1, DXCLUSTER_POLL_MS);
+    if (rc == 0 || (rc < 0 && errno == EINTR)) {
+      continue;
+    }
+    if (rc < 0 || (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) {
+      msg = "\n[Verbindung geschlossen]\n";
+      break;
+    }
+    ssize_t len = recv(ctx->sockfd, buf, sizeof(buf), 0);
+    if (len > 0) {
+      g_mutex_lock(&ctx->telnet_mutex);
+      if (ctx->telnet) {
+        telnet_recv(ctx->telnet, buf, len);
       }
+      g_mutex_unlock(&ctx->telnet_mutex);
+    } else if (len == 0) {
+      msg = "\n[Server hat die Verbindung beendet]\n";
+      break;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      g_warning("recv() failed: %s", g_strerror(errno));
+      msg = "\n[Verbindung geschlossen]\n";
+      break;
     }
   }
-  return TRUE;
+  if (msg != NULL) {
+    dxcluster_queue_text(ctx, msg, strlen(msg));
+  }
+  return NULL;
+}
+
+/* Empfangs-Thread beenden, Socket und Telnet schließen */
+static void
+dxcluster_stop(DxClusterCtx *ctx) {
+  ctx->running = 0;
+  if (ctx->thread) {
+    g_thread_join(ctx->thread);
+    ctx->thread = NULL;
+  }
+  g_mutex_lock(&ctx->telnet_mutex);
+  dxcluster_disconnect(ctx);
+  g_mutex_unlock(&ctx->telnet_mutex);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -354,11 +403,13 @@ static void
 dxcluster_on_entry_activate(GtkEntry *entry, gpointer user_data) {
   DxClusterCtx *ctx = (DxClusterCtx *) user_data;
   const gchar *text = gtk_entry_get_text(entry);
+  g_mutex_lock(&ctx->telnet_mutex);
   if (ctx->telnet && ctx->sockfd >= 0 && text && *text) {
     gchar *line = g_strdup_printf("%s\r\n", text);
     telnet_send(ctx->telnet, line, strlen(line));
     g_free(line);
   }
+  g_mutex_unlock(&ctx->telnet_mutex);
   gtk_entry_set_text(entry, "");
 }
 
@@ -367,11 +418,14 @@ dxcluster_on_window_destroy(GtkWidget *widget, gpointer user_data) {
   dxcwin_open = 0;
   DxClusterCtx *ctx = (DxClusterCtx *) user_data;
   (void) widget;
-  if (ctx->io_watch_id != 0) {
-    g_source_remove(ctx->io_watch_id);
-    ctx->io_watch_id = 0;
-  }
-  dxcluster_disconnect(ctx);
+  dxcluster_stop(ctx);
+  if (ctx->flush_id != 0) {
+    g_source_remove(ctx->flush_id);
+    ctx->flush_id = 0;
+  }
+  g_string_free(ctx->pending_text, TRUE);
+  g_mutex_clear(&ctx->telnet_mutex);
+  g_mutex_clear(&ctx->text_mutex);
   if (ctx->callsign) {
     g_free(ctx->callsign);
   }
@@ -440,6 +494,9 @@ dxcluster_open_window(const char *host,
   ctx->text_buffer = gtk_text_view_get_buffer(GTK_TEXT_VIEW(textview));
   ctx->linebuf     = g_string_new(NULL);
   ctx->entry       = entry;
+  ctx->pending_text = g_string_new(NULL);
+  g_mutex_init(&ctx->telnet_mutex);
+  g_mutex_init(&ctx->text_mutex);
 #ifdef __linux__
   /* Styleklassen, CSS kommt aus deskHPSDR */
   gtk_style_context_add_class(
@@ -514,15 +571,9 @@ dxcluster_open_window(const char *host,
     telnet_send(ctx->telnet, login, strlen(login));
     g_free(login);
   }
-  /* GIO-Watch */
-  ctx->gio = g_io_channel_unix_new(ctx->sockfd);
-  g_io_channel_set_encoding(ctx->gio, NULL, NULL);
-  g_io_channel_set_buffered(ctx->gio, FALSE);
-  ctx->io_watch_id = g_io_add_watch(
-                             ctx->gio,
-                             (GIOCondition)(G_IO_IN | G_IO_HUP | G_IO_ERR | G_IO_NVAL),
-                             dxcluster_socket_cb,
-                             ctx);
+  /* Empfangs-Thread */
+  ctx->running = 1;
+  ctx->thread = g_thread_new("DX-Cluster", dxcluster_thread, ctx);
   dxcluster_append_text(ctx,
                         "[Verbunden zum DX-Cluster]\n",
                         strlen("[Verbunden zum DX-Cluster]\n"));
@@ -0,0 +1,376 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Store for DX spots and custom panadapter labels.
+ *
+ * Spots arrive from the DX cluster, the RBN and TCI clients, possibly at a
+ * high rate during contests. Each spot is indexed three ways:
+ *
+ * - by frequency (GSequence, a balanced tree), so the panadapter can fetch
+ *   the spots of the visible range in O(log n) and already sorted left-to-right
+ * - by callsign (hash table), so the duplicate check does not scan all spots
+ * - by expiry time (binary min-heap), so timed-out spots are found in O(1)
+ *
+ * Additionally, all spots are kept in insertion order, and if the store is
+ * full the oldest spot is dropped.
+ *
+ * The store is protected by a mutex since TCI spots are added from the
+ * TCI server thread while the panadapter is drawn from the GTK thread.
+ */
+
+#include <glib.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dxspot.h"
+
+#define DXSPOT_DUPE_WINDOW_HZ 500LL
+#define DXSPOT_RBN_REFRESH_GUARD_US (30LL * 1000000LL)
+
+typedef struct _dxspot DXSPOT;
+
+struct _dxspot {
+  long long freq;             // absolute RF frequency in Hz
+  guint64 seq;                // insertion sequence number, tie-breaker in frequency index
+  char label[32];
+  char key[32];               // upper-case label, key into the call index
+  gint64 expire_time;         // 0 = never expires, else monotonic time (us)
+  gint64 last_update_time;    // monotonic time (us), used for RBN refresh throttling
+  PAN_SPOT_SOURCE source;
+  GSequenceIter *freq_iter;   // position in frequency index
+  GList age_link;             // position in insertion-order queue
+  int heap_pos;               // position in expiry heap, -1 if not in heap
+};
+
+static GMutex dxspot_mutex;
+static GSequence *by_freq = NULL;
+static GHashTable *by_call = NULL;
+static GQueue by_age = G_QUEUE_INIT;
+static DXSPOT *heap[DXSPOT_MAX_SPOTS];
+static int heap_len = 0;
+static guint64 dxspot_seq = 0;
+
+static int dxspot_source_priority(PAN_SPOT_SOURCE source) {
+  switch (source) {
+  case PAN_SPOT_SOURCE_TCI:
+    return 3;
+  case PAN_SPOT_SOURCE_CLUSTER:
+    return 2;
+  case PAN_SPOT_SOURCE_RBN:
+    return 1;
+  case PAN_SPOT_SOURCE_CUSTOM:
+  default:
+    return 0;
+  }
+}
+
+static gint dxspot_freq_cmp(gconstpointer a, gconstpointer b, gpointer data) {
+  const DXSPOT *sa = (const DXSPOT *) a;
+  const DXSPOT *sb = (const DXSPOT *) b;
+  if (sa->freq < sb->freq) { return -1; }
+  if (sa->freq > sb->freq) { return 1; }
+  if (sa->seq < sb->seq) { return -1; }
+  if (sa->seq > sb->seq) { return 1; }
+  return 0;
+}
+
+static void dxspot_make_key(char *key, size_t size, const char *label) {
+  g_strlcpy(key, label, size);
+  for (char *p = key; *p; p++) {
+    *p = g_ascii_toupper(*p);
+  }
+}
+
+static void dxspot_init_locked(void) {
+  if (by_freq == NULL) {
+    by_freq = g_sequence_new(NULL);
+    by_call = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_ptr_array_unref);
+  }
+}
+
+//
+// Expiry heap (min-heap on expire_time). Each spot knows its heap position
+// so it can be removed or re-keyed in O(log n).
+//
+static void heap_set(int pos, DXSPOT *s) {
+  heap[pos] = s;
+  s->heap_pos = pos;
+}
+
+static void heap_up(int pos) {
+  DXSPOT *s = heap[pos];
+  while (pos > 0) {
+    int parent = (pos - 1) / 2;
+    if (heap[parent]->expire_time <= s->expire_time) { break; }
+    heap_set(pos, heap[parent]);
+    pos = parent;
+  }
+  heap_set(pos, s);
+}
+
+static void heap_down(int pos) {
+  DXSPOT *s = heap[pos];
+  for (;;) {
+    int child = 2 * pos + 1;
+    if (child >= heap_len) { break; }
+    if (child + 1 < heap_len && heap[child + 1]->expire_time < heap[child]->expire_time) {
+      child++;
+    }
+    if (s->expire_time <= heap[child]->expire_time) { break; }
+    heap_set(pos, heap[child]);
+    pos = child;
+  }
+  heap_set(pos, s);
+}
+
+static void heap_remove(DXSPOT *s) {
+  int pos = s->heap_pos;
+  DXSPOT *last;
+  if (pos < 0) { return; }
+  s->heap_pos = -1;
+  heap_len--;
+  if (pos == heap_len) { return; }
+  // move the last element into the hole and restore heap order
+  last = heap[heap_len];
+  heap_set(pos, last);
+  heap_up(pos);
+  heap_down(last->heap_pos);
+}
+
+static void dxspot_set_lifetime(DXSPOT *s, int lifetime_ms, gint64 now) {
+  if (lifetime_ms <= 0) {
+    s->expire_time = 0;
+    heap_remove(s);
+    return;
+  }
+  s->expire_time = now + (gint64) lifetime_ms * 1000;
+  if (s->heap_pos < 0) {
+    s->heap_pos = heap_len;
+    heap[heap_len++] = s;
+    heap_up(s->heap_pos);
+  } else {
+    heap_up(s->heap_pos);
+    heap_down(s->heap_pos);
+  }
+}
+
+static void dxspot_remove_locked(DXSPOT *s) {
+  GPtrArray *list = g_hash_table_lookup(by_call, s->key);
+  if (list != NULL) {
+    g_ptr_array_remove_fast(list, s);
+    if (list->len == 0) {
+      g_hash_table_remove(by_call, s->key);
+    }
+  }
+  g_sequence_remove(s->freq_iter);
+  heap_remove(s);
+  g_queue_unlink(&by_age, &s->age_link);
+  g_free(s);
+}
+
+static void dxspot_new_locked(long long freq, const char *label, PAN_SPOT_SOURCE source, int lifetime_ms,
+                              gint64 now) {
+  DXSPOT *s;
+  GPtrArray *list;
+  if (by_age.length >= DXSPOT_MAX_SPOTS) {
+    // FIFO: drop the oldest spot
+    dxspot_remove_locked((DXSPOT *) by_age.head->data);
+  }
+  s = g_new0(DXSPOT, 1);
+  s->freq = freq;
+  s->seq = ++dxspot_seq;
+  s->source = source;
+  s->last_update_time = now;
+  s->heap_pos = -1;
+  g_strlcpy(s->label, label, sizeof(s->label));
+  dxspot_make_key(s->key, sizeof(s->key), s->label);
+  s->freq_iter = g_sequence_insert_sorted(by_freq, s, dxspot_freq_cmp, NULL);
+  s->age_link.data = s;
+  g_queue_push_tail_link(&by_age, &s->age_link);
+  list = g_hash_table_lookup(by_call, s->key);
+  if (list == NULL) {
+    list = g_ptr_array_sized_new(2);
+    g_hash_table_insert(by_call, g_strdup(s->key), list);
+  }
+  g_ptr_array_add(list, s);
+  dxspot_set_lifetime(s, lifetime_ms, now);
+}
+
+/* Check whether a DX spot with the same call already exists close to the
+ * requested frequency. RBN and cluster spots often differ by a few hundred Hz,
+ * so an exact frequency match is not sufficient. If a duplicate is found,
+ * refresh its timeout and move it to the latest reported frequency.
+ */
+static gboolean dxspot_update_if_exists_locked(long long freq, const char *key, int lifetime_ms,
+    PAN_SPOT_SOURCE source, gint64 now) {
+  const GPtrArray *list = g_hash_table_lookup(by_call, key);
+  int new_priority = dxspot_source_priority(source);
+  if (list == NULL) {
+    return FALSE;
+  }
+  for (guint i = 0; i < list->len; i++) {
+    DXSPOT *s = g_ptr_array_index(list, i);
+    int old_priority;
+    if (llabs(s->freq - freq) > DXSPOT_DUPE_WINDOW_HZ) {
+      continue;
+    }
+    old_priority = dxspot_source_priority(s->source);
+    /* RBN is a high-rate skimmer source.  Do not let repeated RBN decodes
+     * continuously refresh existing labels, otherwise the normal spot lifetime
+     * never gets a chance to expire them.  Also do not let lower-priority RBN
+     * duplicates keep manually added cluster/TCI spots alive.
+     */
+    if (source == PAN_SPOT_SOURCE_RBN) {
+      if (old_priority > new_priority) {
+        return TRUE;
+      }
+      if (s->source == PAN_SPOT_SOURCE_RBN &&
+          s->last_update_time != 0 &&
+          now - s->last_update_time < DXSPOT_RBN_REFRESH_GUARD_US) {
+        return TRUE;
+      }
+    }
+    if (s->freq != freq) {
+      s->freq = freq;
+      g_sequence_sort_changed(s->freq_iter, dxspot_freq_cmp, NULL);
+    }
+    if (new_priority > old_priority) {
+      s->source = source;
+    }
+    s->last_update_time = now;
+    dxspot_set_lifetime(s, lifetime_ms, now);
+    return TRUE;
+  }
+  return FALSE;
+}
+
+void dxspot_clear(void) {
+  g_mutex_lock(&dxspot_mutex);
+  if (by_freq != NULL) {
+    while (by_age.head != NULL) {
+      dxspot_remove_locked((DXSPOT *) by_age.head->data);
+    }
+  }
+  g_mutex_unlock(&dxspot_mutex);
+}
+
+//
+// Add a label without duplicate check (custom labels)
+//
+void dxspot_add(long long freq, const char *label, PAN_SPOT_SOURCE source, int lifetime_ms) {
+  if (label == NULL) {
+    return;
+  }
+  g_mutex_lock(&dxspot_mutex);
+  dxspot_init_locked();
+  dxspot_new_locked(freq, label, source, lifetime_ms, g_get_monotonic_time());
+  g_mutex_unlock(&dxspot_mutex);
+}
+
+//
+// Add a DX spot. If the same call has already been spotted close to this
+// frequency, the existing spot is refreshed instead.
+//
+void dxspot_add_dx(long long freq, const char *call, PAN_SPOT_SOURCE source, int lifetime_ms) {
+  char key[32];
+  gint64 now;
+  if (call == NULL || call[0] == '\0') {
+    return;
+  }
+  dxspot_make_key(key, sizeof(key), call);
+  now = g_get_monotonic_time();
+  g_mutex_lock(&dxspot_mutex);
+  dxspot_init_locked();
+  if (!dxspot_update_if_exists_locked(freq, key, lifetime_ms, source, now)) {
+    dxspot_new_locked(freq, call, source, lifetime_ms, now);
+  }
+  g_mutex_unlock(&dxspot_mutex);
+}
+
+void dxspot_delete_call(const char *call) {
+  char key[32];
+  GPtrArray *list;
+  if (call == NULL || call[0] == '\0') {
+    return;
+  }
+  dxspot_make_key(key, sizeof(key), call);
+  g_mutex_lock(&dxspot_mutex);
+  if (by_call != NULL) {
+    //
+    // dxspot_remove_locked() removes the hash entry together with
+    // the last spot, so look it up again after each removal
+    //
+    while ((list = g_hash_table_lookup(by_call, key)) != NULL) {
+      dxspot_remove_locked(g_ptr_array_index(list, 0));
+    }
+  }
+  g_mutex_unlock(&dxspot_mutex);
+}
+
+//
+// Remove all spots whose lifetime has ended
+//
+void dxspot_expire(gint64 now) {
+  g_mutex_lock(&dxspot_mutex);
+  while (heap_len > 0 && heap[0]->expire_time <= now) {
+    dxspot_remove_locked(heap[0]);
+  }
+  g_mutex_unlock(&dxspot_mutex);
+}
+
+int dxspot_count(void) {
+  int count;
+  g_mutex_lock(&dxspot_mutex);
+  count = (int) by_age.length;
+  g_mutex_unlock(&dxspot_mutex);
+  return count;
+}
+
+//
+// Copy (at most max) spots with fmin <= freq <= fmax into out,
+// sorted by ascending frequency. Returns the number of spots copied.
+//
+int dxspot_range(long long fmin, long long fmax, DXSPOT_VIEW *out, int max) {
+  DXSPOT probe;
+  GSequenceIter *it;
+  int n = 0;
+  g_mutex_lock(&dxspot_mutex);
+  if (by_freq == NULL || by_age.length == 0) {
+    g_mutex_unlock(&dxspot_mutex);
+    return 0;
+  }
+  //
+  // seq=0 is smaller than any stored spot, so the search points
+  // to the first spot with freq >= fmin
+  //
+  probe.freq = fmin;
+  probe.seq = 0;
+  it = g_sequence_search(by_freq, &probe, dxspot_freq_cmp, NULL);
+  while (n < max && !g_sequence_iter_is_end(it)) {
+    const DXSPOT *s = g_sequence_get(it);
+    if (s->freq > fmax) { break; }
+    out[n].freq = s->freq;
+    out[n].source = s->source;
+    g_strlcpy(out[n].label, s->label, sizeof(out[n].label));
+    n++;
+    it = g_sequence_iter_next(it);
+  }
+  g_mutex_unlock(&dxspot_mutex);
+  return n;
+}
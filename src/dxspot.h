@@ -0,0 +1,54 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef _DXSPOT_H
+#define _DXSPOT_H
+
+#include <glib.h>
+
+typedef enum {
+  PAN_SPOT_SOURCE_CUSTOM = 0,
+  PAN_SPOT_SOURCE_CLUSTER,
+  PAN_SPOT_SOURCE_TCI,
+  PAN_SPOT_SOURCE_RBN
+} PAN_SPOT_SOURCE;
+
+//
+// Max. number of spots/labels kept in the store. If the store is full,
+// the oldest entry (in insertion order) is dropped.
+//
+#define DXSPOT_MAX_SPOTS 4096
+
+//
+// Snapshot of one spot as handed out to the panadapter drawing code
+//
+typedef struct {
+  long long freq;           // absolute RF frequency in Hz
+  char label[32];
+  PAN_SPOT_SOURCE source;
+} DXSPOT_VIEW;
+
+extern void dxspot_clear(void);
+extern void dxspot_add(long long freq, const char *label, PAN_SPOT_SOURCE source, int lifetime_ms);
+extern void dxspot_add_dx(long long freq, const char *call, PAN_SPOT_SOURCE source, int lifetime_ms);
+extern void dxspot_delete_call(const char *call);
+extern void dxspot_expire(gint64 now);
+extern int dxspot_count(void);
+extern int dxspot_range(long long fmin, long long fmax, DXSPOT_VIEW *out, int max);
+
+#endif
@@ -36,6 +36,7 @@
 #include "actions.h"
 #include "message.h"
 #include "tci.h"
+#include "property.h"
 #ifdef SATURN
   #include "saturnmain.h"
 #endif
@@ -63,6 +64,7 @@ void stop_program(void) {
 #endif
   }
   radio_save_state();
+  flushProperties();
   t_print("%s: radio state saved\n", __func__);
 }
 
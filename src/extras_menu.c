@@ -29,6 +29,8 @@
 #include "message.h"
 #include "rx_panadapter.h"
 #include "rbn.h"
+#include "spotfeed.h"
+#include "iq_record.h"
 
 static GtkWidget *dialog = NULL;
 static gulong dxc_login_box_signal_id;
@@ -37,8 +39,29 @@ static gulong rbn_address_box_signal_id;
 static gulong atuwin_title_box_signal_id;
 static gulong atuwin_url_box_signal_id;
 static gulong atuwin_action_box_signal_id;
+static GtkWidget *spot_stats_label = NULL;
+static guint spot_stats_timer_id = 0;
+static GtkWidget *iqrec_label = NULL;
+static GtkWidget *iqrec_file_entry = NULL;
+static guint iqrec_timer_id = 0;
+static int iqrec_fast = 0;
+
+static void spot_stats_stop(void) {
+  if (spot_stats_timer_id != 0) {
+    g_source_remove(spot_stats_timer_id);
+    spot_stats_timer_id = 0;
+  }
+  spot_stats_label = NULL;
+  if (iqrec_timer_id != 0) {
+    g_source_remove(iqrec_timer_id);
+    iqrec_timer_id = 0;
+  }
+  iqrec_label = NULL;
+  iqrec_file_entry = NULL;
+}
 
 static void cleanup(void) {
+  spot_stats_stop();
   if (dialog != NULL) {
     GtkWidget *tmp = dialog;
     dialog = NULL;
@@ -55,6 +78,7 @@ static gboolean delete_event_cb(GtkWidget *widget, GdkEvent *event, gpointer dat
 }
 
 static void destroy_cb(GtkWidget *widget, gpointer data) {
+  spot_stats_stop();
   dialog = NULL;
   sub_menu = NULL;
   active_menu = NO_MENU;
@@ -175,6 +199,77 @@ static void rbn_cq_toggle_cb(GtkToggleButton *toggle, gpointer user_data) {
   rbn_filter_cq = gtk_toggle_button_get_active(toggle) ? 1 : 0;
 }
 
+static gboolean spot_stats_update_cb(gpointer data) {
+  SPOTFEED_STATS st;
+  char text[192];
+  if (spot_stats_label == NULL) {
+    spot_stats_timer_id = 0;
+    return G_SOURCE_REMOVE;
+  }
+  spotfeed_get_stats(&st);
+  snprintf(text, sizeof(text), "Spots received: %lu   filtered: %lu   duplicates: %lu   overflow: %lu   displayed: %lu",
+           st.received, st.filtered, st.duplicates, st.overflow, st.displayed);
+  gtk_label_set_text(GTK_LABEL(spot_stats_label), text);
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean iqrec_update_cb(gpointer data) {
+  IQREC_STATUS st;
+  char text[160];
+  if (iqrec_label == NULL) {
+    iqrec_timer_id = 0;
+    return G_SOURCE_REMOVE;
+  }
+  iq_record_get_status(&st);
+  switch (st.state) {
+  case IQREC_RECORDING:
+    snprintf(text, sizeof(text), "Recording: %.1f sec   %.1f MB   blocks: %lu",
+             st.seconds, st.mbytes, st.blocks);
+    break;
+  case IQREC_REPLAYING:
+    snprintf(text, sizeof(text), "Replaying: %.1f sec   blocks: %lu   skipped: %lu",
+             st.seconds, st.blocks, st.skipped);
+    break;
+  default:
+    if (st.blocks > 0 || st.skipped > 0) {
+      snprintf(text, sizeof(text), "Idle (last replay: %.1f sec, blocks: %lu, skipped: %lu)",
+               st.seconds, st.blocks, st.skipped);
+    } else {
+      snprintf(text, sizeof(text), "Idle");
+    }
+    break;
+  }
+  gtk_label_set_text(GTK_LABEL(iqrec_label), text);
+  return G_SOURCE_CONTINUE;
+}
+
+static void iqrec_record_cb(GtkWidget *widget, gpointer data) {
+  if (iqrec_file_entry == NULL) { return; }
+  const gchar *path = gtk_entry_get_text(GTK_ENTRY(iqrec_file_entry));
+  if (path != NULL && *path != '\0') {
+    iq_record_start(path);
+  }
+  iqrec_update_cb(NULL);
+}
+
+static void iqrec_replay_cb(GtkWidget *widget, gpointer data) {
+  if (iqrec_file_entry == NULL) { return; }
+  const gchar *path = gtk_entry_get_text(GTK_ENTRY(iqrec_file_entry));
+  if (path != NULL && *path != '\0') {
+    iq_replay_start(path, iqrec_fast);
+  }
+  iqrec_update_cb(NULL);
+}
+
+static void iqrec_stop_cb(GtkWidget *widget, gpointer data) {
+  iq_record_stop();
+  iqrec_update_cb(NULL);
+}
+
+static void iqrec_fast_cb(GtkToggleButton *toggle, gpointer user_data) {
+  iqrec_fast = gtk_toggle_button_get_active(toggle) ? 1 : 0;
+}
+
 static void rbn_address_button_clicked(GtkWidget *widget, gpointer data) {
   GtkEntry *rbn_address_box = GTK_ENTRY(data);
   const gchar *text = gtk_entry_get_text(rbn_address_box);
@@ -465,6 +560,20 @@ void extras_menu(GtkWidget *parent) {
   gtk_box_pack_start(GTK_BOX(rbn_address_box_container), rbn_port_spin_btn, FALSE, FALSE, 0);
   g_signal_connect(rbn_port_spin_btn, "value-changed", G_CALLBACK(rbn_port_spin_btn_changed_cb), NULL);
   gtk_grid_attach(GTK_GRID(grid), rbn_address_box_container, 0, row, 8, 1);
+  //--------------------------------------------------------------------------------
+  row++;
+  spot_stats_label = gtk_label_new(NULL);
+  gtk_widget_set_name(spot_stats_label, "boldlabel_blue");
+  gtk_widget_set_halign(spot_stats_label, GTK_ALIGN_START);
+  gtk_widget_set_margin_start(spot_stats_label, 5);
+  gtk_widget_set_tooltip_text(spot_stats_label,
+                              "Counters of the DX cluster/RBN spot feed.\n\n"
+                              "filtered: RBN spots not on a band shown by any receiver\n"
+                              "displayed: spots handed over to the RX panadapter\n\n"
+                              "An RBN address of the form file:<path> replays a recorded RBN log.");
+  gtk_grid_attach(GTK_GRID(grid), spot_stats_label, 0, row, 8, 1);
+  spot_stats_update_cb(NULL);
+  spot_stats_timer_id = g_timeout_add(1000, spot_stats_update_cb, NULL);
   if (dxcwin_open) {
     gtk_widget_set_sensitive(dxc_login_box, FALSE);
     gtk_widget_set_sensitive(dxc_login_box_btn, FALSE);
@@ -477,6 +586,63 @@ void extras_menu(GtkWidget *parent) {
   //--------------------------------------------------------------------------------
   row++;
   col = 0;
+  t_label = gtk_label_new(NULL);
+  gtk_label_set_use_markup(GTK_LABEL(t_label), TRUE);
+  gtk_label_set_markup(GTK_LABEL(t_label), "<u>IQ Capture / Replay</u>");
+  gtk_widget_set_name(t_label, "boldlabel_blue");
+  gtk_widget_set_margin_top(t_label, 10);
+  gtk_widget_set_margin_bottom(t_label, 10);
+  gtk_widget_set_halign(t_label, GTK_ALIGN_START);
+  gtk_widget_set_margin_start(t_label, 5);
+  gtk_grid_attach(GTK_GRID(grid), t_label, col, row, 3, 1);
+  //--------------------------------------------------------------------------------
+  row++;
+  GtkWidget *iqrec_box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 6);
+  gtk_widget_set_hexpand(iqrec_box, TRUE);
+  gtk_widget_set_halign(iqrec_box, GTK_ALIGN_FILL);
+  label = gtk_label_new("File:");
+  gtk_widget_set_name(label, "boldlabel_blue");
+  gtk_box_pack_start(GTK_BOX(iqrec_box), label, FALSE, FALSE, 0);
+  iqrec_file_entry = gtk_entry_new();
+  gtk_entry_set_text(GTK_ENTRY(iqrec_file_entry), "capture.iq");
+  gtk_widget_set_hexpand(iqrec_file_entry, TRUE);
+  gtk_widget_set_tooltip_text(iqrec_file_entry,
+                              "Capture file. A relative name is stored in the configuration directory.");
+  gtk_box_pack_start(GTK_BOX(iqrec_box), iqrec_file_entry, TRUE, TRUE, 0);
+  GtkWidget *iqrec_btn = gtk_button_new_with_label("Record");
+  gtk_widget_set_tooltip_text(iqrec_btn,
+                              "Record the raw IQ samples of all receivers\n"
+                              "(at most " G_STRINGIFY(IQREC_MAX_SECONDS) " seconds).");
+  gtk_box_pack_start(GTK_BOX(iqrec_box), iqrec_btn, FALSE, FALSE, 0);
+  g_signal_connect(iqrec_btn, "clicked", G_CALLBACK(iqrec_record_cb), NULL);
+  iqrec_btn = gtk_button_new_with_label("Replay");
+  gtk_widget_set_tooltip_text(iqrec_btn,
+                              "Feed the receivers from the capture file instead of the radio.\n"
+                              "Blocks for a missing receiver or a different sample rate are skipped.");
+  gtk_box_pack_start(GTK_BOX(iqrec_box), iqrec_btn, FALSE, FALSE, 0);
+  g_signal_connect(iqrec_btn, "clicked", G_CALLBACK(iqrec_replay_cb), NULL);
+  iqrec_btn = gtk_button_new_with_label("Stop");
+  gtk_box_pack_start(GTK_BOX(iqrec_box), iqrec_btn, FALSE, FALSE, 0);
+  g_signal_connect(iqrec_btn, "clicked", G_CALLBACK(iqrec_stop_cb), NULL);
+  GtkWidget *iqrec_fast_btn = gtk_check_button_new_with_label("Full speed");
+  gtk_widget_set_name(iqrec_fast_btn, "boldlabel_blue");
+  gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(iqrec_fast_btn), iqrec_fast);
+  gtk_widget_set_tooltip_text(iqrec_fast_btn, "Replay as fast as possible instead of at the recorded pace.");
+  gtk_box_pack_start(GTK_BOX(iqrec_box), iqrec_fast_btn, FALSE, FALSE, 0);
+  g_signal_connect(iqrec_fast_btn, "toggled", G_CALLBACK(iqrec_fast_cb), NULL);
+  gtk_grid_attach(GTK_GRID(grid), iqrec_box, 0, row, 8, 1);
+  //--------------------------------------------------------------------------------
+  row++;
+  iqrec_label = gtk_label_new(NULL);
+  gtk_widget_set_name(iqrec_label, "boldlabel_blue");
+  gtk_widget_set_halign(iqrec_label, GTK_ALIGN_START);
+  gtk_widget_set_margin_start(iqrec_label, 5);
+  gtk_grid_attach(GTK_GRID(grid), iqrec_label, 0, row, 8, 1);
+  iqrec_update_cb(NULL);
+  iqrec_timer_id = g_timeout_add(500, iqrec_update_cb, NULL);
+  //--------------------------------------------------------------------------------
+  row++;
+  col = 0;
   GtkWidget *sep = gtk_separator_new(GTK_ORIENTATION_HORIZONTAL);
   gtk_widget_set_name(sep, "menu_separator");
   gtk_widget_set_size_request(sep, -1, 3);
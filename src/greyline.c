@@ -63,6 +63,18 @@ typedef struct {
   GdkPixbuf *map_pixbuf;
   cairo_surface_t *map_surface;
 
+  /* map pre-scaled to the current window size */
+  cairo_surface_t *scaled_map;
+  int scaled_w;
+  int scaled_h;
+
+  /* scaled map with night shading and terminator, see update_frame() */
+  cairo_surface_t *frame;
+  int frame_w;
+  int frame_h;
+  double frame_sub_lat;
+  double frame_sub_lon;
+
   guint timer_id;
 
   double aspect_w_over_h;
@@ -86,16 +98,6 @@ static GdkPixbuf *load_embedded_jpg(void) {
   return pixbuf;
 }
 
-static gboolean get_embedded_map_dims(int *mw, int *mh) {
-  if (!mw || !mh) { return FALSE; }
-  GdkPixbuf *pb = load_embedded_jpg();
-  if (!pb) { return FALSE; }
-  *mw = gdk_pixbuf_get_width(pb);
-  *mh = gdk_pixbuf_get_height(pb);
-  g_object_unref(pb);
-  return (*mw > 0 && *mh > 0);
-}
-
 /* --- Maidenhead locator (4/6 chars typical) -> lat/lon (approx center) --- */
 static gboolean locator_to_latlon(const char *loc, double *lat, double *lon) {
   if (!loc || !lat || !lon) { return FALSE; }
@@ -189,9 +191,7 @@ static void subsolar_point_utc(double *sub_lat, double *sub_lon) {
 }
 
 /* --- D-Layer estimation helpers (solar altitude based) --- */
-static double solar_altitude_deg(double lat_deg, double lon_deg) {
-  double sub_lat, sub_lon;
-  subsolar_point_utc(&sub_lat, &sub_lon);
+static double solar_altitude_deg(double sub_lat, double sub_lon, double lat_deg, double lon_deg) {
   double lat = DEG2RAD(lat_deg);
   double lon = DEG2RAD(lon_deg);
   double dec = DEG2RAD(sub_lat);
@@ -230,10 +230,11 @@ static void draw_band_state(cairo_t *cr, double x, double y, const char *label,
   draw_text_shadow(cr, x + 16, y, label);
 }
 
-static void draw_dlayer_panel(cairo_t *cr, int w, int h, const char *locator) {
+static void draw_dlayer_panel(cairo_t *cr, int w, int h, const char *locator,
+                              double sub_lat, double sub_lon) {
   double lat, lon;
   if (!locator_to_latlon(locator, &lat, &lon)) { return; }
-  double alt = solar_altitude_deg(lat, lon);
+  double alt = solar_altitude_deg(sub_lat, sub_lon, lat, lon);
   /* Simple operational traffic-light logic */
   /* 160/80m: highly D-layer sensitive */
   gboolean lo_red    = (alt > 0.0);
@@ -303,9 +304,7 @@ static double terminator_lat_for_lon(double sub_lat, double sub_lon, double lon)
   return RAD2DEG(atan(-cos(lam) / tanphi));
 }
 
-static void draw_greyline_overlay(cairo_t *cr, int w, int h) {
-  double sub_lat, sub_lon;
-  subsolar_point_utc(&sub_lat, &sub_lon);
+static void draw_greyline_overlay(cairo_t *cr, int w, int h, double sub_lat, double sub_lon) {
   int steps = w;
   if (steps < 400) { steps = 400; }
   double step = (double) w / (double) steps;
@@ -395,37 +394,90 @@ static void draw_locator_marker(cairo_t *cr, int w, int h, const char *locator)
   }
 }
 
-/* --- GTK draw callback --- */
-static gboolean on_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
-  GreylineWin *gw = (GreylineWin *) user_data;
-  GtkAllocation a;
-  gtk_widget_get_allocation(widget, &a);
-  gw->w = a.width;
-  gw->h = a.height;
+/* --- Cached background ---
+ * Scaling the map and tracing the terminator are by far the most expensive
+ * parts of a redraw. The scaled map is kept per window size, and the map
+ * with night shading and terminator ("frame") is only rebuilt if the window
+ * size changes or the subsolar point has moved by more than one pixel.
+ * Expose events and the periodic refresh then only blit the frame and draw
+ * the marker and the D-layer panel on top.
+ */
+static void update_scaled_map(GreylineWin *gw, cairo_t *cr) {
+  if (gw->scaled_map && gw->scaled_w == gw->w && gw->scaled_h == gw->h) { return; }
+  if (gw->scaled_map) {
+    cairo_surface_destroy(gw->scaled_map);
+    gw->scaled_map = NULL;
+  }
   if (!gw->map_surface) {
     if (!gw->map_pixbuf) { gw->map_pixbuf = load_embedded_jpg(); }
     if (gw->map_pixbuf) {
       gw->map_surface = gdk_cairo_surface_create_from_pixbuf(gw->map_pixbuf, 1, NULL);
     }
   }
-  if (gw->map_surface) {
-    cairo_save(cr);
-    int mw = gdk_pixbuf_get_width(gw->map_pixbuf);
-    int mh = gdk_pixbuf_get_height(gw->map_pixbuf);
-    cairo_scale(cr,
-                (double) gw->w / (double) mw,
-                (double) gw->h / (double) mh);
-    cairo_set_source_surface(cr, gw->map_surface, 0, 0);
-    cairo_paint(cr);
-    cairo_restore(cr);
+  if (!gw->map_surface) { return; }
+  int mw = gdk_pixbuf_get_width(gw->map_pixbuf);
+  int mh = gdk_pixbuf_get_height(gw->map_pixbuf);
+  gw->scaled_map = cairo_surface_create_similar(cairo_get_target(cr), CAIRO_CONTENT_COLOR, gw->w, gw->h);
+  gw->scaled_w = gw->w;
+  gw->scaled_h = gw->h;
+  cairo_t *mc = cairo_create(gw->scaled_map);
+  cairo_scale(mc,
+              (double) gw->w / (double) mw,
+              (double) gw->h / (double) mh);
+  cairo_set_source_surface(mc, gw->map_surface, 0, 0);
+  cairo_pattern_set_filter(cairo_get_source(mc), CAIRO_FILTER_GOOD);
+  cairo_paint(mc);
+  cairo_destroy(mc);
+}
+
+static void update_frame(GreylineWin *gw, cairo_t *cr, double sub_lat, double sub_lon) {
+  if (gw->frame && gw->frame_w == gw->w && gw->frame_h == gw->h) {
+    double dx = fabs(sub_lon - gw->frame_sub_lon);
+    if (dx > 180.0) { dx = 360.0 - dx; }
+    dx = dx / 360.0 * (double) gw->w;
+    double dy = fabs(sub_lat - gw->frame_sub_lat) / 180.0 * (double) gw->h;
+    if (dx <= 1.0 && dy <= 1.0) { return; }
+  }
+  if (gw->frame && (gw->frame_w != gw->w || gw->frame_h != gw->h)) {
+    cairo_surface_destroy(gw->frame);
+    gw->frame = NULL;
+  }
+  update_scaled_map(gw, cr);
+  if (!gw->frame) {
+    gw->frame = cairo_surface_create_similar(cairo_get_target(cr), CAIRO_CONTENT_COLOR, gw->w, gw->h);
+    gw->frame_w = gw->w;
+    gw->frame_h = gw->h;
+  }
+  gw->frame_sub_lat = sub_lat;
+  gw->frame_sub_lon = sub_lon;
+  cairo_t *fc = cairo_create(gw->frame);
+  if (gw->scaled_map) {
+    cairo_set_source_surface(fc, gw->scaled_map, 0, 0);
+    cairo_paint(fc);
   } else {
-    cairo_set_source_rgb(cr, 0.08, 0.08, 0.10);
-    cairo_rectangle(cr, 0, 0, gw->w, gw->h);
-    cairo_fill(cr);
+    cairo_set_source_rgb(fc, 0.08, 0.08, 0.10);
+    cairo_rectangle(fc, 0, 0, gw->w, gw->h);
+    cairo_fill(fc);
   }
-  draw_greyline_overlay(cr, gw->w, gw->h);
+  draw_greyline_overlay(fc, gw->w, gw->h, sub_lat, sub_lon);
+  cairo_destroy(fc);
+}
+
+/* --- GTK draw callback --- */
+static gboolean on_draw(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
+  GreylineWin *gw = (GreylineWin *) user_data;
+  GtkAllocation a;
+  double sub_lat, sub_lon;
+  gtk_widget_get_allocation(widget, &a);
+  gw->w = a.width;
+  gw->h = a.height;
+  if (gw->w <= 0 || gw->h <= 0) { return FALSE; }
+  subsolar_point_utc(&sub_lat, &sub_lon);
+  update_frame(gw, cr, sub_lat, sub_lon);
+  cairo_set_source_surface(cr, gw->frame, 0, 0);
+  cairo_paint(cr);
   draw_locator_marker(cr, gw->w, gw->h, gw->locator);
-  draw_dlayer_panel(cr, gw->w, gw->h, gw->locator);
+  draw_dlayer_panel(cr, gw->w, gw->h, gw->locator, sub_lat, sub_lon);
   return FALSE;
 }
 
@@ -446,6 +498,14 @@ static void on_window_destroy(GtkWidget *widget, gpointer user_data) {
     g_source_remove(gw->timer_id);
     gw->timer_id = 0;
   }
+  if (gw->frame) {
+    cairo_surface_destroy(gw->frame);
+    gw->frame = NULL;
+  }
+  if (gw->scaled_map) {
+    cairo_surface_destroy(gw->scaled_map);
+    gw->scaled_map = NULL;
+  }
   if (gw->map_surface) {
     cairo_surface_destroy(gw->map_surface);
     gw->map_surface = NULL;
@@ -470,10 +530,13 @@ static void open_impl(GtkWindow *parent, int window_width, int window_height, co
   } else {
     strcpy(gw->locator, "UNKNOWN");
   }
+  /* Decode the embedded map once, it is needed for the aspect ratio and the first draw */
+  gw->map_pixbuf = load_embedded_jpg();
   /* Auto height from embedded map aspect ratio */
   if (window_height <= 0) {
-    int mw = 0, mh = 0;
-    if (get_embedded_map_dims(&mw, &mh) && mw > 0 && mh > 0) {
+    int mw = gw->map_pixbuf ? gdk_pixbuf_get_width(gw->map_pixbuf) : 0;
+    int mh = gw->map_pixbuf ? gdk_pixbuf_get_height(gw->map_pixbuf) : 0;
+    if (mw > 0 && mh > 0) {
       aspect_w_over_h = (double) mw / (double) mh;
       window_height = (int) lround(((double) window_width * (double) mh) / (double) mw);
     } else {
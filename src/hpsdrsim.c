@@ -340,6 +340,10 @@ int main(int argc, char *argv[]) {
     if (!strncmp(argv[i], "-slow",         5))  {speed = -1; continue;}
     if (!strncmp(argv[i], "-P1",           5))  { NDEVICE = DEV_NONE; continue; }
     if (!strncmp(argv[i], "-P2",           5))  { ODEVICE = DEV_NONE; continue; }
+    if (!strncmp(argv[i], "-load",         5))  {
+      if (i < argc - 1 && load_scenario(argv[++i]) == 0) { continue; }
+      exit(8);
+    }
     if (!strncmp(argv[i], "-nb",           3))  {
       noiseblank = 1;
       if (i < argc - 1) { sscanf(argv[++i], "%d", &nb_pulse); }
@@ -352,7 +356,7 @@ int main(int argc, char *argv[]) {
     t_print("Valid options are: -atlas | -metis  | -hermes     | -hermes2     | -angelia |\n");
     t_print("                   -orion | -orion2 | -hermeslite | -hermeslite2 | -c25     |\n");
     t_print("                   -diversity | -fast | -slow    |\n");
-    t_print("                   -nb <num> <width>\n");
+    t_print("                   -nb <num> <width> | -load <scenario file>\n");
     exit(8);
   }
   //
@@ -1456,7 +1460,7 @@ void *handler_ep6(void *arg) {
   int32_t myisample, myqsample;
   struct timespec delay;
   long wait;
-  int noiseIQpt, divpt, rxptr;
+  int noiseIQpt, divpt, loadpt, rxptr;
   double i1, q1, fac1, fac1a, fac2, fac3, fac4;
   unsigned int seed;
   int decimation;
@@ -1466,6 +1470,7 @@ void *handler_ep6(void *arg) {
   counter = 0;
   noiseIQpt = 0;
   divpt = 0;
+  loadpt = 0;
   rxptr = OLDRTXLEN / 2 - 4096;
   clock_gettime(CLOCK_MONOTONIC, &delay);
   while (1) {
@@ -1628,6 +1633,9 @@ void *handler_ep6(void *arg) {
           fac3 = IM3a + IM3b * (i1 * i1 + q1 * q1);
           adc1isample = (txatt_dbl * i1 * fac3 + noiseItab[noiseIQpt] * p1noisefac) * 8388607.0;
           adc1qsample = (txatt_dbl * q1 * fac3 + noiseItab[noiseIQpt] * p1noisefac) * 8388607.0;
+        } else if (load_mode) {
+          adc1isample = (noiseItab[noiseIQpt] * p1noisefac + loadItab[loadpt] * rxatt_dbl[0]) * 8388607.0;
+          adc1qsample = (noiseQtab[noiseIQpt] * p1noisefac + loadQtab[loadpt] * rxatt_dbl[0]) * 8388607.0;
         } else if (diversity && do_tone == 1) {
           // man made noise to ADC1 samples
           adc1isample = (noiseItab[noiseIQpt] * p1noisefac + cos(tonearg) * fac1 + divtab[divpt] * fac2) * 8388607.0;
@@ -1714,6 +1722,8 @@ void *handler_ep6(void *arg) {
         if (tonearg2 < -6.3) { tonearg2  += 6.283185307179586476925286766559; }
         divpt += decimation;
         if (divpt >= LENDIV) { divpt = 0; }
+        loadpt += decimation;
+        if (loadpt >= LENLOAD) { loadpt = 0; }
       }
     }
     //
@@ -1730,7 +1740,7 @@ void *handler_ep6(void *arg) {
         t_print("TCP sendmsg error occurred at sequence number: %u !\n", counter);
       }
     } else {
-      sendto(sock_udp, buffer, 1032, 0, (struct sockaddr *)&addr_old, sizeof(addr_old));
+      load_sendto(0, sock_udp, buffer, 1032, &addr_old);
     }
   }
   active_thread = 0;
@@ -77,6 +77,22 @@ EXTERN int nb_pulse, nb_width;
 #define LENDIV 48000
 EXTERN double divtab[LENDIV];
 
+//
+// Load-generator mode (simload.c): a 100 msec table of the
+// RX signal at 1536 kHz, built from a scenario file, and
+// random loss/re-ordering/delay of the RX IQ packets.
+// Stream 0 is the P1 EP6 stream, stream 1+n is P2 DDC n.
+//
+#define LENLOAD 153600
+#define LOAD_STREAMS 16
+EXTERN int load_mode;
+EXTERN double loadItab[LENLOAD];
+EXTERN double loadQtab[LENLOAD];
+EXTERN double load_loss, load_reorder;   // percent
+EXTERN int load_jitter;                  // usec
+int     load_scenario(const char *filename);
+ssize_t load_sendto(int stream, int sock, const void *buf, size_t len, const struct sockaddr_in *addr);
+
 //
 // A table of RX IQ data (60 seconds 48k sample rate)
 // with speech.
@@ -0,0 +1,327 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Capture of raw RX IQ samples into a file, and replay of such a file
+ * as the IQ source of the receivers.
+ *
+ * Recording: rx_add_iq_samples() hands every IQ sample of every receiver
+ * (after decoding by the protocol back-end) to iq_record_sample(), which
+ * collects blocks of IQREC_BLOCK samples per receiver. A complete block gets
+ * a header with sequence number, receiver id, sample rate and time stamp and
+ * is copied into a memory-mapped file. Space in the file is reserved with
+ * an atomic add, so the protocol threads never take a lock. They may still
+ * stall on a page fault when writing to a fresh page of the mapping, which
+ * is why the file blocks are allocated up front. The file is sized for
+ * IQREC_MAX_SECONDS at the current sample rates, but at most
+ * IQREC_MAX_MBYTES, and truncated to the recorded length when the capture
+ * stops.
+ *
+ * Replay: the file is mapped read-only and the "IQ replay" thread feeds the
+ * blocks into rx_feed_iq_samples(), either at the recorded pace or as fast
+ * as possible. Live IQ samples are dropped while replaying.
+ *
+ * rx_add_iq_samples() and rx_add_iq_block() count the protocol threads
+ * inside them in iq_record_feeders. After changing iq_record_flags, a
+ * state change waits until this count has dropped to zero, so that no
+ * protocol thread still acts on the old state. In particular, the replay
+ * thread and the protocol threads never write the receiver input buffers
+ * at the same time.
+ */
+
+#include <gtk/gtk.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "iq_record.h"
+#include "message.h"
+#include "radio.h"
+#include "receiver.h"
+
+#define IQREC_MAX_RX 8
+
+int iq_record_flags = IQREC_IDLE;
+int iq_record_feeders = 0;
+
+static int rec_fd = -1;
+static unsigned char *rec_map = NULL;
+static size_t rec_size = 0;
+static atomic_size_t rec_used;
+static atomic_uint rec_seq;
+static int rec_full = 0;
+static gint64 rec_start_us = 0;
+static double rec_acc[IQREC_MAX_RX][2 * IQREC_BLOCK];
+static int rec_acc_n[IQREC_MAX_RX];
+
+static GMappedFile *replay_file = NULL;
+static GThread *replay_thread_id = NULL;
+static int replay_fast = 0;
+static unsigned long replay_blocks = 0;
+static unsigned long replay_skipped = 0;
+static gint64 replay_us = 0;
+static size_t replay_offset = 0;
+static int replay_stop = 0;
+
+//
+// Wait until no protocol thread is inside the IQ feed. Each one is only
+// in there for one sample or one packet, so this does not take long.
+//
+static void feed_drain(void) {
+  while (g_atomic_int_get(&iq_record_feeders) > 0) {
+    g_usleep(100);
+  }
+}
+
+static void rec_append(const RECEIVER *rx, const double *iq) {
+  if (g_atomic_int_get(&iq_record_flags) == IQREC_RECORDING) {
+    size_t need = sizeof(IQREC_BLOCK_HEADER) + 2 * IQREC_BLOCK * sizeof(double);
+    size_t off = atomic_fetch_add(&rec_used, need);
+    if (off + need <= rec_size) {
+      IQREC_BLOCK_HEADER h;
+      h.seq = atomic_fetch_add(&rec_seq, 1);
+      h.rx = rx->id;
+      h.sample_rate = rx->sample_rate;
+      h.samples = IQREC_BLOCK;
+      h.t_us = g_get_monotonic_time() - rec_start_us;
+      memcpy(rec_map + off, &h, sizeof(h));
+      memcpy(rec_map + off + sizeof(h), iq, 2 * IQREC_BLOCK * sizeof(double));
+    } else {
+      g_atomic_int_set(&rec_full, 1);
+    }
+  }
+}
+
+//
+// Called for each IQ sample while recording, from the protocol threads
+//
+void iq_record_sample(const RECEIVER *rx, double i_sample, double q_sample) {
+  int id = rx->id;
+  if (id < 0 || id >= IQREC_MAX_RX) {
+    return;
+  }
+  double *acc = rec_acc[id];
+  acc[2 * rec_acc_n[id]] = i_sample;
+  acc[2 * rec_acc_n[id] + 1] = q_sample;
+  if (++rec_acc_n[id] >= IQREC_BLOCK) {
+    rec_append(rx, acc);
+    rec_acc_n[id] = 0;
+  }
+}
+
+static void replay_join(void) {
+  if (replay_thread_id != NULL) {
+    g_thread_join(replay_thread_id);
+    replay_thread_id = NULL;
+  }
+  if (replay_file != NULL) {
+    g_mapped_file_unref(replay_file);
+    replay_file = NULL;
+  }
+}
+
+int iq_record_start(const char *path) {
+  IQREC_FILE_HEADER fh;
+  size_t rate_sum = 0;
+  iq_record_stop();
+  for (int i = 0; i < receivers; i++) {
+    if (receiver[i] != NULL) {
+      rate_sum += (size_t) receiver[i]->sample_rate;
+    }
+  }
+  rec_size = sizeof(fh) + rate_sum * IQREC_MAX_SECONDS * 2 * sizeof(double)
+             + (rate_sum * IQREC_MAX_SECONDS / IQREC_BLOCK + receivers) * sizeof(IQREC_BLOCK_HEADER);
+  if (rec_size > ((size_t) IQREC_MAX_MBYTES << 20)) {
+    rec_size = (size_t) IQREC_MAX_MBYTES << 20;
+  }
+  rec_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (rec_fd < 0) {
+    t_perror("iq_record_start: open");
+    return -1;
+  }
+  //
+  // Allocate the file blocks now rather than at the first write to each
+  // page, which happens in the protocol threads. Fall back to a sparse
+  // file where this is not supported.
+  //
+  int rc = posix_fallocate(rec_fd, 0, (off_t) rec_size);
+  if (rc != 0) {
+    t_print("%s: posix_fallocate: %s\n", __func__, g_strerror(rc));
+    if (ftruncate(rec_fd, (off_t) rec_size) < 0) {
+      t_perror("iq_record_start: ftruncate");
+      close(rec_fd);
+      rec_fd = -1;
+      return -1;
+    }
+  }
+  rec_map = mmap(NULL, rec_size, PROT_READ | PROT_WRITE, MAP_SHARED, rec_fd, 0);
+  if (rec_map == MAP_FAILED) {
+    t_perror("iq_record_start: mmap");
+    rec_map = NULL;
+    close(rec_fd);
+    rec_fd = -1;
+    return -1;
+  }
+  rec_start_us = g_get_monotonic_time();
+  fh.magic = IQREC_MAGIC;
+  fh.version = IQREC_VERSION;
+  fh.block_samples = IQREC_BLOCK;
+  fh.receivers = (uint32_t) receivers;
+  fh.start_us = rec_start_us;
+  memcpy(rec_map, &fh, sizeof(fh));
+  atomic_store(&rec_used, sizeof(fh));
+  atomic_store(&rec_seq, 0);
+  rec_full = 0;
+  memset(rec_acc_n, 0, sizeof(rec_acc_n));
+  t_print("%s: %s, %zu MB for %.0f sec\n", __func__, path, rec_size >> 20,
+          rate_sum > 0 ? (double) rec_size / ((double) rate_sum * 2 * sizeof(double)) : 0.0);
+  g_atomic_int_set(&iq_record_flags, IQREC_RECORDING);
+  return 0;
+}
+
+static gpointer replay_thread(gpointer data) {
+  const unsigned char *base = (const unsigned char *) g_mapped_file_get_contents(replay_file);
+  size_t len = g_mapped_file_get_length(replay_file);
+  size_t off = sizeof(IQREC_FILE_HEADER);
+  //
+  // Protocol threads that entered the feed before the state changed to
+  // IQREC_REPLAYING may still write the receiver input buffers
+  //
+  feed_drain();
+  gint64 t0 = g_get_monotonic_time();
+  while (!g_atomic_int_get(&replay_stop) && off + sizeof(IQREC_BLOCK_HEADER) <= len) {
+    IQREC_BLOCK_HEADER h;
+    memcpy(&h, base + off, sizeof(h));
+    size_t bytes = (size_t) h.samples * 2 * sizeof(double);
+    if (off + sizeof(h) + bytes > len) {
+      break;
+    }
+    const double *iq = (const double *)(base + off + sizeof(h));
+    off += sizeof(h) + bytes;
+    if (!replay_fast) {
+      gint64 wait = t0 + h.t_us - g_get_monotonic_time();
+      if (wait > 0) {
+        g_usleep(wait);
+      }
+    }
+    RECEIVER *rx = (h.rx >= 0 && h.rx < receivers) ? receiver[h.rx] : NULL;
+    if (rx == NULL || rx->sample_rate != h.sample_rate) {
+      replay_skipped++;
+      continue;
+    }
+    for (uint32_t i = 0; i < h.samples; i++) {
+      rx_feed_iq_samples(rx, iq[2 * i], iq[2 * i + 1]);
+    }
+    replay_blocks++;
+    replay_us = h.t_us;
+    replay_offset = off;
+  }
+  t_print("%s: done, blocks=%lu skipped=%lu\n", __func__, replay_blocks, replay_skipped);
+  //
+  // This thread does not touch the receivers any more, so live samples
+  // may flow again
+  //
+  g_atomic_int_set(&iq_record_flags, IQREC_IDLE);
+  return NULL;
+}
+
+int iq_replay_start(const char *path, int fast) {
+  GError *error = NULL;
+  IQREC_FILE_HEADER fh;
+  iq_record_stop();
+  replay_file = g_mapped_file_new(path, FALSE, &error);
+  if (replay_file == NULL) {
+    t_print("%s: %s\n", __func__, error->message);
+    g_error_free(error);
+    return -1;
+  }
+  if (g_mapped_file_get_length(replay_file) < sizeof(fh)) {
+    t_print("%s: %s: file too short\n", __func__, path);
+    replay_join();
+    return -1;
+  }
+  memcpy(&fh, g_mapped_file_get_contents(replay_file), sizeof(fh));
+  if (fh.magic != IQREC_MAGIC || fh.version != IQREC_VERSION) {
+    t_print("%s: %s: not an IQ capture file\n", __func__, path);
+    replay_join();
+    return -1;
+  }
+  replay_fast = fast;
+  replay_blocks = 0;
+  replay_skipped = 0;
+  replay_us = 0;
+  replay_offset = sizeof(fh);
+  replay_stop = 0;
+  t_print("%s: %s, %s\n", __func__, path, fast ? "fast" : "real-time");
+  g_atomic_int_set(&iq_record_flags, IQREC_REPLAYING);
+  replay_thread_id = g_thread_new("IQ replay", replay_thread, NULL);
+  return 0;
+}
+
+void iq_record_stop(void) {
+  //
+  // A replay is stopped by the replay thread itself, which returns the
+  // state to IQREC_IDLE only after it has fed its last sample
+  //
+  g_atomic_int_set(&replay_stop, 1);
+  replay_join();
+  if (rec_map != NULL) {
+    g_atomic_int_set(&iq_record_flags, IQREC_IDLE);
+    feed_drain();
+    size_t used = atomic_load(&rec_used);
+    if (used > rec_size) {
+      used = rec_size;
+    }
+    // the block that did not fit may have advanced rec_used
+    used -= (used - sizeof(IQREC_FILE_HEADER)) % (sizeof(IQREC_BLOCK_HEADER) + 2 * IQREC_BLOCK * sizeof(double));
+    munmap(rec_map, rec_size);
+    rec_map = NULL;
+    if (ftruncate(rec_fd, (off_t) used) < 0) {
+      t_perror("iq_record_stop: ftruncate");
+    }
+    close(rec_fd);
+    rec_fd = -1;
+    t_print("%s: recorded %zu bytes\n", __func__, used);
+  }
+}
+
+void iq_record_get_status(IQREC_STATUS *status) {
+  status->state = g_atomic_int_get(&iq_record_flags);
+  status->full = 0;
+  switch (status->state) {
+  case IQREC_RECORDING: {
+    size_t used = atomic_load(&rec_used);
+    if (used > rec_size) { used = rec_size; }
+    status->blocks = atomic_load(&rec_seq);
+    status->skipped = 0;
+    status->seconds = 1.0E-6 * (double)(g_get_monotonic_time() - rec_start_us);
+    status->mbytes = (double) used / 1048576.0;
+    status->full = g_atomic_int_get(&rec_full);
+  }
+  break;
+  default:
+    status->blocks = replay_blocks;
+    status->skipped = replay_skipped;
+    status->seconds = 1.0E-6 * (double) replay_us;
+    status->mbytes = (double) replay_offset / 1048576.0;
+    break;
+  }
+}
@@ -0,0 +1,77 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef _IQ_RECORD_H
+#define _IQ_RECORD_H
+
+#include <stdint.h>
+
+#include "receiver.h"
+
+//
+// IQ capture file: one IQREC_FILE_HEADER, followed by blocks of
+// one IQREC_BLOCK_HEADER and 2*samples doubles (I/Q interleaved).
+// All values are stored in host byte order.
+//
+#define IQREC_MAGIC        0x51494844u    // "DHIQ"
+#define IQREC_VERSION      1
+#define IQREC_BLOCK        1024           // IQ samples per block
+#define IQREC_MAX_SECONDS  60             // size of the mapped capture file
+#define IQREC_MAX_MBYTES   1024           // ... but at most this many MB
+
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t block_samples;
+  uint32_t receivers;
+  int64_t  start_us;          // monotonic time of the start of the capture
+} IQREC_FILE_HEADER;
+
+typedef struct {
+  uint32_t seq;               // block sequence number over all receivers
+  int32_t  rx;                // receiver id
+  int32_t  sample_rate;
+  uint32_t samples;           // IQ samples following this header
+  int64_t  t_us;              // time of the last sample, relative to start_us
+} IQREC_BLOCK_HEADER;
+
+enum {
+  IQREC_IDLE = 0,
+  IQREC_RECORDING = 1,
+  IQREC_REPLAYING = 2
+};
+
+typedef struct {
+  int state;
+  unsigned long blocks;       // blocks recorded or replayed
+  unsigned long skipped;      // replay: blocks for a missing receiver or a different sample rate
+  double seconds;             // recorded/replayed time
+  double mbytes;
+  int full;                   // recording stopped since the file is full
+} IQREC_STATUS;
+
+extern int iq_record_flags;
+extern int iq_record_feeders;
+
+extern int iq_record_start(const char *path);
+extern int iq_replay_start(const char *path, int fast);
+extern void iq_record_stop(void);
+extern void iq_record_get_status(IQREC_STATUS *status);
+extern void iq_record_sample(const RECEIVER *rx, double i_sample, double q_sample);
+
+#endif
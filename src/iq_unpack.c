@@ -0,0 +1,110 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Block decoder for 24-bit big-endian sample words as used in the
+ * HPSDR protocols.
+ *
+ * iq_unpack24() converts n words into doubles multiplied by 'scale'
+ * (normally IQ_UNPACK_SCALE times a gain) and returns non-zero if any
+ * word is at full scale (ADC overload).
+ *
+ * The SSSE3 (x86) and NEON (aarch64) paths give the same bits as the
+ * scalar one: converting an int to double is exact, and each value gets
+ * exactly one multiplication. Multiplying by 2^-23 and then by a gain
+ * rounds the same as multiplying by the pre-computed product, since
+ * scaling by a power of two is exact.
+ */
+
+#if defined(__SSSE3__)
+  #include <tmmintrin.h>
+#elif defined(__aarch64__)
+  #include <arm_neon.h>
+#endif
+
+#include "iq_unpack.h"
+
+#define IQ_FULL_SCALE_POS  8388607
+#define IQ_FULL_SCALE_NEG -8388608
+
+static inline int iq_word(const unsigned char *p) {
+  int w;
+  w  = (int)((signed char) p[0]) << 16;
+  w |= (int)(((unsigned char) p[1] << 8) & 0xFF00);
+  w |= (int)((unsigned char) p[2] & 0xFF);
+  return w;
+}
+
+int iq_unpack24(const unsigned char *src, int n, double scale, double *dst) {
+  int i = 0;
+  int ovf = 0;
+#if defined(__SSSE3__)
+  //
+  // 4 words per step. Each word is moved into the upper three bytes of
+  // an int32 lane and then shifted down arithmetically. A step reads 16
+  // bytes but uses 12, so stop while less than 16 bytes are left.
+  //
+  const __m128i shuf = _mm_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9);
+  const __m128i pos = _mm_set1_epi32(IQ_FULL_SCALE_POS - 1);
+  const __m128i neg = _mm_set1_epi32(IQ_FULL_SCALE_NEG + 1);
+  const __m128d vs = _mm_set1_pd(scale);
+  __m128i vo = _mm_setzero_si128();
+  for (; i + 6 <= n; i += 4) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(src + 3 * i));
+    v = _mm_srai_epi32(_mm_shuffle_epi8(v, shuf), 8);
+    vo = _mm_or_si128(vo, _mm_or_si128(_mm_cmpgt_epi32(v, pos), _mm_cmplt_epi32(v, neg)));
+    _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_cvtepi32_pd(v), vs));
+    _mm_storeu_pd(dst + i + 2, _mm_mul_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(v, v)), vs));
+  }
+  ovf = _mm_movemask_epi8(vo) != 0;
+#elif defined(__aarch64__)
+  //
+  // 16 words per step. vld3 splits the bytes into high, mid and low
+  // planes, which are zipped back into sign-extended int32 lanes.
+  //
+  const int32x4_t pos = vdupq_n_s32(IQ_FULL_SCALE_POS);
+  const int32x4_t neg = vdupq_n_s32(IQ_FULL_SCALE_NEG);
+  uint32x4_t vo = vdupq_n_u32(0);
+  for (; i + 16 <= n; i += 16) {
+    uint8x16x3_t b = vld3q_u8(src + 3 * i);
+    uint8x16x2_t lm = vzipq_u8(b.val[2], b.val[1]);
+    int8x16_t hi = vreinterpretq_s8_u8(b.val[0]);
+    uint16x8x2_t w0 = vzipq_u16(vreinterpretq_u16_u8(lm.val[0]), vreinterpretq_u16_s16(vmovl_s8(vget_low_s8(hi))));
+    uint16x8x2_t w1 = vzipq_u16(vreinterpretq_u16_u8(lm.val[1]), vreinterpretq_u16_s16(vmovl_s8(vget_high_s8(hi))));
+    int32x4_t v[4];
+    v[0] = vreinterpretq_s32_u16(w0.val[0]);
+    v[1] = vreinterpretq_s32_u16(w0.val[1]);
+    v[2] = vreinterpretq_s32_u16(w1.val[0]);
+    v[3] = vreinterpretq_s32_u16(w1.val[1]);
+    for (int k = 0; k < 4; k++) {
+      vo = vorrq_u32(vo, vorrq_u32(vcgeq_s32(v[k], pos), vcleq_s32(v[k], neg)));
+      vst1q_f64(dst + i + 4 * k, vmulq_n_f64(vcvtq_f64_s64(vmovl_s32(vget_low_s32(v[k]))), scale));
+      vst1q_f64(dst + i + 4 * k + 2, vmulq_n_f64(vcvtq_f64_s64(vmovl_s32(vget_high_s32(v[k]))), scale));
+    }
+  }
+  ovf = vmaxvq_u32(vo) != 0;
+#endif
+  for (; i < n; i++) {
+    int w = iq_word(src + 3 * i);
+    if (w >= IQ_FULL_SCALE_POS || w <= IQ_FULL_SCALE_NEG) {
+      ovf = 1;
+    }
+    dst[i] = (double) w * scale;
+  }
+  return ovf;
+}
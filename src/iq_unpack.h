@@ -0,0 +1,34 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef _IQ_UNPACK_H
+#define _IQ_UNPACK_H
+
+//
+// The "obscure" constant 1.1920928955078125E-7 is 1/(2^23)
+//
+#define IQ_UNPACK_SCALE 1.1920928955078125E-7
+
+//
+// Max. number of 24-bit words in one P2 DDC packet (1444 bytes)
+//
+#define IQ_UNPACK_MAX_WORDS 476
+
+extern int iq_unpack24(const unsigned char *src, int n, double scale, double *dst);
+
+#endif
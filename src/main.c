@@ -67,6 +67,7 @@
 #include "exit_menu.h"
 #include "message.h"
 #include "startup.h"
+#include "thread_role.h"
 #ifdef TTS
   #include "tts.h"
 #endif
@@ -694,11 +695,6 @@ static void activate_deskhpsdr(GtkApplication *app, gpointer data) {
   */
   // Hier setzen wir den GTK-Mainloop-Thread
   deskhpsdr_main_thread = pthread_self();
-#ifdef MIDI
-  g_mutex_init(&vfo_timer.lock);
-  g_mutex_init(&vfoa_timer.lock);
-  g_mutex_init(&vfob_timer.lock);
-#endif
   char text[2048];
   char config_directory[1024];
   (void) getcwd(config_directory, sizeof(config_directory));
@@ -748,6 +744,7 @@ static void activate_deskhpsdr(GtkApplication *app, gpointer data) {
   // Jetzt erst CSS laden, damit es das Theme übersteuert
   t_print("%s: config_directory = %s\n", __func__, config_directory);
   StartConfigLoad();
+  thread_role_init();
   load_css();
   //
   // Create top window with minimum size
@@ -1046,11 +1043,6 @@ int main(int argc, char **argv) {
   rc = g_application_run(G_APPLICATION(deskhpsdr), argc, argv);
   t_print("exiting ...\n");
   g_object_unref(deskhpsdr);
-#ifdef MIDI
-  g_mutex_clear(&vfo_timer.lock);
-  g_mutex_clear(&vfoa_timer.lock);
-  g_mutex_clear(&vfob_timer.lock);
-#endif
   return rc;
 }
 
@@ -34,86 +34,366 @@
  * Note ALL messages of the program should go through these two functions
  * so it is easy to either silence them completely, or routing them to
  * a separate window for debugging purposes.
+ *
+ * Threads that have called log_thread_async() (the time-critical threads
+ * registered with a thread role) do not print themselves. Each of them has
+ * its own single-producer ring (claimed on the first message, released when
+ * the thread ends), and the "log writer" thread drains all rings in time
+ * stamp order and does the g_print(). Formatting the message is the only
+ * work done by such a caller, so a burst of messages from a protocol thread
+ * cannot block on a slow terminal or pipe. If a ring is full, messages are
+ * dropped and counted. The writer sleeps on a condition variable while all
+ * rings are empty; the first message queued after that wakes it up.
+ *
+ * All other threads (GTK, discovery, menus, ...) print synchronously, after
+ * the queued messages, such that nothing is lost during bursts at start-up
+ * or from menu dumps.
+ *
+ * Additionally, each call site (source file and line, passed in by the
+ * macros in message.h) may queue at most LOG_RATE_BURST messages per second
+ * from the time-critical threads. The writer reports the number of
+ * suppressed messages once per second. Synchronous messages are never
+ * suppressed.
+ *
+ * log_flush() prints everything queued so far, it is called at exit.
  */
 
 #include <gdk/gdk.h>
 #include <glib.h>
 #include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <errno.h>
+#include <math.h>
 #include <time.h>
 #include <stdio.h>
+#include <string.h>
+
+#include "message.h"
+
+#define LOG_LINE_MAX     1024
+#define LOG_RING_SLOTS   256      // messages per thread ring
+#define LOG_MAX_RINGS    64       // threads with a ring at the same time
+#define LOG_SITES        256      // rate limiter table size
+#define LOG_RATE_BURST   50       // messages per call site and second
+
+enum {
+  LOG_RING_FREE = 0,
+  LOG_RING_CLAIMED,
+  LOG_RING_ACTIVE,
+  LOG_RING_ORPHAN               // owning thread has terminated
+};
+
+typedef struct {
+  double t;
+  char text[LOG_LINE_MAX];
+} LOG_SLOT;
 
-static GMutex t_print_mutex;  // globaler Mutex
+typedef struct {
+  atomic_uint head;             // advanced by the owning thread
+  atomic_uint tail;             // advanced by the writer
+  atomic_uint dropped;
+  LOG_SLOT slot[LOG_RING_SLOTS];
+} LOG_RING;
+
+//
+// A call site is identified by (file name address << 16) | line.
+//
+typedef struct {
+  _Atomic uint64_t site;
+  atomic_long window;           // second of the current rate window
+  atomic_uint count;
+  atomic_uint suppressed;
+} LOG_SITE;
+
+static GMutex log_drain_mutex;  // serializes the consumers and synchronous printing
+static GMutex log_wake_mutex;   // protects the writer going to sleep
+static GCond log_wake_cond;
+static atomic_int log_wake_pending;
+static atomic_int ring_state[LOG_MAX_RINGS];
+static LOG_RING *rings[LOG_MAX_RINGS];
+static LOG_SITE sites[LOG_SITES];
+static double starttime;
+
+static void log_ring_release(gpointer data);
+static GPrivate log_ring_key = G_PRIVATE_INIT(log_ring_release);
+static GPrivate log_async_key;
 
 extern int log_debug;
 extern int ui_debug;
 
-static void v_t_print(const gchar *format, va_list args) {
+static double log_now(void) {
   struct timespec ts;
-  double now;
-  static double starttime;
-  static int first = 1;
-  char line[1024];
-  char time_str[16];
   clock_gettime(CLOCK_MONOTONIC, &ts);
-  now = ts.tv_sec + 1E-9 * ts.tv_nsec;
-  g_mutex_lock(&t_print_mutex);
-  if (first) {
-    first = 0;
-    starttime = now;
-  }
+  return ts.tv_sec + 1E-9 * ts.tv_nsec;
+}
+
+static void log_print_line(double t, const char *line) {
+  char time_str[16];
   //
   // After 11 days, the time reaches 999999.999 so we simply wrap around
   //
-  if (now - starttime >= 999999.995) {
-    starttime += 1000000.0;
-  }
-  g_mutex_unlock(&t_print_mutex);
+  double elapsed_time = fmod(t - starttime, 1000000.0);
   //
   // Berechnung von hh:mm:ss.mmm (Millisekunden)
   //
-  double elapsed_time = now - starttime;
   int hours = (int)(elapsed_time / 3600);
   int minutes = (int)((elapsed_time - (hours * 3600)) / 60);
   double seconds = elapsed_time - (hours * 3600) - (minutes * 60);
   int millisec = (int)((seconds - (int) seconds) * 1000);   // Millisekunden
   // Formatierte Zeit in den String schreiben
   snprintf(time_str, sizeof(time_str), "%02d:%02d:%02d.%03d", hours, minutes, (int) seconds, millisec);
-  //
-  // Wir nutzen vsnprintf, um die varargs zu verarbeiten
-  // g_print() wird einmalig aufgerufen, um Thread-Sicherheit zu gewährleisten
-  //
-  vsnprintf(line, sizeof(line), format, args);
   g_print("%s %s", time_str, line);
 }
 
-void t_print(const gchar *format, ...) {
+//
+// Consumer side, called with log_drain_mutex held.
+// Prints all queued messages in time stamp order, returns the number printed.
+//
+static int log_drain_locked(void) {
+  int printed = 0;
+  char note[64];
+  for (;;) {
+    LOG_RING *best = NULL;
+    double best_t = 0.0;
+    for (int i = 0; i < LOG_MAX_RINGS; i++) {
+      int state = atomic_load_explicit(&ring_state[i], memory_order_acquire);
+      if (state != LOG_RING_ACTIVE && state != LOG_RING_ORPHAN) {
+        continue;
+      }
+      LOG_RING *r = rings[i];
+      unsigned int dropped = atomic_exchange(&r->dropped, 0);
+      if (dropped > 0) {
+        snprintf(note, sizeof(note), "*** %u log messages dropped ***\n", dropped);
+        log_print_line(log_now(), note);
+        printed++;
+      }
+      unsigned int tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+      if (atomic_load_explicit(&r->head, memory_order_acquire) == tail) {
+        if (state == LOG_RING_ORPHAN) {
+          atomic_store(&r->head, 0);
+          atomic_store(&r->tail, 0);
+          atomic_store_explicit(&ring_state[i], LOG_RING_FREE, memory_order_release);
+        }
+        continue;
+      }
+      const LOG_SLOT *slot = &r->slot[tail % LOG_RING_SLOTS];
+      if (best == NULL || slot->t < best_t) {
+        best = r;
+        best_t = slot->t;
+      }
+    }
+    if (best == NULL) {
+      break;
+    }
+    unsigned int tail = atomic_load_explicit(&best->tail, memory_order_relaxed);
+    const LOG_SLOT *slot = &best->slot[tail % LOG_RING_SLOTS];
+    log_print_line(slot->t, slot->text);
+    atomic_store_explicit(&best->tail, tail + 1, memory_order_release);
+    printed++;
+  }
+  return printed;
+}
+
+//
+// Report call sites whose messages have been rate limited in a past window
+//
+static void log_report_suppressed_locked(double now) {
+  long window = (long) now;
+  char note[128];
+  for (int i = 0; i < LOG_SITES; i++) {
+    LOG_SITE *s = &sites[i];
+    uint64_t site = atomic_load(&s->site);
+    if (site == 0 || atomic_load(&s->window) == window || atomic_load(&s->suppressed) == 0) {
+      continue;
+    }
+    unsigned int n = atomic_exchange(&s->suppressed, 0);
+    snprintf(note, sizeof(note), "*** %u messages suppressed from %s:%d\n", n,
+             (const char *)(uintptr_t)(site >> 16), (int)(site & 0xFFFF));
+    log_print_line(now, note);
+  }
+}
+
+//
+// Called by a producer after queuing a message. Only the first message
+// after the writer went to sleep takes the mutex and signals.
+//
+static void log_wake_writer(void) {
+  if (atomic_exchange(&log_wake_pending, 1) == 0) {
+    g_mutex_lock(&log_wake_mutex);
+    g_cond_signal(&log_wake_cond);
+    g_mutex_unlock(&log_wake_mutex);
+  }
+}
+
+static gpointer log_writer_thread(gpointer data) {
+  double last_report = 0.0;
+  for (;;) {
+    //
+    // Sleep until a message is queued, but wake up at least once per
+    // second to report suppressed messages
+    //
+    gint64 end_time = g_get_monotonic_time() + G_TIME_SPAN_SECOND;
+    g_mutex_lock(&log_wake_mutex);
+    while (atomic_exchange(&log_wake_pending, 0) == 0) {
+      if (!g_cond_wait_until(&log_wake_cond, &log_wake_mutex, end_time)) {
+        break;
+      }
+    }
+    g_mutex_unlock(&log_wake_mutex);
+    g_mutex_lock(&log_drain_mutex);
+    log_drain_locked();
+    double now = log_now();
+    if (now - last_report >= 1.0) {
+      log_report_suppressed_locked(now);
+      last_report = now;
+    }
+    g_mutex_unlock(&log_drain_mutex);
+  }
+  return NULL;
+}
+
+void log_flush(void) {
+  g_mutex_lock(&log_drain_mutex);
+  log_drain_locked();
+  log_report_suppressed_locked(log_now() + 1.0);
+  g_mutex_unlock(&log_drain_mutex);
+}
+
+static void log_init(void) {
+  static gsize initialized = 0;
+  if (g_once_init_enter(&initialized)) {
+    starttime = log_now();
+    atexit(log_flush);
+    g_thread_unref(g_thread_new("log writer", log_writer_thread, NULL));
+    g_once_init_leave(&initialized, 1);
+  }
+}
+
+static void log_ring_release(gpointer data) {
+  int i = GPOINTER_TO_INT(data) - 1;
+  atomic_store_explicit(&ring_state[i], LOG_RING_ORPHAN, memory_order_release);
+}
+
+void log_thread_async(void) {
+  g_private_set(&log_async_key, GINT_TO_POINTER(1));
+}
+
+static LOG_RING *log_ring_get(void) {
+  int i = GPOINTER_TO_INT(g_private_get(&log_ring_key)) - 1;
+  if (i >= 0) {
+    return rings[i];
+  }
+  for (i = 0; i < LOG_MAX_RINGS; i++) {
+    int expected = LOG_RING_FREE;
+    if (atomic_compare_exchange_strong(&ring_state[i], &expected, LOG_RING_CLAIMED)) {
+      if (rings[i] == NULL) {
+        rings[i] = g_new0(LOG_RING, 1);
+      }
+      atomic_store_explicit(&ring_state[i], LOG_RING_ACTIVE, memory_order_release);
+      g_private_set(&log_ring_key, GINT_TO_POINTER(i + 1));
+      return rings[i];
+    }
+  }
+  return NULL;
+}
+
+//
+// Per call site rate limit. Returns FALSE if the message is to be suppressed.
+// The counters are updated without a lock, so the limit is approximate.
+//
+static gboolean log_rate_ok(const char *file, int line, double now) {
+  uint64_t key = ((uint64_t)(uintptr_t) file << 16) | (uint64_t)(line & 0xFFFF);
+  LOG_SITE *s = NULL;
+  for (int probe = 0; probe < 8; probe++) {
+    LOG_SITE *p = &sites[((key >> 3) + (key * 0x9E3779B1u) + probe) % LOG_SITES];
+    uint64_t expected = 0;
+    if (atomic_load(&p->site) == key ||
+        atomic_compare_exchange_strong(&p->site, &expected, key)) {
+      s = p;
+      break;
+    }
+  }
+  if (s == NULL) {
+    // table full, do not limit
+    return TRUE;
+  }
+  long window = (long) now;
+  if (atomic_load(&s->window) != window) {
+    atomic_store(&s->window, window);
+    atomic_store(&s->count, 0);
+  }
+  if (atomic_fetch_add(&s->count, 1) >= LOG_RATE_BURST) {
+    atomic_fetch_add(&s->suppressed, 1);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+static void v_t_print(const char *file, int line, const gchar *format, va_list args) {
+  double now;
+  LOG_RING *r = NULL;
+  log_init();
+  now = log_now();
+  if (g_private_get(&log_async_key) != NULL) {
+    r = log_ring_get();
+  }
+  if (r == NULL) {
+    //
+    // Not a time-critical thread (or no ring available): print the queued
+    // messages, then this one.
+    //
+    char text[LOG_LINE_MAX];
+    vsnprintf(text, sizeof(text), format, args);
+    g_mutex_lock(&log_drain_mutex);
+    log_drain_locked();
+    log_print_line(now, text);
+    g_mutex_unlock(&log_drain_mutex);
+    return;
+  }
+  if (!log_rate_ok(file, line, now)) {
+    return;
+  }
+  unsigned int head = atomic_load_explicit(&r->head, memory_order_relaxed);
+  if (head - atomic_load_explicit(&r->tail, memory_order_acquire) >= LOG_RING_SLOTS) {
+    atomic_fetch_add(&r->dropped, 1);
+    return;
+  }
+  LOG_SLOT *slot = &r->slot[head % LOG_RING_SLOTS];
+  slot->t = now;
+  vsnprintf(slot->text, sizeof(slot->text), format, args);
+  atomic_store_explicit(&r->head, head + 1, memory_order_release);
+  log_wake_writer();
+}
+
+void t_print_site(const char *file, int line, const gchar *format, ...) {
   va_list args;
   va_start(args, format);
-  v_t_print(format, args);
+  v_t_print(file, line, format, args);
   va_end(args);
 }
 
-void l_print(const gchar *format, ...) {
+void l_print_site(const char *file, int line, const gchar *format, ...) {
   if (!log_debug) {
     return;
   }
   va_list args;
   va_start(args, format);
-  v_t_print(format, args);
+  v_t_print(file, line, format, args);
   va_end(args);
 }
 
-void ui_print(const gchar *format, ...) {
+void ui_print_site(const char *file, int line, const gchar *format, ...) {
   if (!ui_debug) {
     return;
   }
   va_list args;
   va_start(args, format);
-  v_t_print(format, args);
+  v_t_print(file, line, format, args);
   va_end(args);
 }
 
-void t_perror(const gchar *string) {
-  t_print("%s: %s\n", string, strerror(errno));
+void t_perror_site(const char *file, int line, const gchar *string) {
+  t_print_site(file, line, "%s: %s\n", string, strerror(errno));
 }
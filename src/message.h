@@ -25,7 +25,17 @@
 
 #include <gdk/gdk.h>
 
-extern void t_print(const gchar *format, ...);
-extern void l_print(const gchar *format, ...);
-extern void ui_print(const gchar *format, ...);
-extern void t_perror(const gchar *string);
+extern void t_print_site(const char *file, int line, const gchar *format, ...);
+extern void l_print_site(const char *file, int line, const gchar *format, ...);
+extern void ui_print_site(const char *file, int line, const gchar *format, ...);
+extern void t_perror_site(const char *file, int line, const gchar *string);
+extern void log_thread_async(void);
+extern void log_flush(void);
+
+//
+// The call site is passed on for the per-site rate limit
+//
+#define t_print(...)  t_print_site(__FILE__, __LINE__, __VA_ARGS__)
+#define l_print(...)  l_print_site(__FILE__, __LINE__, __VA_ARGS__)
+#define ui_print(...) ui_print_site(__FILE__, __LINE__, __VA_ARGS__)
+#define t_perror(s)   t_perror_site(__FILE__, __LINE__, (s))
@@ -35,21 +35,7 @@
 #include "message.h"
 #include "rigctl.h"
 #include "midi_layer.h"
-
-VFO_TIMER vfo_timer  = { VFO,  0, 0, {0} };
-VFO_TIMER vfoa_timer = { VFOA, 0, 0, {0} };
-VFO_TIMER vfob_timer = { VFOB, 0, 0, {0} };
-
-static int vfo_timeout_cb(gpointer data) {
-  VFO_TIMER *timer = (VFO_TIMER *) data;
-  g_mutex_lock(&timer->lock);
-  t_print("%s: action=%d val=%d\n", __func__, timer->action, timer->val);
-  schedule_action(timer->action, RELATIVE, timer->val);
-  timer->timeout = 0;
-  timer->val = 0;
-  g_mutex_unlock(&timer->lock);
-  return FALSE;
-}
+#include "vfo_tuner.h"
 
 void DoTheMidi(int action, enum ACTIONtype type, int val) {
   switch (type) {
@@ -64,35 +50,19 @@ void DoTheMidi(int action, enum ACTIONtype type, int val) {
   case MIDI_WHEEL:
     //
     // There are "big wheels" at various MIDI consoles that can produce MIDI events
-    // with rather high frequency, and these are usually used for VFO, VFOA, VFOB
-    // Therefore, these events are filtererd out here in a way that several such events
-    // lead to a single scheduled action with a "consolidated" value. The idea is, that
-    // turning the VFO knob fast will only generate one VFO update every 100 msec.
+    // with rather high frequency, and these are usually used for VFO, VFOA, VFOB.
+    // These events go to the VFO tuner which applies them once per display frame,
+    // with an acceleration depending on how fast the wheel is turned.
     //
     switch (action) {
     case VFOA:
-      g_mutex_lock(&vfoa_timer.lock);
-      vfoa_timer.val += val;
-      if (vfoa_timer.timeout == 0) {
-        vfoa_timer.timeout = g_timeout_add(100, vfo_timeout_cb, &vfoa_timer);
-      }
-      g_mutex_unlock(&vfoa_timer.lock);
+      vfo_tuner_input(VFO_TUNER_A, val);
       break;
     case VFOB:
-      g_mutex_lock(&vfob_timer.lock);
-      vfob_timer.val += val;
-      if (vfob_timer.timeout == 0) {
-        vfob_timer.timeout = g_timeout_add(100, vfo_timeout_cb, &vfob_timer);
-      }
-      g_mutex_unlock(&vfob_timer.lock);
+      vfo_tuner_input(VFO_TUNER_B, val);
       break;
     case VFO:
-      g_mutex_lock(&vfo_timer.lock);
-      vfo_timer.val += val;
-      if (vfo_timer.timeout == 0) {
-        vfo_timer.timeout = g_timeout_add(100, vfo_timeout_cb, &vfo_timer);
-      }
-      g_mutex_unlock(&vfo_timer.lock);
+      vfo_tuner_input(VFO_TUNER_ACTIVE, val);
       break;
     default:
       if (rigctl_debug) { t_print("%s: action=%d val=%d\n", __func__, action, val); }
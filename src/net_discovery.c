@@ -0,0 +1,405 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Network discovery of P1 and P2 radios.
+ *
+ * One UDP socket is opened per network interface (or one for the
+ * configured radio address), and the P1 and P2 discovery packets are sent
+ * on all of them before any reply is awaited. The replies are then collected
+ * from all sockets in a single poll() loop and each device found is shown
+ * in the status line immediately. The loop ends when the protocol time-outs
+ * expired, or NET_DISCOVERY_QUIET_MS after the last reply.
+ *
+ * The address of the last radio started is kept in the file last_radio.addr.
+ * net_discovery_last_radio() probes only this address and returns as soon
+ * as the radio answered, such that it can be started without a full
+ * discovery.
+ */
+
+#include <gtk/gtk.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "discovered.h"
+#include "discovery.h"
+#include "main.h"
+#include "message.h"
+#include "net_discovery.h"
+#include "new_discovery.h"
+#include "old_discovery.h"
+
+#define NET_DISCOVERY_MAX_SOCKETS 32
+#define LAST_RADIO_FILE "last_radio.addr"
+
+typedef struct {
+  int fd;
+  int p1;                        // P1 probe sent on this socket
+  int p2;                        // P2 probe sent on this socket
+  int targeted;                  // unicast to a configured address
+  struct sockaddr_in to;
+  struct sockaddr_in if_addr;
+  struct sockaddr_in if_mask;
+  char if_name[64];
+} NET_PROBE;
+
+static int probe_open(NET_PROBE *p) {
+  int optval = 1;
+  p->fd = socket(PF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (p->fd < 0) {
+    t_perror("net_discovery: create socket failed");
+    return -1;
+  }
+  setsockopt(p->fd, SOL_SOCKET, SO_REUSEADDR, &optval, sizeof(optval));
+  setsockopt(p->fd, SOL_SOCKET, SO_REUSEPORT, &optval, sizeof(optval));
+  p->if_addr.sin_family = AF_INET;
+  p->if_addr.sin_port = htons(0);  // system assigned port
+  if (bind(p->fd, (struct sockaddr *) &p->if_addr, sizeof(p->if_addr)) < 0) {
+    t_perror("net_discovery: bind socket failed");
+    close(p->fd);
+    p->fd = -1;
+    return -1;
+  }
+  if (!p->targeted && setsockopt(p->fd, SOL_SOCKET, SO_BROADCAST, &optval, sizeof(optval)) != 0) {
+    t_perror("net_discovery: cannot set SO_BROADCAST");
+    close(p->fd);
+    p->fd = -1;
+    return -1;
+  }
+  fcntl(p->fd, F_SETFL, fcntl(p->fd, F_GETFL, 0) | O_NONBLOCK);
+  t_print("%s: %s address %s P1=%d P2=%d\n", __func__, p->if_name, inet_ntoa(p->if_addr.sin_addr), p->p1, p->p2);
+  return 0;
+}
+
+//
+// A P1 radio may still be streaming if a previous client terminated without
+// sending the METIS STOP command. Stop such a stream before discovery so
+// stream packets do not flood the discovery sockets.
+//
+static void probe_send_stop(const NET_PROBE *p) {
+  unsigned char buffer[64];
+  if (!p->p1) {
+    return;
+  }
+  memset(buffer, 0, sizeof(buffer));
+  buffer[0] = 0xEF;
+  buffer[1] = 0xFE;
+  buffer[2] = 0x04;
+  if (sendto(p->fd, buffer, 64, 0, (const struct sockaddr *) &p->to, sizeof(p->to)) < 0) {
+    t_perror("net_discovery: sendto failed for METIS STOP");
+  }
+}
+
+static void probe_send(const NET_PROBE *p) {
+  unsigned char buffer[64];
+  if (p->p1) {
+    memset(buffer, 0, sizeof(buffer));
+    buffer[0] = 0xEF;
+    buffer[1] = 0xFE;
+    buffer[2] = 0x02;
+    if (sendto(p->fd, buffer, 63, 0, (const struct sockaddr *) &p->to, sizeof(p->to)) < 0) {
+      t_perror("net_discovery: sendto failed for P1 discovery");
+    }
+  }
+  if (p->p2) {
+    memset(buffer, 0, sizeof(buffer));
+    buffer[4] = 0x02;
+    if (sendto(p->fd, buffer, 60, 0, (const struct sockaddr *) &p->to, sizeof(p->to)) < 0) {
+      t_perror("net_discovery: sendto failed for P2 discovery");
+    }
+  }
+}
+
+//
+// Read all pending replies from one socket. Returns the number of devices added.
+//
+static int probe_receive(const NET_PROBE *p, int p1_open, int p2_open) {
+  unsigned char buffer[2048];
+  struct sockaddr_in addr;
+  socklen_t len;
+  int found = 0;
+  for (;;) {
+    int added = 0;
+    len = sizeof(addr);
+    int bytes_read = recvfrom(p->fd, buffer, sizeof(buffer), 0, (struct sockaddr *) &addr, &len);
+    if (bytes_read < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        t_perror("net_discovery: recvfrom failed");
+      }
+      break;
+    }
+    if (bytes_read < 24 || bytes_read == 1444) {
+      // stream data from a radio that is (still) running
+      continue;
+    }
+    if (p->p1 && p1_open && buffer[0] == 0xEF && buffer[1] == 0xFE) {
+      added = old_discovery_add(buffer, &addr, &p->if_addr, &p->if_mask, p->if_name);
+    } else if (p->p2 && p2_open && buffer[0] == 0 && buffer[1] == 0 && buffer[2] == 0 && buffer[3] == 0) {
+      added = new_discovery_add(buffer, &addr, &p->if_addr, &p->if_mask, p->if_name);
+    }
+    if (added) {
+      DISCOVERED *d = &discovered[devices - 1];
+      char text[128];
+      if (p->targeted) {
+        //
+        // Reply to a packet sent to a fixed address: use this address,
+        // and note whether the radio is reached via a router.
+        //
+        memcpy(&d->info.network.address, &p->to, sizeof(p->to));
+        d->info.network.address_length = sizeof(p->to);
+        d->use_routing = ((p->to.sin_addr.s_addr & p->if_mask.sin_addr.s_addr) !=
+                          (p->if_addr.sin_addr.s_addr & p->if_mask.sin_addr.s_addr));
+      }
+      snprintf(text, sizeof(text), "Found %s (%s) at %s on %s", d->name,
+               d->protocol == ORIGINAL_PROTOCOL ? "Protocol 1" : "Protocol 2",
+               inet_ntoa(d->info.network.address.sin_addr), p->if_name);
+      status_text(text);
+      found++;
+    }
+  }
+  return found;
+}
+
+//
+// Send the probes on all sockets and collect the replies until the time-outs
+// have expired or the network has been quiet for quiet_ms after the last reply.
+// If first is set, return as soon as one device has answered.
+//
+static void probe_run(NET_PROBE *probes, int n, int p1_ms, int p2_ms, int quiet_ms, int first) {
+  struct pollfd pfd[NET_DISCOVERY_MAX_SOCKETS];
+  int any_p1 = 0;
+  int found = 0;
+  gint64 start, p1_end, p2_end, end;
+  gint64 last_found = 0;
+  for (int i = 0; i < n; i++) {
+    any_p1 |= probes[i].p1;
+    probe_send_stop(&probes[i]);
+    pfd[i].fd = probes[i].fd;
+    pfd[i].events = POLLIN;
+  }
+  if (any_p1) {
+    g_usleep(20000);
+  }
+  for (int i = 0; i < n; i++) {
+    probe_send(&probes[i]);
+  }
+  start = g_get_monotonic_time();
+  p1_end = start + 1000LL * p1_ms;
+  p2_end = start + 1000LL * p2_ms;
+  end = start;
+  for (int i = 0; i < n; i++) {
+    if (probes[i].p1 && p1_end > end) { end = p1_end; }
+    if (probes[i].p2 && p2_end > end) { end = p2_end; }
+  }
+  for (;;) {
+    gint64 now = g_get_monotonic_time();
+    if (now >= end || (found > 0 && (first || now - last_found >= 1000LL * quiet_ms))) {
+      break;
+    }
+    int rc = poll(pfd, n, 50);
+    if (rc < 0 && errno != EINTR) {
+      t_perror("net_discovery: poll failed");
+      break;
+    }
+    now = g_get_monotonic_time();
+    for (int i = 0; rc > 0 && i < n; i++) {
+      if (pfd[i].revents & POLLIN) {
+        int k = probe_receive(&probes[i], now < p1_end, now < p2_end);
+        if (k > 0) {
+          found += k;
+          last_found = now;
+        }
+      }
+    }
+    // keep the status line updated
+    g_main_context_iteration(NULL, FALSE);
+  }
+  t_print("%s: %d devices after %lld ms\n", __func__, found, (long long)((g_get_monotonic_time() - start) / 1000));
+}
+
+static void probe_close(NET_PROBE *probes, int n) {
+  for (int i = 0; i < n; i++) {
+    if (probes[i].fd >= 0) {
+      close(probes[i].fd);
+    }
+  }
+}
+
+//
+// Prepare a socket for the radio at host:port. Returns 0 on success.
+//
+static int probe_open_target(NET_PROBE *p, const char *host, int port, int p1, int p2) {
+  int is_direct;
+  memset(p, 0, sizeof(*p));
+  p->fd = -1;
+  if (discovery_resolve_target(host, &p->to, &p->if_addr, &p->if_mask, p->if_name,
+                               sizeof(p->if_name), &is_direct) != 0) {
+    return -1;
+  }
+  p->to.sin_port = htons(port);
+  p->targeted = 1;
+  p->p1 = p1;
+  p->p2 = p2;
+  t_print("%s: looking for HPSDR device at %s via %s (%s)\n", __func__, host, p->if_name,
+          is_direct ? "direct" : "routed");
+  return probe_open(p);
+}
+
+void net_discovery(int p1, int p2) {
+  NET_PROBE probes[NET_DISCOVERY_MAX_SOCKETS];
+  struct ifaddrs *addrs, *ifa;
+  int n = 0;
+  if (!p1 && !p2) {
+    return;
+  }
+  if (ipaddr_radio[0] != '\0') {
+    //
+    // A configured radio address selects targeted discovery,
+    // no broadcast is sent in this case.
+    //
+    if (probe_open_target(&probes[0], ipaddr_radio, radio_port, p1, p2) == 0) {
+      n = 1;
+    }
+  } else {
+    if (getifaddrs(&addrs) != 0) {
+      t_perror("net_discovery: getifaddrs failed");
+      return;
+    }
+    for (ifa = addrs; ifa != NULL && n < NET_DISCOVERY_MAX_SOCKETS; ifa = ifa->ifa_next) {
+      NET_PROBE *p = &probes[n];
+      int loopback;
+      //
+      // Sometimes there are many (virtual) interfaces, and some
+      // of them are very unlikely to offer a radio connection.
+      // These are skipped. Loopback interfaces are only probed
+      // with P1 (e.g. the RadioBerry driver), and not on MacOS.
+      //
+      if (ifa->ifa_addr == NULL || ifa->ifa_netmask == NULL || ifa->ifa_addr->sa_family != AF_INET
+          || (ifa->ifa_flags & IFF_UP) != IFF_UP
+          || (ifa->ifa_flags & IFF_RUNNING) != IFF_RUNNING
+          || !strncmp("veth", ifa->ifa_name, 4)
+          || !strncmp("dock", ifa->ifa_name, 4)
+          || !strncmp("hass", ifa->ifa_name, 4)) {
+        continue;
+      }
+      loopback = (ifa->ifa_flags & IFF_LOOPBACK) == IFF_LOOPBACK;
+      memset(p, 0, sizeof(*p));
+      p->fd = -1;
+#ifdef __APPLE__
+      p->p1 = p1 && !loopback;
+#else
+      p->p1 = p1;
+#endif
+      p->p2 = p2 && !loopback;
+      if (!p->p1 && !p->p2) {
+        continue;
+      }
+      memcpy(&p->if_addr, ifa->ifa_addr, sizeof(p->if_addr));
+      memcpy(&p->if_mask, ifa->ifa_netmask, sizeof(p->if_mask));
+      g_strlcpy(p->if_name, ifa->ifa_name, sizeof(p->if_name));
+      p->to.sin_family = AF_INET;
+      p->to.sin_port = htons(radio_port);
+      p->to.sin_addr.s_addr = htonl(INADDR_BROADCAST);
+      if (probe_open(p) == 0) {
+        n++;
+      }
+    }
+    freeifaddrs(addrs);
+  }
+  if (n > 0) {
+    probe_run(probes, n, NET_DISCOVERY_P1_WAIT_MS, NET_DISCOVERY_P2_WAIT_MS, NET_DISCOVERY_QUIET_MS, 0);
+    probe_close(probes, n);
+  }
+  t_print("%s: found %d devices\n", __func__, devices);
+  for (int i = 0; i < devices; i++) {
+    print_device(i);
+  }
+}
+
+//
+// Fast reconnect: probe the address of the radio used last time.
+// Returns 1 if this radio answered; it is then the last entry in discovered[].
+//
+int net_discovery_last_radio(int p1, int p2) {
+  NET_PROBE probe;
+  char ip[64], mac[18], found_mac[18];
+  int proto, port;
+  int before = devices;
+  FILE *fp = fopen(LAST_RADIO_FILE, "r");
+  if (fp == NULL) {
+    return 0;
+  }
+  if (fscanf(fp, "%d %63s %d %17s", &proto, ip, &port, mac) != 4) {
+    fclose(fp);
+    return 0;
+  }
+  fclose(fp);
+  if ((proto == ORIGINAL_PROTOCOL && !p1) || (proto == NEW_PROTOCOL && !p2)) {
+    return 0;
+  }
+  if (proto != ORIGINAL_PROTOCOL && proto != NEW_PROTOCOL) {
+    return 0;
+  }
+  if (probe_open_target(&probe, ip, port, proto == ORIGINAL_PROTOCOL, proto == NEW_PROTOCOL) != 0) {
+    return 0;
+  }
+  probe_run(&probe, 1, NET_DISCOVERY_FAST_MS, NET_DISCOVERY_FAST_MS, 0, 1);
+  probe_close(&probe, 1);
+  if (devices == before) {
+    t_print("%s: no answer from %s\n", __func__, ip);
+    return 0;
+  }
+  const unsigned char *m = discovered[devices - 1].info.network.mac_address;
+  snprintf(found_mac, sizeof(found_mac), "%02X:%02X:%02X:%02X:%02X:%02X", m[0], m[1], m[2], m[3], m[4], m[5]);
+  if (strcmp(found_mac, mac) != 0) {
+    // another radio now lives at this address
+    t_print("%s: %s answered with MAC %s, expected %s\n", __func__, ip, found_mac, mac);
+    devices = before;
+    return 0;
+  }
+  return 1;
+}
+
+//
+// Remember a network radio for the fast reconnect
+//
+void net_discovery_remember(const DISCOVERED *d) {
+  const unsigned char *m = d->info.network.mac_address;
+  if ((d->protocol != ORIGINAL_PROTOCOL && d->protocol != NEW_PROTOCOL) || d->use_tcp
+      || d->device == DEVICE_OZY || d->info.network.address_length == 0
+      || !strcmp(d->info.network.interface_name, "XDMA")) {
+    return;
+  }
+  FILE *fp = fopen(LAST_RADIO_FILE, "w");
+  if (fp == NULL) {
+    return;
+  }
+  fprintf(fp, "%d %s %d %02X:%02X:%02X:%02X:%02X:%02X\n", d->protocol,
+          inet_ntoa(d->info.network.address.sin_addr), ntohs(d->info.network.address.sin_port),
+          m[0], m[1], m[2], m[3], m[4], m[5]);
+  fclose(fp);
+}
@@ -0,0 +1,41 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef _NET_DISCOVERY_H
+#define _NET_DISCOVERY_H
+
+#include "discovered.h"
+
+//
+// Max. time (ms) the discovery waits for P1/P2 replies, and the time
+// after the last reply after which it is considered complete
+//
+#define NET_DISCOVERY_P1_WAIT_MS 5000
+#define NET_DISCOVERY_P2_WAIT_MS 2000
+#define NET_DISCOVERY_QUIET_MS    750
+
+//
+// Max. time (ms) the fast reconnect waits for the last used radio
+//
+#define NET_DISCOVERY_FAST_MS     400
+
+extern void net_discovery(int p1, int p2);
+extern int net_discovery_last_radio(int p1, int p2);
+extern void net_discovery_remember(const DISCOVERED *d);
+
+#endif
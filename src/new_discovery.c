@@ -259,13 +259,132 @@ static void new_discover(struct ifaddrs* iface, int discflag) {
   }
 }
 
+//
+// Evaluate a P2 discovery reply received via the interface if_addr/if_mask/if_name
+// and append it to the list of discovered devices. Returns 1 if a device has been added.
+//
+int new_discovery_add(const unsigned char *buffer, const struct sockaddr_in *addr,
+                      const struct sockaddr_in *if_addr, const struct sockaddr_in *if_mask,
+                      const char *if_name) {
+  int i;
+  double frequency_min, frequency_max;
+  int status = buffer[4] & 0xFF;
+  if ((status != 2 && status != 3) || devices >= MAX_DEVICES) {
+    return 0;
+  }
+  discovered[devices].protocol = NEW_PROTOCOL;
+  discovered[devices].device = buffer[11] & 0xFF;
+  discovered[devices].software_version = buffer[13] & 0xFF;
+  discovered[devices].status = status;
+  //
+  // The NEW_DEVICE_XXXX numbers are just 1000+board_id
+  //
+  discovered[devices].device += 1000;
+  switch (discovered[devices].device) {
+  case NEW_DEVICE_ATLAS:
+    g_strlcpy(discovered[devices].name, "Atlas", sizeof(discovered[devices].name));
+    frequency_min = 0.0;
+    frequency_max = 61440000.0;
+    break;
+  case NEW_DEVICE_HERMES:
+    g_strlcpy(discovered[devices].name, "Hermes", sizeof(discovered[devices].name));
+    frequency_min = 0.0;
+    frequency_max = 61440000.0;
+    break;
+  case NEW_DEVICE_HERMES2:
+    g_strlcpy(discovered[devices].name, "Hermes2", sizeof(discovered[devices].name));
+    frequency_min = 0.0;
+    frequency_max = 61440000.0;
+    break;
+  case NEW_DEVICE_ANGELIA:
+    g_strlcpy(discovered[devices].name, "Angelia", sizeof(discovered[devices].name));
+    frequency_min = 0.0;
+    frequency_max = 61440000.0;
+    break;
+  case NEW_DEVICE_ORION:
+    g_strlcpy(discovered[devices].name, "Orion", sizeof(discovered[devices].name));
+    frequency_min = 0.0;
+    frequency_max = 61440000.0;
+    break;
+  case NEW_DEVICE_ORION2:
+    g_strlcpy(discovered[devices].name, "Orion2", sizeof(discovered[devices].name));
+    frequency_min = 0.0;
+    frequency_max = 61440000.0;
+    break;
+  case NEW_DEVICE_SATURN:
+    g_strlcpy(discovered[devices].name, "Saturn/G2", sizeof(discovered[devices].name));
+    frequency_min = 0.0;
+    frequency_max = 61440000.0;
+    break;
+  case NEW_DEVICE_HERMES_LITE:
+    if (discovered[devices].software_version < 40) {
+      g_strlcpy(discovered[devices].name, "Hermes Lite V1", sizeof(discovered[devices].name));
+    } else {
+      g_strlcpy(discovered[devices].name, "Hermes Lite V2", sizeof(discovered[devices].name));
+      discovered[devices].device = NEW_DEVICE_HERMES_LITE2;
+    }
+    frequency_min = 0.0;
+    frequency_max = 30720000.0;
+    break;
+  default:
+    g_strlcpy(discovered[devices].name, "Unknown", sizeof(discovered[devices].name));
+    frequency_min = 0.0;
+    frequency_max = 30720000.0;
+    break;
+  }
+  for (i = 0; i < 6; i++) {
+    discovered[devices].info.network.mac_address[i] = buffer[i + 5];
+  }
+  memcpy((void *) &discovered[devices].info.network.address, (void *) addr, sizeof(*addr));
+  discovered[devices].info.network.address_length = sizeof(*addr);
+  memcpy((void *) &discovered[devices].info.network.interface_address, (void *) if_addr, sizeof(*if_addr));
+  memcpy((void *) &discovered[devices].info.network.interface_netmask, (void *) if_mask, sizeof(*if_mask));
+  discovered[devices].info.network.interface_length = sizeof(*if_addr);
+  g_strlcpy(discovered[devices].info.network.interface_name, if_name,
+            sizeof(discovered[devices].info.network.interface_name));
+  discovered[devices].supported_receivers = 2;
+  //
+  // Info not yet made use of:
+  //
+  // buffer[12]: P2 version supported (e.g. 39 for 3.9)
+  // buffer[20]: number of DDCs
+  // buffer[23]: beta version number (if nonzero)
+  //             E.g. if buffer[13] is 21 and buffer[23] is 18 this
+  //             means firmware Version 2.1.18
+  //
+  // We put the additional info to stderr at least since it might be
+  // useful for debugging/development but do not store it in the
+  // "discovered" data structure.
+  //
+  t_print("new_discover: P2(%d)  device=%d (%dRX) software_version=%d(.%d) status=%d address=%s (%02X:%02X:%02X:%02X:%02X:%02X) on %s\n",
+          buffer[12] & 0xFF,
+          discovered[devices].device - 1000,
+          buffer[20] & 0xFF,
+          discovered[devices].software_version,
+          buffer[23] & 0xFF,
+          discovered[devices].status,
+          inet_ntoa(discovered[devices].info.network.address.sin_addr),
+          discovered[devices].info.network.mac_address[0],
+          discovered[devices].info.network.mac_address[1],
+          discovered[devices].info.network.mac_address[2],
+          discovered[devices].info.network.mac_address[3],
+          discovered[devices].info.network.mac_address[4],
+          discovered[devices].info.network.mac_address[5],
+          discovered[devices].info.network.interface_name);
+  discovered[devices].frequency_min = frequency_min;
+  discovered[devices].frequency_max = frequency_max;
+  t_print("new_discover: frequency range min=%0.3f MHz max=%0.3f MHz\n",
+          discovered[devices].frequency_min * 1E-6,
+          discovered[devices].frequency_max * 1E-6);
+  devices++;
+  return 1;
+}
+
 gpointer new_discover_receive_thread(gpointer data) {
   struct sockaddr_in addr;
   socklen_t len;
   unsigned char buffer[2048];
   struct timeval tv;
-  int i;
-  double frequency_min, frequency_max;
   /*
    * Keep recvfrom() interruptible, but enforce discovery lifetime with an
    * absolute monotonic deadline. Continuous P2 stream traffic must never
@@ -294,118 +413,7 @@ gpointer new_discover_receive_thread(gpointer data) {
       continue; // no break if P1 devices were detetcted earlier => full P2 discovery run
     } else {
       if (buffer[0] == 0 && buffer[1] == 0 && buffer[2] == 0 && buffer[3] == 0) {
-        int status = buffer[4] & 0xFF;
-        if (status == 2 || status == 3) {
-          if (devices < MAX_DEVICES) {
-            discovered[devices].protocol = NEW_PROTOCOL;
-            discovered[devices].device = buffer[11] & 0xFF;
-            discovered[devices].software_version = buffer[13] & 0xFF;
-            discovered[devices].status = status;
-            //
-            // The NEW_DEVICE_XXXX numbers are just 1000+board_id
-            //
-            discovered[devices].device += 1000;
-            switch (discovered[devices].device) {
-            case NEW_DEVICE_ATLAS:
-              g_strlcpy(discovered[devices].name, "Atlas", sizeof(discovered[devices].name));
-              frequency_min = 0.0;
-              frequency_max = 61440000.0;
-              break;
-            case NEW_DEVICE_HERMES:
-              g_strlcpy(discovered[devices].name, "Hermes", sizeof(discovered[devices].name));
-              frequency_min = 0.0;
-              frequency_max = 61440000.0;
-              break;
-            case NEW_DEVICE_HERMES2:
-              g_strlcpy(discovered[devices].name, "Hermes2", sizeof(discovered[devices].name));
-              frequency_min = 0.0;
-              frequency_max = 61440000.0;
-              break;
-            case NEW_DEVICE_ANGELIA:
-              g_strlcpy(discovered[devices].name, "Angelia", sizeof(discovered[devices].name));
-              frequency_min = 0.0;
-              frequency_max = 61440000.0;
-              break;
-            case NEW_DEVICE_ORION:
-              g_strlcpy(discovered[devices].name, "Orion", sizeof(discovered[devices].name));
-              frequency_min = 0.0;
-              frequency_max = 61440000.0;
-              break;
-            case NEW_DEVICE_ORION2:
-              g_strlcpy(discovered[devices].name, "Orion2", sizeof(discovered[devices].name));
-              frequency_min = 0.0;
-              frequency_max = 61440000.0;
-              break;
-            case NEW_DEVICE_SATURN:
-              g_strlcpy(discovered[devices].name, "Saturn/G2", sizeof(discovered[devices].name));
-              frequency_min = 0.0;
-              frequency_max = 61440000.0;
-              break;
-            case NEW_DEVICE_HERMES_LITE:
-              if (discovered[devices].software_version < 40) {
-                g_strlcpy(discovered[devices].name, "Hermes Lite V1", sizeof(discovered[devices].name));
-              } else {
-                g_strlcpy(discovered[devices].name, "Hermes Lite V2", sizeof(discovered[devices].name));
-                discovered[devices].device = NEW_DEVICE_HERMES_LITE2;
-              }
-              frequency_min = 0.0;
-              frequency_max = 30720000.0;
-              break;
-            default:
-              g_strlcpy(discovered[devices].name, "Unknown", sizeof(discovered[devices].name));
-              frequency_min = 0.0;
-              frequency_max = 30720000.0;
-              break;
-            }
-            for (i = 0; i < 6; i++) {
-              discovered[devices].info.network.mac_address[i] = buffer[i + 5];
-            }
-            memcpy((void *) &discovered[devices].info.network.address, (void *) &addr, sizeof(addr));
-            discovered[devices].info.network.address_length = sizeof(addr);
-            memcpy((void *) &discovered[devices].info.network.interface_address, (void *) &interface_addr,
-                   sizeof(interface_addr));
-            memcpy((void *) &discovered[devices].info.network.interface_netmask, (void *) &interface_netmask,
-                   sizeof(interface_netmask));
-            discovered[devices].info.network.interface_length = sizeof(interface_addr);
-            g_strlcpy(discovered[devices].info.network.interface_name, interface_name,
-                      sizeof(discovered[devices].info.network.interface_name));
-            discovered[devices].supported_receivers = 2;
-            //
-            // Info not yet made use of:
-            //
-            // buffer[12]: P2 version supported (e.g. 39 for 3.9)
-            // buffer[20]: number of DDCs
-            // buffer[23]: beta version number (if nonzero)
-            //             E.g. if buffer[13] is 21 and buffer[23] is 18 this
-            //             means firmware Version 2.1.18
-            //
-            // We put the additional info to stderr at least since it might be
-            // useful for debugging/development but do not store it in the
-            // "discovered" data structure.
-            //
-            t_print("new_discover: P2(%d)  device=%d (%dRX) software_version=%d(.%d) status=%d address=%s (%02X:%02X:%02X:%02X:%02X:%02X) on %s\n",
-                    buffer[12] & 0xFF,
-                    discovered[devices].device - 1000,
-                    buffer[20] & 0xFF,
-                    discovered[devices].software_version,
-                    buffer[23] & 0xFF,
-                    discovered[devices].status,
-                    inet_ntoa(discovered[devices].info.network.address.sin_addr),
-                    discovered[devices].info.network.mac_address[0],
-                    discovered[devices].info.network.mac_address[1],
-                    discovered[devices].info.network.mac_address[2],
-                    discovered[devices].info.network.mac_address[3],
-                    discovered[devices].info.network.mac_address[4],
-                    discovered[devices].info.network.mac_address[5],
-                    discovered[devices].info.network.interface_name);
-            discovered[devices].frequency_min = frequency_min;
-            discovered[devices].frequency_max = frequency_max;
-            t_print("new_discover: frequency range min=%0.3f MHz max=%0.3f MHz\n",
-                    discovered[devices].frequency_min * 1E-6,
-                    discovered[devices].frequency_max * 1E-6);
-            devices++;
-          }
-        }
+        (void) new_discovery_add(buffer, &addr, &interface_addr, &interface_netmask, interface_name);
       }
     }
   }
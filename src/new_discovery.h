@@ -22,6 +22,12 @@
 #ifndef _NEW_DISCOVERY_H
 #define _NEW_DISCOVERY_H
 
+#include <netinet/in.h>
+
 void new_discovery(void);
+void print_device(int i);
+int new_discovery_add(const unsigned char *buffer, const struct sockaddr_in *addr,
+                      const struct sockaddr_in *if_addr, const struct sockaddr_in *if_mask,
+                      const char *if_name);
 
 #endif
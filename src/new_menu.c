@@ -58,6 +58,7 @@
 #include "main.h"
 #include "actions.h"
 #include "extras_menu.h"
+#include "thread_menu.h"
 #include "ddc_menu.h"
 #include "controller_mapping.h"
 #include "old_protocol.h"
@@ -251,6 +252,14 @@ static gboolean extras_cb(GtkWidget *widget, GdkEventButton *event, gpointer dat
   return TRUE;
 }
 
+static gboolean thread_cb(GtkWidget *widget, GdkEventButton *event, gpointer data) {
+  submenu_from_main_begin();
+  cleanup();
+  thread_menu(top_window);
+  submenu_from_main_end();
+  return TRUE;
+}
+
 static gboolean ddc_cb(GtkWidget *widget, GdkEventButton *event, gpointer data) {
   submenu_from_main_begin();
   cleanup();
@@ -749,7 +758,7 @@ void new_menu(void) {
     col++;
     //
     // Sixth column: Menus for controlling deskHPSDR
-    //               Toolbar, RigCtl, MIDI, Encoders, Switches
+    //               Toolbar, RigCtl, Threads, MIDI, Encoders, Switches
     //
     GtkWidget *toolbar_b = gtk_button_new_with_label("Toolbar");
     g_signal_connect(toolbar_b, "button-press-event", G_CALLBACK(toolbar_cb), NULL);
@@ -759,6 +768,12 @@ void new_menu(void) {
     g_signal_connect(rigctl_b, "button-press-event", G_CALLBACK(rigctl_cb), NULL);
     gtk_grid_attach(GTK_GRID(grid), rigctl_b, col, row, 1, 1);
     row++;
+    GtkWidget *thread_b = gtk_button_new_with_label("Threads");
+    gtk_widget_set_tooltip_text(thread_b, "CPU pinning and real-time scheduling\n"
+                                "of the time-critical threads");
+    g_signal_connect(thread_b, "button-press-event", G_CALLBACK(thread_cb), NULL);
+    gtk_grid_attach(GTK_GRID(grid), thread_b, col, row, 1, 1);
+    row++;
 #ifdef MIDI
     GtkWidget *midi_b = gtk_button_new_with_label("MIDI");
     g_signal_connect(midi_b, "button-press-event", G_CALLBACK(midi_cb), NULL);
@@ -49,10 +49,12 @@
 #include "audio.h"
 #include "band.h"
 #include "new_protocol.h"
+#include "old_protocol.h"
 #include "discovered.h"
 #include "mode.h"
 #include "filter.h"
 #include "radio.h"
+#include "iq_unpack.h"
 #include "receiver.h"
 #include "transmitter.h"
 #include "tx_off.h"
@@ -66,6 +68,7 @@
 #include "nw_toolset.h"
 #include "tci_audio.h"
 #include "ddc_menu.h"
+#include "thread_role.h"
 
 #ifdef SATURN
   #include "saturnmain.h"
@@ -592,27 +595,134 @@ static mybuffer *get_my_buffer(void) {
   return bp;
 }
 
+//
+// HighPrio sender thread.
+//
+// schedule_high_priority() is called for every frequency change, and fast
+// encoder or TCI tuning produces hundreds of these per second. Instead of
+// building and sending a packet for each, the request is handed to the
+// "P2 HP send" thread which sends at most one packet per p2_hp_window_us
+// carrying the latest state. The first request after an idle period, and
+// any request that comes with a changed RX/TX state (MOX, PTT, TUNE), is
+// sent without delay.
+//
+int p2_hp_window_us = 1500;
+
+static GMutex hp_send_mutex;
+static GCond hp_send_cond;
+static GThread *hp_send_thread_id = NULL;
+static int hp_send_running = 0;
+static int hp_send_pending = 0;
+static int hp_sent_xmit = -1;               // xmit state of the last packet built
+static unsigned long hp_send_requests = 0;
+static unsigned long hp_send_packets = 0;
+
+static gpointer hp_send_thread(gpointer data) {
+  thread_role_enter(THREAD_ROLE_RADIO_TX, "P2 HP send");
+  gint64 last_sent = 0;
+  g_mutex_lock(&hp_send_mutex);
+  while (hp_send_running) {
+    if (!hp_send_pending) {
+      g_cond_wait(&hp_send_cond, &hp_send_mutex);
+      continue;
+    }
+    gint64 due = last_sent + g_atomic_int_get(&p2_hp_window_us);
+    int xmit = radio_is_transmitting() | radio_ptt;
+    if (xmit == g_atomic_int_get(&hp_sent_xmit) && g_get_monotonic_time() < due) {
+      //
+      // Within the window: wait for its end, or for a new request
+      // which might carry a RX/TX transition
+      //
+      g_cond_wait_until(&hp_send_cond, &hp_send_mutex, due);
+      continue;
+    }
+    hp_send_pending = 0;
+    hp_send_packets++;
+    g_mutex_unlock(&hp_send_mutex);
+    new_protocol_high_priority();
+    last_sent = g_get_monotonic_time();
+    g_mutex_lock(&hp_send_mutex);
+  }
+  g_mutex_unlock(&hp_send_mutex);
+  return NULL;
+}
+
+static void hp_send_start(void) {
+  g_mutex_lock(&hp_send_mutex);
+  hp_send_running = 1;
+  hp_send_pending = 0;
+  hp_send_requests = 0;
+  hp_send_packets = 0;
+  g_mutex_unlock(&hp_send_mutex);
+  hp_send_thread_id = g_thread_new("P2 HP send", hp_send_thread, NULL);
+}
+
+static void hp_send_stop(void) {
+  if (hp_send_thread_id == NULL) {
+    return;
+  }
+  g_mutex_lock(&hp_send_mutex);
+  hp_send_running = 0;
+  g_cond_signal(&hp_send_cond);
+  g_mutex_unlock(&hp_send_mutex);
+  g_thread_join(hp_send_thread_id);
+  hp_send_thread_id = NULL;
+  t_print("%s: HighPrio requests=%lu packets=%lu\n", __func__, hp_send_requests, hp_send_packets);
+}
+
+void new_protocol_set_hp_window(int window_us) {
+  if (window_us < 0) {
+    window_us = 0;
+  } else if (window_us > P2_HP_WINDOW_MAX_US) {
+    window_us = P2_HP_WINDOW_MAX_US;
+  }
+  g_atomic_int_set(&p2_hp_window_us, window_us);
+}
+
 void schedule_high_priority(void) {
   if (protocol == NEW_PROTOCOL) {
-    new_protocol_high_priority();
+    g_mutex_lock(&hp_send_mutex);
+    if (hp_send_running) {
+      hp_send_requests++;
+      if (!hp_send_pending) {
+        hp_send_pending = 1;
+        g_cond_signal(&hp_send_cond);
+      } else if ((radio_is_transmitting() | radio_ptt) != g_atomic_int_get(&hp_sent_xmit)) {
+        // wake up a sender waiting for the end of the window
+        g_cond_signal(&hp_send_cond);
+      }
+      g_mutex_unlock(&hp_send_mutex);
+    } else {
+      // sender thread not running (P2 being started/stopped): send directly
+      g_mutex_unlock(&hp_send_mutex);
+      new_protocol_high_priority();
+    }
+  } else if (protocol == ORIGINAL_PROTOCOL) {
+    old_protocol_cc_dirty(P1_CC_HIGH_PRIORITY);
   }
 }
 
 void schedule_general(void) {
   if (protocol == NEW_PROTOCOL) {
     new_protocol_general();
+  } else if (protocol == ORIGINAL_PROTOCOL) {
+    old_protocol_cc_dirty(P1_CC_ALL);
   }
 }
 
 void schedule_receive_specific(void) {
   if (protocol == NEW_PROTOCOL) {
     new_protocol_receive_specific();
+  } else if (protocol == ORIGINAL_PROTOCOL) {
+    old_protocol_cc_dirty(P1_CC_RECEIVE);
   }
 }
 
 void schedule_transmit_specific(void) {
   if (protocol == NEW_PROTOCOL) {
     new_protocol_transmit_specific();
+  } else if (protocol == ORIGINAL_PROTOCOL) {
+    old_protocol_cc_dirty(P1_CC_TRANSMIT);
   }
 }
 
@@ -815,6 +925,9 @@ static int p2_jitter_enqueue(int ddc, mybuffer *mybuf) {
 
 static gpointer p2_jitter_thread(gpointer data) {
   int ddc = GPOINTER_TO_INT(data);
+  char tname[16];
+  snprintf(tname, sizeof(tname), "P2 JIT%d", ddc);
+  thread_role_enter(THREAD_ROLE_IQ, tname);
   P2_JITTER_STATE *state = &p2_jitter[ddc];
   while (1) {
     mybuffer *release_packet = NULL;
@@ -1434,6 +1547,7 @@ static void new_protocol_high_priority(void) {
   //
   int xmit     = radio_is_transmitting() | radio_ptt;
   int txvfo    = vfo_get_tx_vfo();    // VFO governing the TX frequency
+  g_atomic_int_set(&hp_sent_xmit, xmit);
   int rxvfo    = active_receiver->id; // id of the active receiver
   int othervfo = 1 - rxvfo;           // id of the "other" receiver (only valid if receivers > 1)
   int txmode   = vfo_get_tx_mode();
@@ -2433,6 +2547,7 @@ void new_protocol_menu_stop(void) {
     g_thread_join(new_protocol_thread_id);
   }
   g_thread_join(new_protocol_timer_thread_id);
+  hp_send_stop();
   new_protocol_high_priority();
   // let the FPGA rest a while
   usleep(200000);  // 200 ms
@@ -2545,10 +2660,12 @@ void new_protocol_menu_start(void) {
   usleep(50000);
   t_print("%s: send high_priority\n", __func__);
   new_protocol_high_priority();
+  hp_send_start();
   new_protocol_timer_thread_id = g_thread_new("P2 task", new_protocol_timer_thread, NULL);
 }
 
 static gpointer new_protocol_rxaudio_thread(gpointer data) {
+  thread_role_enter(THREAD_ROLE_AUDIO, "P2 SPKR");
   int nptr;
   unsigned char audiobuffer[260];
   //
@@ -2668,6 +2785,7 @@ static gpointer new_protocol_rxaudio_thread(gpointer data) {
 }
 
 static gpointer new_protocol_txiq_thread(gpointer data) {
+  thread_role_enter(THREAD_ROLE_RADIO_TX, "P2 TXIQ");
   int nptr;
   unsigned char iqbuffer[1444];
   //
@@ -2747,6 +2865,7 @@ static gpointer new_protocol_txiq_thread(gpointer data) {
 }
 
 static gpointer new_protocol_thread(gpointer data) {
+  thread_role_enter(THREAD_ROLE_RADIO_RX, "P2 main");
   t_print("new_protocol_thread\n");
   /*
    * RX ingress diagnostics.  Sequence numbers are checked immediately after
@@ -2912,6 +3031,7 @@ static gpointer new_protocol_thread(gpointer data) {
 }
 
 static gpointer high_priority_thread(gpointer data) {
+  thread_role_enter(THREAD_ROLE_RADIO_RX, "P2 HP");
   int nptr;
   int optr;
   t_print("high_priority_thread\n");
@@ -2938,6 +3058,7 @@ static gpointer high_priority_thread(gpointer data) {
 }
 
 static gpointer mic_line_thread(gpointer data) {
+  thread_role_enter(THREAD_ROLE_RADIO_TX, "P2 MIC");
   t_print("mic_line_thread\n");
   mybuffer *mybuf;
   int nptr;
@@ -3095,6 +3216,9 @@ void saturn_post_iq_data(int ddc, mybuffer *mybuf) {
 
 static gpointer iq_thread(gpointer data) {
   int ddc = GPOINTER_TO_INT(data);
+  char tname[16];
+  snprintf(tname, sizeof(tname), "P2 IQ%d", ddc);
+  thread_role_enter(THREAD_ROLE_IQ, tname);
   //
   // TEMPORARY: additional sequence check here
   //
@@ -3176,11 +3300,7 @@ static double p2_iq_sample_gain(const RECEIVER *rx) {
 }
 
 static void process_iq_data(const unsigned char *buffer, RECEIVER *rx) {
-  int b;
-  int leftsample;
-  int rightsample;
-  double leftsampledouble;
-  double rightsampledouble;
+  double iq[IQ_UNPACK_MAX_WORDS];
   int samplesperframe = ((buffer[14] & 0xFF) << 8) + (buffer[15] & 0xFF);
 #ifdef P2IQDEBUG
   long long timestamp =
@@ -3195,29 +3315,15 @@ static void process_iq_data(const unsigned char *buffer, RECEIVER *rx) {
   int bitspersample = ((buffer[12] & 0xFF) << 8) + (buffer[13] & 0xFF);
   t_print("%s: rx=%d bitspersample=%d samplesperframe=%d\n", __func__, rx->id, bitspersample, samplesperframe);
 #endif
-  b = 16;
-  int i;
-  for (i = 0; i < samplesperframe; i++) {
-    leftsample   = (int)((signed char) buffer[b++]) << 16;
-    leftsample  |= (int)((((unsigned char) buffer[b++]) << 8) & 0xFF00);
-    leftsample  |= (int)((unsigned char) buffer[b++] & 0xFF);
-    rightsample  = (int)((signed char) buffer[b++]) << 16;
-    rightsample |= (int)((((unsigned char) buffer[b++]) << 8) & 0xFF00);
-    rightsample |= (int)((unsigned char) buffer[b++] & 0xFF);
-    if (leftsample >= P2_SOFT_ADC_OVF_POS_THRESHOLD ||
-        leftsample <= P2_SOFT_ADC_OVF_NEG_THRESHOLD ||
-        rightsample >= P2_SOFT_ADC_OVF_POS_THRESHOLD ||
-        rightsample <= P2_SOFT_ADC_OVF_NEG_THRESHOLD) {
-      adc0_overload = 1;
-    }
-    // The "obscure" constant 1.1920928955078125E-7 is 1/(2^23)
-    leftsampledouble = (double) leftsample * 1.1920928955078125E-7;
-    rightsampledouble = (double) rightsample * 1.1920928955078125E-7;
-    double iq_gain = p2_iq_sample_gain(rx);
-    leftsampledouble *= iq_gain;
-    rightsampledouble *= iq_gain;
-    rx_add_iq_samples(rx, leftsampledouble, rightsampledouble);
+  if (samplesperframe > IQ_UNPACK_MAX_WORDS / 2) { samplesperframe = IQ_UNPACK_MAX_WORDS / 2; }
+  //
+  // Decode the whole packet at once, with the gain folded into the scale,
+  // and hand it to the receiver in one call.
+  //
+  if (iq_unpack24(buffer + 16, 2 * samplesperframe, IQ_UNPACK_SCALE * p2_iq_sample_gain(rx), iq)) {
+    adc0_overload = 1;
   }
+  rx_add_iq_block(rx, iq, samplesperframe);
 }
 
 //
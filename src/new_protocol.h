@@ -60,6 +60,11 @@
 #define P2_JITTER_MIN_MS 5
 #define P2_JITTER_MAX_MS 350
 
+//
+// Max. coalescing window (usec) for HighPrio packets
+//
+#define P2_HP_WINDOW_MAX_US 5000
+
 /////////////////////////////////////////////////////////////////////////////
 //
 // PEDESTRIAN BUFFER MANAGEMENT
@@ -113,6 +118,8 @@ extern void new_protocol_menu_stop (void);
 extern int p2_jitter_buffer_enabled;
 extern int p2_jitter_buffer_depth_ms;
 extern void new_protocol_set_jitter_buffer (int enabled, int depth_ms);
+extern int p2_hp_window_us;
+extern void new_protocol_set_hp_window (int window_us);
 
 typedef struct {
   int active;
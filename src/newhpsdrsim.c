@@ -893,6 +893,7 @@ void *rx_thread(void *data) {
   int myadc, syncadc;
   int rxptr;
   int divptr;
+  int loadptr = 0;
   int decimation = 1;
   int dumpptr = 0;
   unsigned int seed;
@@ -1081,6 +1082,12 @@ void *rx_thread(void *data) {
             i1sample = irsample * 0.2899;
             q1sample = qrsample * 0.2899;
           }
+        } else if (load_mode) {
+          double att = (myadc == 0) ? rxatt0_dbl : rxatt1_dbl;
+          i0sample += loadItab[loadptr] * att;
+          q0sample += loadQtab[loadptr] * att;
+          loadptr += decimation;
+          if (loadptr >= LENLOAD) { loadptr = 0; }
         } else if (do_tone == 1) {
           i0sample += cos(tonearg) * 0.0002239 * rxatt0_dbl;
           q0sample += sin(tonearg) * 0.0002239 * rxatt0_dbl;
@@ -1161,7 +1168,7 @@ void *rx_thread(void *data) {
       tsdelay.tv_sec++;
     }
     clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &tsdelay, NULL);
-    if (sendto(sock, buffer, 1444, 0, (struct sockaddr *)&addr_new, sizeof(addr_new)) < 0) {
+    if (load_sendto(1 + myddc, sock, buffer, 1444, &addr_new) < 0) {
       t_perror("***** ERROR: RX thread sendto");
       break;
     }
@@ -0,0 +1,131 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Change notification bus.
+ *
+ * notify_post() may be called from any thread. The changes are OR-ed into
+ * the pending mask of each interested subscriber, and a single GTK idle
+ * callback delivers them. Many changes in quick succession (e.g. turning
+ * the VFO knob) thus result in one callback per subscriber and main loop
+ * iteration, and nothing at all runs while the radio state does not change.
+ */
+
+#include <gtk/gtk.h>
+
+#include "message.h"
+#include "notify_bus.h"
+
+#define NOTIFY_MAX_SUBSCRIBERS 16
+
+typedef struct {
+  int used;
+  unsigned int mask;
+  int origin;
+  NOTIFY_FUNC func;
+  gpointer data;
+  unsigned int pending;
+} NOTIFY_SUBSCRIBER;
+
+static GMutex notify_mutex;
+static NOTIFY_SUBSCRIBER subscriber[NOTIFY_MAX_SUBSCRIBERS];
+static guint notify_idle_id = 0;
+
+static gboolean notify_dispatch_cb(gpointer data) {
+  NOTIFY_SUBSCRIBER todo[NOTIFY_MAX_SUBSCRIBERS];
+  int n = 0;
+  g_mutex_lock(&notify_mutex);
+  notify_idle_id = 0;
+  for (int i = 0; i < NOTIFY_MAX_SUBSCRIBERS; i++) {
+    if (subscriber[i].used && subscriber[i].pending) {
+      todo[n++] = subscriber[i];
+      subscriber[i].pending = 0;
+    }
+  }
+  g_mutex_unlock(&notify_mutex);
+  //
+  // Call the subscribers without holding the lock, such that they may
+  // post or (un)subscribe themselves.
+  //
+  for (int i = 0; i < n; i++) {
+    todo[i].func(todo[i].pending, todo[i].data);
+  }
+  return G_SOURCE_REMOVE;
+}
+
+//
+// Returns a handle > 0, or 0 if there is no free slot.
+//
+int notify_subscribe(unsigned int mask, int origin, NOTIFY_FUNC func, gpointer data) {
+  int handle = 0;
+  g_mutex_lock(&notify_mutex);
+  for (int i = 0; i < NOTIFY_MAX_SUBSCRIBERS; i++) {
+    if (!subscriber[i].used) {
+      subscriber[i].used = 1;
+      subscriber[i].mask = mask;
+      subscriber[i].origin = origin;
+      subscriber[i].func = func;
+      subscriber[i].data = data;
+      subscriber[i].pending = 0;
+      handle = i + 1;
+      break;
+    }
+  }
+  g_mutex_unlock(&notify_mutex);
+  if (handle == 0) {
+    t_print("%s: no free subscriber slot\n", __func__);
+  }
+  return handle;
+}
+
+//
+// Note: if called from a thread other than the GTK thread, the callback
+// may still be invoked once for changes that were already being dispatched.
+//
+void notify_unsubscribe(int handle) {
+  if (handle < 1 || handle > NOTIFY_MAX_SUBSCRIBERS) {
+    return;
+  }
+  g_mutex_lock(&notify_mutex);
+  subscriber[handle - 1].used = 0;
+  subscriber[handle - 1].pending = 0;
+  g_mutex_unlock(&notify_mutex);
+}
+
+void notify_post_from(unsigned int changes, int origin) {
+  int wakeup = 0;
+  g_mutex_lock(&notify_mutex);
+  for (int i = 0; i < NOTIFY_MAX_SUBSCRIBERS; i++) {
+    NOTIFY_SUBSCRIBER *sub = &subscriber[i];
+    if (!sub->used || (origin != NOTIFY_ORIGIN_NONE && sub->origin == origin)) {
+      continue;
+    }
+    if (changes & sub->mask) {
+      sub->pending |= changes & sub->mask;
+      wakeup = 1;
+    }
+  }
+  if (wakeup && notify_idle_id == 0) {
+    notify_idle_id = g_idle_add(notify_dispatch_cb, NULL);
+  }
+  g_mutex_unlock(&notify_mutex);
+}
+
+void notify_post(unsigned int changes) {
+  notify_post_from(changes, NOTIFY_ORIGIN_NONE);
+}
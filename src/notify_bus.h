@@ -0,0 +1,71 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef _NOTIFY_BUS_H
+#define _NOTIFY_BUS_H
+
+#include <glib.h>
+
+//
+// Change notification bus
+//
+// Code that changes the radio state posts a bit mask describing what has
+// changed. Subscribers (CAT auto-reporting, ANDROMEDA LEDs, TCI) receive
+// all changes accumulated since their last invocation in one callback,
+// executed from the GTK idle queue.
+//
+#define NOTIFY_VFO_A_FREQ  (1u << 0)
+#define NOTIFY_VFO_B_FREQ  (1u << 1)
+#define NOTIFY_VFO_A_MODE  (1u << 2)
+#define NOTIFY_VFO_B_MODE  (1u << 3)
+#define NOTIFY_TX_FREQ     (1u << 4)
+#define NOTIFY_VFOS        (1u << 5)   // both VFOs changed (band change, A<>B swap/copy)
+#define NOTIFY_MOX         (1u << 6)
+#define NOTIFY_TUNE        (1u << 7)
+#define NOTIFY_SPLIT       (1u << 8)
+#define NOTIFY_RIT_XIT     (1u << 9)
+#define NOTIFY_CTUN        (1u << 10)
+#define NOTIFY_LOCK        (1u << 11)
+#define NOTIFY_PS          (1u << 12)
+#define NOTIFY_DIVERSITY   (1u << 13)
+#define NOTIFY_ACTIVE_RX   (1u << 14)
+#define NOTIFY_ATU         (1u << 15)
+#define NOTIFY_ALL         0xffffu
+
+#define NOTIFY_VFO_FREQ(id) ((id) == 1 ? NOTIFY_VFO_B_FREQ : NOTIFY_VFO_A_FREQ)
+#define NOTIFY_VFO_MODE(id) ((id) == 1 ? NOTIFY_VFO_B_MODE : NOTIFY_VFO_A_MODE)
+
+//
+// Origin of a change. A change posted with notify_post_from() is not
+// reported back to subscribers of the same origin (e.g. TCI clients do
+// not get an echo of a command applied via TCI).
+//
+enum {
+  NOTIFY_ORIGIN_NONE = 0,
+  NOTIFY_ORIGIN_CAT,
+  NOTIFY_ORIGIN_TCI
+};
+
+typedef void (*NOTIFY_FUNC)(unsigned int changes, gpointer data);
+
+extern int notify_subscribe(unsigned int mask, int origin, NOTIFY_FUNC func, gpointer data);
+extern void notify_unsubscribe(int handle);
+extern void notify_post(unsigned int changes);
+extern void notify_post_from(unsigned int changes, int origin);
+
+#endif
@@ -332,12 +332,146 @@ static void discover(struct ifaddrs* iface, int discflag) {
   }
 }
 
+//
+// Evaluate a P1 discovery reply received via the interface if_addr/if_mask/if_name
+// and append it to the list of discovered devices. Returns 1 if a device has been added.
+//
+int old_discovery_add(const unsigned char *buffer, const struct sockaddr_in *addr,
+                      const struct sockaddr_in *if_addr, const struct sockaddr_in *if_mask,
+                      const char *if_name) {
+  int i;
+  int status = buffer[2] & 0xFF;
+  if ((status != 2 && status != 3) || devices >= MAX_DEVICES) {
+    return 0;
+  }
+  discovered[devices].protocol = ORIGINAL_PROTOCOL;
+  discovered[devices].device = buffer[10] & 0xFF;
+  discovered[devices].software_version = buffer[9] & 0xFF;
+  switch (discovered[devices].device) {
+  case DEVICE_METIS:
+    g_strlcpy(discovered[devices].name, "Metis", sizeof(discovered[devices].name));
+    discovered[devices].frequency_min = 0.0;
+    discovered[devices].frequency_max = 61440000.0;
+    break;
+  case DEVICE_HERMES:
+    g_strlcpy(discovered[devices].name, "Hermes", sizeof(discovered[devices].name));
+    discovered[devices].frequency_min = 0.0;
+    discovered[devices].frequency_max = 61440000.0;
+    break;
+  case DEVICE_GRIFFIN:
+    g_strlcpy(discovered[devices].name, "Griffin", sizeof(discovered[devices].name));
+    discovered[devices].frequency_min = 0.0;
+    discovered[devices].frequency_max = 61440000.0;
+    break;
+  case DEVICE_ANGELIA:
+    g_strlcpy(discovered[devices].name, "Angelia", sizeof(discovered[devices].name));
+    discovered[devices].frequency_min = 0.0;
+    discovered[devices].frequency_max = 61440000.0;
+    break;
+  case DEVICE_ORION:
+    g_strlcpy(discovered[devices].name, "Orion", sizeof(discovered[devices].name));
+    discovered[devices].frequency_min = 0.0;
+    discovered[devices].frequency_max = 61440000.0;
+    break;
+  case DEVICE_HERMES_LITE:
+    //
+    // HermesLite V2 boards use
+    // DEVICE_HERMES_LITE as the ID and a software version
+    // that is larger or equal to 40, while the original
+    // (V1) HermesLite boards have software versions up to 31.
+    // Furthermode, HL2 uses a minor version in buffer[21]
+    // so the official version number e.g. 73.2 stems from buf9=73 and buf21=2
+    //
+    discovered[devices].software_version = 10 * (buffer[9] & 0xFF) + (buffer[21] & 0xFF);
+    if (discovered[devices].software_version < 400) {
+      g_strlcpy(discovered[devices].name, "HermesLite V1", sizeof(discovered[devices].name));
+    } else {
+      g_strlcpy(discovered[devices].name, "HermesLite V2", sizeof(discovered[devices].name));
+      discovered[devices].device = DEVICE_HERMES_LITE2;
+      // t_print("discovered HL2: Gateware Major Version=%d Minor Version=%d\n", buffer[9], buffer[21]);
+      t_print("%s: ==> HL2: Gateware Major Version=%d Minor Version=%d\n", __func__, buffer[9], buffer[21]);
+      if (buffer[11] & 0xA0) {
+        t_print("==> HL2: fixed IP %d.%d.%d.%d (DHCP overrides)\n", buffer[13], buffer[14], buffer[15], buffer[16]);
+      } else if (buffer[11] & 0x80) {
+        t_print("==> HL2: fixed IP %d.%d.%d.%d (DHCP ignored)\n", buffer[13], buffer[14], buffer[15], buffer[16]);
+      }
+      if (buffer[11] & 0x40) {
+        t_print("==> HL2 MAC addr modified: <...>:%02x:%02x\n", buffer[17], buffer[18]);
+      }
+    }
+    discovered[devices].frequency_min = 0.0;
+    discovered[devices].frequency_max = 38400000.0;
+    break;
+  case DEVICE_ORION2:
+    g_strlcpy(discovered[devices].name, "Orion2", sizeof(discovered[devices].name));
+    discovered[devices].frequency_min = 0.0;
+    discovered[devices].frequency_max = 61440000.0;
+    break;
+  case DEVICE_STEMLAB:
+    // This is in principle the same as HERMES but has two ADCs
+    // (and therefore, can do DIVERSITY).
+    // There are some problems with the 6m band on the RedPitaya
+    // but with additional filtering it can be used.
+    g_strlcpy(discovered[devices].name, "STEMlab", sizeof(discovered[devices].name));
+    discovered[devices].frequency_min = 0.0;
+    discovered[devices].frequency_max = 61440000.0;
+    break;
+  case DEVICE_STEMLAB_Z20:
+    // This is in principle the same as HERMES but has two ADCs
+    // (and therefore, can do DIVERSITY).
+    // There are some problems with the 6m band on the RedPitaya
+    // but with additional filtering it can be used.
+    g_strlcpy(discovered[devices].name, "STEMlab-Zync7020", sizeof(discovered[devices].name));
+    discovered[devices].frequency_min = 0.0;
+    discovered[devices].frequency_max = 61440000.0;
+    break;
+  default:
+    g_strlcpy(discovered[devices].name, "Unknown", sizeof(discovered[devices].name));
+    discovered[devices].frequency_min = 0.0;
+    discovered[devices].frequency_max = 61440000.0;
+    break;
+  }
+  for (i = 0; i < 6; i++) {
+    discovered[devices].info.network.mac_address[i] = buffer[i + 3];
+  }
+  discovered[devices].status = status;
+  memcpy((void *) &discovered[devices].info.network.address, (void *) addr, sizeof(*addr));
+  discovered[devices].info.network.address_length = sizeof(*addr);
+  memcpy((void *) &discovered[devices].info.network.interface_address, (void *) if_addr, sizeof(*if_addr));
+  memcpy((void *) &discovered[devices].info.network.interface_netmask, (void *) if_mask, sizeof(*if_mask));
+  discovered[devices].info.network.interface_length = sizeof(*if_addr);
+  g_strlcpy(discovered[devices].info.network.interface_name, if_name,
+            sizeof(discovered[devices].info.network.interface_name));
+  discovered[devices].use_tcp = 0;
+  discovered[devices].use_routing = 0;
+  discovered[devices].supported_receivers = 2;
+  t_print("%s: device=%d name=%s software_version=%d status=%d\n",
+          __func__,
+          discovered[devices].device,
+          discovered[devices].name,
+          discovered[devices].software_version,
+          discovered[devices].status);
+  t_print("%s: address=%s (%02X:%02X:%02X:%02X:%02X:%02X) on %s min=%0.3f MHz max=%0.3f MHz\n",
+          __func__,
+          inet_ntoa(discovered[devices].info.network.address.sin_addr),
+          discovered[devices].info.network.mac_address[0],
+          discovered[devices].info.network.mac_address[1],
+          discovered[devices].info.network.mac_address[2],
+          discovered[devices].info.network.mac_address[3],
+          discovered[devices].info.network.mac_address[4],
+          discovered[devices].info.network.mac_address[5],
+          discovered[devices].info.network.interface_name,
+          discovered[devices].frequency_min * 1E-6,
+          discovered[devices].frequency_max * 1E-6);
+  devices++;
+  return 1;
+}
+
 static gpointer discover_receive_thread(gpointer data) {
   struct sockaddr_in addr;
   socklen_t len;
   unsigned char buffer[2048];
   struct timeval tv;
-  int i;
   t_print("discover_receive_thread\n");
   /*
    * SO_RCVTIMEO is only a wake-up interval, not the discovery lifetime.
@@ -362,133 +496,7 @@ static gpointer discover_receive_thread(gpointer data) {
     if (bytes_read == 0) { break; }
     t_print("old_discovery: received %d bytes\n", bytes_read);
     if ((buffer[0] & 0xFF) == 0xEF && (buffer[1] & 0xFF) == 0xFE) {
-      int status = buffer[2] & 0xFF;
-      if (status == 2 || status == 3) {
-        if (devices < MAX_DEVICES) {
-          discovered[devices].protocol = ORIGINAL_PROTOCOL;
-          discovered[devices].device = buffer[10] & 0xFF;
-          discovered[devices].software_version = buffer[9] & 0xFF;
-          switch (discovered[devices].device) {
-          case DEVICE_METIS:
-            g_strlcpy(discovered[devices].name, "Metis", sizeof(discovered[devices].name));
-            discovered[devices].frequency_min = 0.0;
-            discovered[devices].frequency_max = 61440000.0;
-            break;
-          case DEVICE_HERMES:
-            g_strlcpy(discovered[devices].name, "Hermes", sizeof(discovered[devices].name));
-            discovered[devices].frequency_min = 0.0;
-            discovered[devices].frequency_max = 61440000.0;
-            break;
-          case DEVICE_GRIFFIN:
-            g_strlcpy(discovered[devices].name, "Griffin", sizeof(discovered[devices].name));
-            discovered[devices].frequency_min = 0.0;
-            discovered[devices].frequency_max = 61440000.0;
-            break;
-          case DEVICE_ANGELIA:
-            g_strlcpy(discovered[devices].name, "Angelia", sizeof(discovered[devices].name));
-            discovered[devices].frequency_min = 0.0;
-            discovered[devices].frequency_max = 61440000.0;
-            break;
-          case DEVICE_ORION:
-            g_strlcpy(discovered[devices].name, "Orion", sizeof(discovered[devices].name));
-            discovered[devices].frequency_min = 0.0;
-            discovered[devices].frequency_max = 61440000.0;
-            break;
-          case DEVICE_HERMES_LITE:
-            //
-            // HermesLite V2 boards use
-            // DEVICE_HERMES_LITE as the ID and a software version
-            // that is larger or equal to 40, while the original
-            // (V1) HermesLite boards have software versions up to 31.
-            // Furthermode, HL2 uses a minor version in buffer[21]
-            // so the official version number e.g. 73.2 stems from buf9=73 and buf21=2
-            //
-            discovered[devices].software_version = 10 * (buffer[9] & 0xFF) + (buffer[21] & 0xFF);
-            if (discovered[devices].software_version < 400) {
-              g_strlcpy(discovered[devices].name, "HermesLite V1", sizeof(discovered[devices].name));
-            } else {
-              g_strlcpy(discovered[devices].name, "HermesLite V2", sizeof(discovered[devices].name));
-              discovered[devices].device = DEVICE_HERMES_LITE2;
-              // t_print("discovered HL2: Gateware Major Version=%d Minor Version=%d\n", buffer[9], buffer[21]);
-              t_print("%s: ==> HL2: Gateware Major Version=%d Minor Version=%d\n", __func__, buffer[9], buffer[21]);
-              if (buffer[11] & 0xA0) {
-                t_print("==> HL2: fixed IP %d.%d.%d.%d (DHCP overrides)\n", buffer[13], buffer[14], buffer[15], buffer[16]);
-              } else if (buffer[11] & 0x80) {
-                t_print("==> HL2: fixed IP %d.%d.%d.%d (DHCP ignored)\n", buffer[13], buffer[14], buffer[15], buffer[16]);
-              }
-              if (buffer[11] & 0x40) {
-                t_print("==> HL2 MAC addr modified: <...>:%02x:%02x\n", buffer[17], buffer[18]);
-              }
-            }
-            discovered[devices].frequency_min = 0.0;
-            discovered[devices].frequency_max = 38400000.0;
-            break;
-          case DEVICE_ORION2:
-            g_strlcpy(discovered[devices].name, "Orion2", sizeof(discovered[devices].name));
-            discovered[devices].frequency_min = 0.0;
-            discovered[devices].frequency_max = 61440000.0;
-            break;
-          case DEVICE_STEMLAB:
-            // This is in principle the same as HERMES but has two ADCs
-            // (and therefore, can do DIVERSITY).
-            // There are some problems with the 6m band on the RedPitaya
-            // but with additional filtering it can be used.
-            g_strlcpy(discovered[devices].name, "STEMlab", sizeof(discovered[devices].name));
-            discovered[devices].frequency_min = 0.0;
-            discovered[devices].frequency_max = 61440000.0;
-            break;
-          case DEVICE_STEMLAB_Z20:
-            // This is in principle the same as HERMES but has two ADCs
-            // (and therefore, can do DIVERSITY).
-            // There are some problems with the 6m band on the RedPitaya
-            // but with additional filtering it can be used.
-            g_strlcpy(discovered[devices].name, "STEMlab-Zync7020", sizeof(discovered[devices].name));
-            discovered[devices].frequency_min = 0.0;
-            discovered[devices].frequency_max = 61440000.0;
-            break;
-          default:
-            g_strlcpy(discovered[devices].name, "Unknown", sizeof(discovered[devices].name));
-            discovered[devices].frequency_min = 0.0;
-            discovered[devices].frequency_max = 61440000.0;
-            break;
-          }
-          for (i = 0; i < 6; i++) {
-            discovered[devices].info.network.mac_address[i] = buffer[i + 3];
-          }
-          discovered[devices].status = status;
-          memcpy((void *) &discovered[devices].info.network.address, (void *) &addr, sizeof(addr));
-          discovered[devices].info.network.address_length = sizeof(addr);
-          memcpy((void *) &discovered[devices].info.network.interface_address, (void *) &interface_addr,
-                 sizeof(interface_addr));
-          memcpy((void *) &discovered[devices].info.network.interface_netmask, (void *) &interface_netmask,
-                 sizeof(interface_netmask));
-          discovered[devices].info.network.interface_length = sizeof(interface_addr);
-          g_strlcpy(discovered[devices].info.network.interface_name, interface_name,
-                    sizeof(discovered[devices].info.network.interface_name));
-          discovered[devices].use_tcp = 0;
-          discovered[devices].use_routing = 0;
-          discovered[devices].supported_receivers = 2;
-          t_print("%s: device=%d name=%s software_version=%d status=%d\n",
-                  __func__,
-                  discovered[devices].device,
-                  discovered[devices].name,
-                  discovered[devices].software_version,
-                  discovered[devices].status);
-          t_print("%s: address=%s (%02X:%02X:%02X:%02X:%02X:%02X) on %s min=%0.3f MHz max=%0.3f MHz\n",
-                  __func__,
-                  inet_ntoa(discovered[devices].info.network.address.sin_addr),
-                  discovered[devices].info.network.mac_address[0],
-                  discovered[devices].info.network.mac_address[1],
-                  discovered[devices].info.network.mac_address[2],
-                  discovered[devices].info.network.mac_address[3],
-                  discovered[devices].info.network.mac_address[4],
-                  discovered[devices].info.network.mac_address[5],
-                  discovered[devices].info.network.interface_name,
-                  discovered[devices].frequency_min * 1E-6,
-                  discovered[devices].frequency_max * 1E-6);
-          devices++;
-        }
-      }
+      (void) old_discovery_add(buffer, &addr, &interface_addr, &interface_netmask, interface_name);
     }
   }
   t_print("discovery: exiting discover_receive_thread\n");
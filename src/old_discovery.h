@@ -22,7 +22,12 @@
 #ifndef _OLD_DISCOVERY_H
 #define _OLD_DISCOVERY_H
 
+#include <netinet/in.h>
+
 void old_discovery(void);
+int old_discovery_add(const unsigned char *buffer, const struct sockaddr_in *addr,
+                      const struct sockaddr_in *if_addr, const struct sockaddr_in *if_mask,
+                      const char *if_name);
 #ifdef STEMLAB_DISCOVERY
   int  stemlab_get_info(int id);
 #endif
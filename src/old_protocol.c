@@ -59,6 +59,7 @@
 #include "message.h"
 #include "rigctl.h"
 #include "nw_toolset.h"
+#include "thread_role.h"
 #ifdef __APPLE__
   #include "toolset.h"
 #endif
@@ -166,6 +167,98 @@ static unsigned char output_buffer[OZY_BUFFER_SIZE];
 
 static int command = 1;
 
+//
+// Dirty-tracked C&C scheduling.
+//
+// Code that changes radio settings marks the affected C&C register groups
+// dirty (via the schedule_xxx() functions). ozy_send_buffer() then sends
+// dirty groups in priority order instead of waiting until the round-robin
+// arrives there. After P1_CC_MAX_DIRTY_STREAK dirty packets in a row, one
+// round-robin packet is sent such that all registers are still refreshed
+// periodically while e.g. the VFO is spinning.
+//
+#define P1_CC_MAX_DIRTY_STREAK 3
+
+static atomic_uint cc_dirty = 0;
+static gint64 cc_dirty_since[11];         // time stamp when a group became dirty
+static int cc_dirty_rx = 0;               // next RX of a running "dirty" RX frequency sweep
+static int cc_dirty_streak = 0;
+static const int cc_priority[] = { 1, 2, 3, 10, 6, 4, 5, 7, 8, 9 };
+
+static GMutex cc_diag_mutex;
+static unsigned long cc_diag_updates = 0;
+static gint64 cc_diag_sum_us = 0;
+static gint64 cc_diag_max_us = 0;
+
+void old_protocol_cc_dirty(unsigned int groups) {
+  gint64 now = g_get_monotonic_time();
+  unsigned int old = atomic_load(&cc_dirty);
+  for (int n = 1; n <= 10; n++) {
+    if ((groups & P1_CC_GROUP(n)) && !(old & P1_CC_GROUP(n))) {
+      cc_dirty_since[n] = now;
+    }
+  }
+  atomic_fetch_or(&cc_dirty, groups & P1_CC_ALL);
+}
+
+void old_protocol_get_cc_diag(P1_CC_DIAG *diag) {
+  g_mutex_lock(&cc_diag_mutex);
+  diag->updates = cc_diag_updates;
+  diag->avg_ms = cc_diag_updates > 0 ? 0.001 * (double) cc_diag_sum_us / (double) cc_diag_updates : 0.0;
+  diag->max_ms = 0.001 * (double) cc_diag_max_us;
+  cc_diag_updates = 0;
+  cc_diag_sum_us = 0;
+  cc_diag_max_us = 0;
+  g_mutex_unlock(&cc_diag_mutex);
+}
+
+static void cc_diag_record(int group) {
+  gint64 since = cc_dirty_since[group];
+  if (since == 0) { return; }
+  gint64 us = g_get_monotonic_time() - since;
+  cc_dirty_since[group] = 0;
+  g_mutex_lock(&cc_diag_mutex);
+  cc_diag_updates++;
+  cc_diag_sum_us += us;
+  if (us > cc_diag_max_us) { cc_diag_max_us = us; }
+  g_mutex_unlock(&cc_diag_mutex);
+}
+
+//
+// Returns the C&C group (command) to be sent next out of the order,
+// or 0 if the round-robin should continue.
+//
+static int cc_next_dirty(void) {
+  if (cc_dirty_streak >= P1_CC_MAX_DIRTY_STREAK) {
+    cc_dirty_streak = 0;
+    return 0;
+  }
+  if (cc_dirty_rx != 0) {
+    // continue RX frequency sweep
+    cc_dirty_streak++;
+    return 2;
+  }
+  unsigned int dirty = atomic_load(&cc_dirty);
+  if (dirty == 0) {
+    cc_dirty_streak = 0;
+    return 0;
+  }
+  for (size_t i = 0; i < sizeof(cc_priority) / sizeof(cc_priority[0]); i++) {
+    int n = cc_priority[i];
+    if (dirty & P1_CC_GROUP(n)) {
+      //
+      // Clear the flag *before* the packet is built from the current
+      // settings, a change in between is then sent once more.
+      //
+      atomic_fetch_and(&cc_dirty, ~P1_CC_GROUP(n));
+      cc_diag_record(n);
+      cc_dirty_streak++;
+      return n;
+    }
+  }
+  return 0;
+}
+
 static gpointer receive_thread(gpointer arg);
 static gpointer process_ozy_input_buffer_thread(gpointer arg);
 
@@ -481,8 +574,76 @@ void old_protocol_update_timing(void) {
 }
 #endif
 
+//
+// TX pacing.
+//
+// tx_fifo_ms is the estimated filling of the TX FIFO in the FPGA (in msec).
+// It drains in real time and grows by 126 samples with each packet sent.
+// A HermesLite-II reports its TX FIFO count in the C&C response, and each
+// new report replaces the estimate. The TX thread then waits before sending
+// the next packet for as long as the FIFO is above p1_tx_target_ms (at most
+// 2 msec per packet), and sends without delay if it is below.
+//
+int p1_tx_target_ms = P1_TX_TARGET_DEFAULT_MS;
+
+static atomic_int hl2_fifo_samples;          // last HL2 FIFO report, -1 if none
+static atomic_uint hl2_fifo_seq;             // incremented with each report
+static atomic_int tx_fifo_est_us;            // tx_fifo_ms for display
+static double tx_fifo_ms = 0.0;              // the following only used by the TX thread
+static double tx_fifo_last = -9999.9;
+static unsigned int tx_fifo_seen = 0;
+
+static int tx_pace_us(void) {
+  struct timespec ts;
+  double now;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  now = ts.tv_sec + 1.0E-9 * ts.tv_nsec;
+  tx_fifo_ms -= (now - tx_fifo_last) * 1000.0;
+  tx_fifo_last = now;
+  if (tx_fifo_ms < 0.0) {
+    tx_fifo_ms = 0.0;
+  }
+  unsigned int seq = atomic_load_explicit(&hl2_fifo_seq, memory_order_acquire);
+  if (seq != tx_fifo_seen) {
+    int fifo = atomic_load_explicit(&hl2_fifo_samples, memory_order_relaxed);
+    tx_fifo_seen = seq;
+    if (fifo >= 0) {
+      tx_fifo_ms = (double) fifo / 48.0;
+    }
+  }
+  atomic_store_explicit(&tx_fifo_est_us, (int)(tx_fifo_ms * 1000.0), memory_order_relaxed);
+  double excess = tx_fifo_ms - (double) g_atomic_int_get(&p1_tx_target_ms);
+  if (excess <= 0.0) {
+    return 0;
+  }
+  return excess >= 2.0 ? 2000 : (int)(excess * 1000.0);
+}
+
+static void tx_pace_sent(void) {
+  // Use effective TX sample rate (was hardcoded 48k)
+  const int div = atomic_load_explicit(&mic_sample_divisor, memory_order_relaxed);
+  const double tx_sr = 48000.0 * (double) div;
+  tx_fifo_ms += 126000.0 / (tx_sr > 0.0 ? tx_sr : 48000.0);  // number of samples in THIS packet
+}
+
+void old_protocol_get_tx_fifo(double *estimate_ms, double *reported_ms) {
+  int fifo = atomic_load_explicit(&hl2_fifo_samples, memory_order_relaxed);
+  *estimate_ms = 0.001 * (double) atomic_load_explicit(&tx_fifo_est_us, memory_order_relaxed);
+  *reported_ms = fifo >= 0 ? (double) fifo / 48.0 : -1.0;
+}
+
+void old_protocol_set_tx_target(int ms) {
+  if (ms < P1_TX_TARGET_MIN_MS) {
+    ms = P1_TX_TARGET_MIN_MS;
+  } else if (ms > P1_TX_TARGET_MAX_MS) {
+    ms = P1_TX_TARGET_MAX_MS;
+  }
+  g_atomic_int_set(&p1_tx_target_ms, ms);
+}
+
 #ifdef __APPLE__
 static gpointer old_protocol_txiq_thread(gpointer data) {
+  thread_role_enter(THREAD_ROLE_RADIO_TX, "P1 out");
   int nptr;
   struct timespec target_time;
   clock_gettime(CLOCK_MONOTONIC, &target_time);  // Startzeitpunkt initialisieren
@@ -527,10 +688,10 @@ static gpointer old_protocol_txiq_thread(gpointer data) {
     atomic_store_explicit(&txring_outptr, nptr, memory_order_release);
     (void) atomic_fetch_add_explicit(&txring_blocks_completed, 1, memory_order_release);
     pthread_mutex_unlock(&send_ozy_mutex);
-    // 🕒 Dynamisch berechneter Abstand je nach aktueller Sample-Rate
-    int sr_local = atomic_load_explicit(&sr, memory_order_relaxed);
-    int interval_us = 126 * 1000000 / (sr_local ? sr_local : 48000);
-    // ➤ Zielzeitpunkt für nächstes Paket berechnen
+    tx_pace_sent();
+    // ➤ Abstand zum nächsten Paket aus der geschätzten/gemeldeten FIFO-Füllung
+    int interval_us = tx_pace_us();
+    clock_gettime(CLOCK_MONOTONIC, &target_time);
     target_time.tv_nsec += interval_us * 1000;
     if (target_time.tv_nsec >= 1000000000) {
       target_time.tv_nsec -= 1000000000;
@@ -545,6 +706,7 @@ static gpointer old_protocol_txiq_thread(gpointer data) {
 
 #ifndef __APPLE__
 static gpointer old_protocol_txiq_thread(gpointer data) {
+  thread_role_enter(THREAD_ROLE_RADIO_TX, "P1 out");
   int nptr;
   //
   // Ideally, an output METIS buffer with 126 samples is sent every 2625 usec.
@@ -578,46 +740,19 @@ static gpointer old_protocol_txiq_thread(gpointer data) {
     // We used to have a fixed sleeping time of 2000 usec, and
     // observed that the sleep was sometimes too long, especially
     // at 48k sample rate.
-    // The idea is now to monitor how fast we actually send
-    // the packets, and FIFO is the coarse (!) estimation of the
-    // FPGA-FIFO filling level.
-    // If we lag behind and FIFO goes low, send packets with
-    // little or no delay. Never sleep longer than 2000 usec, the
-    // fixed time we had before.
-    //
-    struct timespec ts;
-    static double last = -9999.9;
-    static double FIFO = 0.0;
-    double now;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    now = ts.tv_sec + 1.0E-9 * ts.tv_nsec;
-    // Use effective TX sample rate (was hardcoded 48k)
-    const int div = atomic_load_explicit(&mic_sample_divisor, memory_order_relaxed);
-    const double tx_sr = 48000.0 * (double) div;
-    FIFO -= (now - last) * (tx_sr > 0.0 ? tx_sr : 48000.0);
-    last = now;
-    if (FIFO < 0.0) {
-      FIFO = 0.0;
-    }
-    //
-    // Depending on how we estimate the FIFO filling, wait
-    // 2000usec, or 500 usec, or nothing before sending
-    // out the next packet.
+    // The waiting time is now derived from the (estimated or, for the HL2,
+    // reported) FPGA-FIFO filling, see tx_pace_us(). If we lag behind and
+    // the FIFO goes below the target, send packets without delay. Never
+    // sleep longer than 2000 usec, the fixed time we had before.
     //
     // Note that in reality, the "sleep" is a little bit longer
     // than specified by ts (we cannot rely on a wake-up in time).
     //
-    if (FIFO > 1500.0) {
-      // Wait about 2000 usec before sending the next packet.
-      ts.tv_nsec += 2000000;
-      if (ts.tv_nsec > 999999999) {
-        ts.tv_sec++;
-        ts.tv_nsec -= 1000000000;
-      }
-      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
-    } else if (FIFO > 300.0) {
-      // Wait about 500 usec before sending the next packet.
-      ts.tv_nsec += 500000;
+    int wait_us = tx_pace_us();
+    if (wait_us > 0) {
+      struct timespec ts;
+      clock_gettime(CLOCK_MONOTONIC, &ts);
+      ts.tv_nsec += wait_us * 1000;
       if (ts.tv_nsec > 999999999) {
         ts.tv_sec++;
         ts.tv_nsec -= 1000000000;
@@ -638,7 +773,7 @@ static gpointer old_protocol_txiq_thread(gpointer data) {
     ozy_send_buffer();
     memcpy(output_buffer + 8, &TXRINGBUF[out + 504], 504);
     ozy_send_buffer();
-    FIFO += 126.0;  // number of samples in THIS packet
+    tx_pace_sent();
     pthread_mutex_unlock(&send_ozy_mutex);
     MEMORY_BARRIER;
     atomic_store_explicit(&txring_outptr, nptr, memory_order_release);
@@ -670,11 +805,23 @@ void old_protocol_run(void) {
     audio_reset_mic_buffer();
   }
 #endif
+  old_protocol_cc_dirty(P1_CC_ALL);
   pthread_mutex_lock(&send_ozy_mutex);
   metis_restart();
   pthread_mutex_unlock(&send_ozy_mutex);
 }
 
+//
+// Called if the number of DDCs needed has changed (RX2 moving into or out
+// of the RX1 band with the channelizer). While stopped, the new number
+// takes effect with the next old_protocol_run().
+//
+void old_protocol_ddcs_changed(void) {
+  if (!P1running) { return; }
+  old_protocol_stop();
+  old_protocol_run();
+}
+
 void old_protocol_set_mic_sample_rate(int rate) {
   atomic_store_explicit(&mic_sample_divisor, rate / 48000, memory_order_relaxed);
 #ifdef __APPLE__
@@ -693,6 +840,7 @@ void old_protocol_init(int rate) {
   atomic_init(&sr,          0);
 #endif
   atomic_init(&mic_sample_divisor, 1);
+  atomic_init(&hl2_fifo_samples, -1);
   t_print("%s: num_hpsdr_receivers=%d\n", __func__, how_many_receivers());
   t_print("%s: RX ring buffer size: %d bytes\n", __func__, RXRINGBUFLEN);
   t_print("%s: TX ring buffer size: %d bytes\n", __func__, TXRINGBUFLEN);
@@ -856,6 +1004,7 @@ static gpointer ozy_i2c_thread(gpointer arg) {
 // then processes them one at a time.
 //
 static gpointer ozy_ep6_rx_thread(gpointer arg) {
+  thread_role_enter(THREAD_ROLE_RADIO_RX, "OZYEP6");
   t_print("old_protocol: USB EP6 receive_thread\n");
   static unsigned char ep6_inbuffer[EP6_BUFFER_SIZE];
   for (;;) {
@@ -1112,6 +1261,7 @@ static void open_tcp_socket(void) {
 
 #ifndef __APPLE__
 static gpointer receive_thread(gpointer arg) {
+  thread_role_enter(THREAD_ROLE_RADIO_RX, "METIS");
   struct sockaddr_in addr;
   socklen_t length;
   unsigned char buffer[1032];
@@ -1221,6 +1371,7 @@ static gpointer receive_thread(gpointer arg) {
 
 #ifdef __APPLE__
 static gpointer receive_thread(gpointer arg) {
+  thread_role_enter(THREAD_ROLE_RADIO_RX, "METIS");
   struct sockaddr_in addr;
   socklen_t length = sizeof(addr);
   unsigned char buffer[1032];
@@ -1506,6 +1657,7 @@ static int how_many_receivers(void) {
   // When PureSignal is active, we need to include the TX DAC channel.
   //
   int ret = receivers;          // 1 or 2
+  if (rx_channelizer_running()) { ret = 1; }           // RX2 is derived from the RX1 stream
   if (old_protocol_diversity_rx_active()) { ret = 2; } // need both RX channels, even if there is only one RX
   //
   // Always return 2 so the number of HPSDR-RX is NEVER changed.
@@ -1744,7 +1896,14 @@ static void process_control_bytes(void) {
         // during RX: set flag to zero
         tx_fifo_flag = 0;
         tx_fifo_underrun = 0;
+        atomic_store_explicit(&hl2_fifo_samples, -1, memory_order_relaxed);
       } else {
+        //
+        // C3 bits 6:0 are the TX FIFO count in units of 32 samples,
+        // feed this into the TX pacing
+        //
+        atomic_store_explicit(&hl2_fifo_samples, (control_in[3] & 0x7F) * 32, memory_order_relaxed);
+        atomic_fetch_add_explicit(&hl2_fifo_seq, 1, memory_order_release);
         // after RX/TX transition: ignore underflow condition
         // until it first vanishes. tx_fifo_flag becomes "true"
         // as soon as a "no underflow" condition is seen.
@@ -2018,6 +2177,7 @@ static void queue_two_ozy_input_buffers(unsigned const char *buf1,
 }
 
 static gpointer process_ozy_input_buffer_thread(gpointer arg) {
+  thread_role_enter(THREAD_ROLE_IQ, "P1 proc");
   //
   // This thread constantly monitors the input ring buffer and
   // processes the data whenever a bunch is available. Note this
@@ -2565,6 +2725,21 @@ void ozy_send_buffer(void) {
     output_buffer[C2] = 0x00;
     output_buffer[C3] = 0x00;
     output_buffer[C4] = 0x00;
+    //
+    // Dirty register groups take precedence over the round-robin.
+    // The round-robin state (command, current_rx) is saved and restored
+    // around an out-of-order packet. An out-of-order RX frequency group
+    // sweeps over all receivers using cc_dirty_rx.
+    //
+    int rr_command = command;
+    int rr_rx = current_rx;
+    int dirty_command = cc_next_dirty();
+    if (dirty_command != 0) {
+      command = dirty_command;
+      if (dirty_command == 2) {
+        current_rx = cc_dirty_rx;
+      }
+    }
     switch (command) {
     case 1: { // tx frequency
       output_buffer[C0] = 0x02;
@@ -3201,8 +3376,15 @@ void ozy_send_buffer(void) {
       command = 1;
     }
     break;
+    }
+    if (dirty_command != 0) {
+      if (dirty_command == 2) {
+        cc_dirty_rx = current_rx;   // wrapped to zero after the last RX
+      }
+      command = rr_command;
+      current_rx = rr_rx;
+    }
   }
-}
   // set mox
 if (radio_is_transmitting()) {
   if (txmode == modeCWU || txmode == modeCWL) {
@@ -38,8 +38,41 @@ extern const char *hl2_iob_get_lpf_status_str(void);
   extern int hl2_pa_enable_suppressed;
 #endif
 
+//
+// C&C register groups. Group n is the n-th packet of the round-robin
+// sequence in ozy_send_buffer() (1: TX freq, 2: RX freqs, 3: drive/filters,
+// 4-6: preamp/attenuators/ADC assignment, 7-9: CW, 10: Alex2).
+// Groups marked dirty are sent before the round-robin continues.
+//
+#define P1_CC_GROUP(n)        (1u << (n))
+#define P1_CC_HIGH_PRIORITY   (P1_CC_GROUP(1) | P1_CC_GROUP(2) | P1_CC_GROUP(3) | P1_CC_GROUP(10))
+#define P1_CC_RECEIVE         (P1_CC_GROUP(4) | P1_CC_GROUP(5) | P1_CC_GROUP(6))
+#define P1_CC_TRANSMIT        (P1_CC_GROUP(3) | P1_CC_GROUP(6) | P1_CC_GROUP(7) | P1_CC_GROUP(8) | P1_CC_GROUP(9))
+#define P1_CC_ALL             (P1_CC_HIGH_PRIORITY | P1_CC_RECEIVE | P1_CC_TRANSMIT)
+
+typedef struct {
+  unsigned long updates;        // dirty register groups sent since the last call
+  double avg_ms;                // average time from "dirty" until sent
+  double max_ms;                // maximum time from "dirty" until sent
+} P1_CC_DIAG;
+
+//
+// Target filling (msec) of the radio's TX FIFO held by the TX pacing
+//
+#define P1_TX_TARGET_MIN_MS      5
+#define P1_TX_TARGET_MAX_MS     60
+#define P1_TX_TARGET_DEFAULT_MS 30
+
+extern int p1_tx_target_ms;
+
+extern void old_protocol_set_tx_target(int ms);
+extern void old_protocol_get_tx_fifo(double *estimate_ms, double *reported_ms);
+extern void old_protocol_cc_dirty(unsigned int groups);
+extern void old_protocol_get_cc_diag(P1_CC_DIAG *diag);
+
 extern void old_protocol_stop(void);
 extern void old_protocol_run(void);
+extern void old_protocol_ddcs_changed(void);
 
 extern void old_protocol_init(int rate);
 extern void old_protocol_set_mic_sample_rate(int rate);
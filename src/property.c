@@ -24,14 +24,43 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 #include "property.h"
 #include "radio.h"
 #include "message.h"
 
-PROPERTY *properties = NULL;
+//
+// Properties are kept in a linked list (in the order they have been
+// read from the file or created) plus a hash table name -> PROPERTY,
+// such that getProperty/setProperty are O(1) and the file written
+// keeps a stable ordering.
+//
+static PROPERTY *properties = NULL;
+static PROPERTY *properties_tail = NULL;
+static GHashTable *property_index = NULL;
+
+//
+// saveProperties() only formats the file contents and hands them over
+// to a writer thread. The writer writes to a temporary file and renames
+// it to the final name, so the props file is never left truncated.
+// Jobs for the same file that have not yet been started are coalesced.
+//
+typedef struct {
+  char *filename;
+  GString *content;
+} SAVE_JOB;
+
+static GMutex save_mutex;
+static GCond save_cond;
+static GQueue save_jobs = G_QUEUE_INIT;
+static int save_busy = 0;
+static GThread *save_thread = NULL;
 
 void clearProperties(void) {
   PROPERTY *next;
+  if (property_index != NULL) {
+    g_hash_table_remove_all(property_index);
+  }
   while (properties != NULL) {
     next = properties->next_property;
     g_free(properties->name);
@@ -39,6 +68,85 @@ void clearProperties(void) {
     g_free(properties);
     properties = next;
   }
+  properties_tail = NULL;
+}
+
+static void appendProperty(const char *name, const char *value) {
+  PROPERTY *property = g_new(PROPERTY, 1);
+  property->name = g_strdup(name);
+  property->value = g_strdup(value);
+  property->next_property = NULL;
+  if (properties_tail) {
+    properties_tail->next_property = property;
+  } else {
+    properties = property;
+  }
+  properties_tail = property;
+  if (property_index == NULL) {
+    property_index = g_hash_table_new(g_str_hash, g_str_equal);
+  }
+  g_hash_table_insert(property_index, property->name, property);
+}
+
+static void writeProperties(const SAVE_JOB *job) {
+  char *tmpname = g_strdup_printf("%s.tmp", job->filename);
+  FILE *f = fopen(tmpname, "w");
+  gint64 start = g_get_monotonic_time();
+  if (!f) {
+    t_print("can't open %s\n", tmpname);
+    g_free(tmpname);
+    return;
+  }
+  if (fwrite(job->content->str, 1, job->content->len, f) != job->content->len ||
+      fflush(f) != 0 || fsync(fileno(f)) != 0) {
+    t_print("%s: write error on %s\n", __func__, tmpname);
+    fclose(f);
+    unlink(tmpname);
+    g_free(tmpname);
+    return;
+  }
+  fclose(f);
+  if (rename(tmpname, job->filename) != 0) {
+    t_perror("saveProperties rename");
+    unlink(tmpname);
+  }
+  g_free(tmpname);
+  l_print("%s: %s written in %.1f ms\n", __func__, job->filename,
+          (g_get_monotonic_time() - start) * 0.001);
+}
+
+static gpointer save_thread_func(gpointer data) {
+  for (;;) {
+    SAVE_JOB *job;
+    g_mutex_lock(&save_mutex);
+    while (save_jobs.length == 0) {
+      g_cond_wait(&save_cond, &save_mutex);
+    }
+    job = g_queue_pop_head(&save_jobs);
+    save_busy = 1;
+    g_mutex_unlock(&save_mutex);
+    writeProperties(job);
+    g_free(job->filename);
+    g_string_free(job->content, TRUE);
+    g_free(job);
+    g_mutex_lock(&save_mutex);
+    save_busy = 0;
+    g_cond_broadcast(&save_cond);
+    g_mutex_unlock(&save_mutex);
+  }
+  return NULL;
+}
+
+/* --------------------------------------------------------------------------*/
+/**
+* @brief Wait until all pending saves have been written
+*/
+void flushProperties(void) {
+  g_mutex_lock(&save_mutex);
+  while (save_jobs.length > 0 || save_busy) {
+    g_cond_wait(&save_cond, &save_mutex);
+  }
+  g_mutex_unlock(&save_mutex);
 }
 
 /* --------------------------------------------------------------------------*/
@@ -48,10 +156,14 @@ void clearProperties(void) {
 * @param filename
 */
 void loadProperties(const char *filename) {
-  FILE* f = fopen(filename, "r");
-  PROPERTY* property;
+  FILE* f;
   // t_print("loadProperties: %s\n", filename);
   int lines = 0;
+  //
+  // make sure a save to the same file is complete
+  //
+  flushProperties();
+  f = fopen(filename, "r");
   clearProperties();
   /////////////////////////////////////////////////////////////////////////////////////////
   //
@@ -90,11 +202,8 @@ void loadProperties(const char *filename) {
         value = strtok(NULL, "\n");
         // Beware of "illegal" lines in corrupted files
         if (name != NULL && value != NULL) {
-          property = malloc(sizeof(PROPERTY));
-          property->name = g_strdup(name);
-          property->value = g_strdup(value);
-          property->next_property = properties;
-          properties = property;
+          // if a name occurs twice, the last one wins
+          setProperty(name, value);
           if (strcmp(name, "property_version") == 0) {
             version = atof(value);
           }
@@ -117,22 +226,44 @@ void loadProperties(const char *filename) {
 * @param filename
 */
 void saveProperties(const char *filename) {
-  PROPERTY* property;
-  FILE* f = fopen(filename, "w+");
-  char line[512];
-  if (!f) {
-    t_print("can't open %s\n", filename);
-    return;
-  }
-  snprintf(line, 512, "%0.2f", PROPERTY_VERSION);
+  const PROPERTY* property;
+  GString *content = g_string_sized_new(65536);
+  char line[32];
+  snprintf(line, sizeof(line), "%0.2f", PROPERTY_VERSION);
   setProperty("property_version", line);
   property = properties;
   while (property) {
-    snprintf(line, 512, "%s=%s\n", property->name, property->value);
-    fwrite(line, 1, strlen(line), f);
+    g_string_append(content, property->name);
+    g_string_append_c(content, '=');
+    g_string_append(content, property->value);
+    g_string_append_c(content, '\n');
     property = property->next_property;
   }
-  fclose(f);
+  g_mutex_lock(&save_mutex);
+  if (save_thread == NULL) {
+    save_thread = g_thread_new("props writer", save_thread_func, NULL);
+    atexit(flushProperties);
+  }
+  //
+  // If a save to the same file is still waiting, just replace its contents
+  //
+  for (GList *l = save_jobs.head; l != NULL; l = l->next) {
+    SAVE_JOB *job = l->data;
+    if (strcmp(job->filename, filename) == 0) {
+      g_string_free(job->content, TRUE);
+      job->content = content;
+      content = NULL;
+      break;
+    }
+  }
+  if (content != NULL) {
+    SAVE_JOB *job = g_new(SAVE_JOB, 1);
+    job->filename = g_strdup(filename);
+    job->content = content;
+    g_queue_push_tail(&save_jobs, job);
+    g_cond_signal(&save_cond);
+  }
+  g_mutex_unlock(&save_mutex);
 }
 
 /* --------------------------------------------------------------------------*/
@@ -144,16 +275,12 @@ void saveProperties(const char *filename) {
 * @return
 */
 char *getProperty(const char *name) {
-  char *value = NULL;
-  PROPERTY* property = properties;
-  while (property) {
-    if (strcmp(name, property->name) == 0) {
-      value = property->value;
-      break;
-    }
-    property = property->next_property;
+  const PROPERTY* property;
+  if (property_index == NULL) {
+    return NULL;
   }
-  return value;
+  property = g_hash_table_lookup(property_index, name);
+  return property ? property->value : NULL;
 }
 
 /* --------------------------------------------------------------------------*/
@@ -164,12 +291,9 @@ char *getProperty(const char *name) {
 * @param value
 */
 void setProperty(const char *name, const char *value) {
-  PROPERTY* property = properties;
-  while (property) {
-    if (strcmp(name, property->name) == 0) {
-      break;
-    }
-    property = property->next_property;
+  PROPERTY* property = NULL;
+  if (property_index != NULL) {
+    property = g_hash_table_lookup(property_index, name);
   }
   if (property) {
     // just update
@@ -177,14 +301,18 @@ void setProperty(const char *name, const char *value) {
     property->value = g_strdup(value);
   } else {
     // new property
-    property = malloc(sizeof(PROPERTY));
-    property->name = g_strdup(name);
-    property->value = g_strdup(value);
-    property->next_property = properties;
-    properties = property;
+    appendProperty(name, value);
   }
 }
 
+/* --------------------------------------------------------------------------*/
+/**
+* @brief Number of properties currently held
+*/
+int countProperties(void) {
+  return property_index ? (int) g_hash_table_size(property_index) : 0;
+}
+
 //
 // Utility function myatof
 //
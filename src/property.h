@@ -37,6 +37,8 @@ extern void loadProperties(const char *filename);
 extern char *getProperty(const char *name);
 extern void setProperty(const char *name, const char *value);
 extern void saveProperties(const char *filename);
+extern void flushProperties(void);
+extern int countProperties(void);
 extern double myatof(const char *string);
 
 //
@@ -42,6 +42,7 @@ gboolean enable_stemlab;
 gboolean enable_usbozy;
 gboolean enable_saturn_xdma;
 gboolean autostart;
+gboolean fast_reconnect;
 
 static void protocolsSaveState(void) {
   clearProperties();
@@ -51,6 +52,7 @@ static void protocolsSaveState(void) {
   SetPropI0("enable_usbozy",         enable_usbozy);
   SetPropI0("enable_saturn_xdma",    enable_saturn_xdma);
   SetPropI0("autostart",             autostart);
+  SetPropI0("fast_reconnect",        fast_reconnect);
   saveProperties("protocols.props");
 }
 
@@ -65,12 +67,14 @@ void protocolsRestoreState(void) {
   enable_usbozy = TRUE;
   enable_saturn_xdma = TRUE;
   autostart = FALSE;
+  fast_reconnect = FALSE;
   GetPropI0("enable_protocol_1",     enable_protocol_1);
   GetPropI0("enable_protocol_2",     enable_protocol_2);
   GetPropI0("enable_stemlab",        enable_stemlab);
   GetPropI0("enable_usbozy",         enable_usbozy);
   GetPropI0("enable_saturn_xdma",    enable_saturn_xdma);
   GetPropI0("autostart",             autostart);
+  GetPropI0("fast_reconnect",        fast_reconnect);
   clearProperties();
 }
 
@@ -120,6 +124,10 @@ static void autostart_cb(GtkToggleButton *widget, gpointer data) {
   autostart = gtk_toggle_button_get_active(widget);
 }
 
+static void fast_reconnect_cb(GtkToggleButton *widget, gpointer data) {
+  fast_reconnect = gtk_toggle_button_get_active(widget);
+}
+
 void configure_protocols(GtkWidget *parent) {
   int row;
   dialog = gtk_dialog_new();
@@ -181,6 +189,14 @@ void configure_protocols(GtkWidget *parent) {
   gtk_widget_show(b_autostart);
   g_signal_connect(b_autostart, "toggled", G_CALLBACK(autostart_cb), NULL);
   gtk_grid_attach(GTK_GRID(grid), b_autostart, 0, row, 1, 1);
+  row++;
+  GtkWidget *b_fast_reconnect = gtk_check_button_new_with_label("Fast reconnect to last radio");
+  gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(b_fast_reconnect), fast_reconnect);
+  gtk_widget_set_tooltip_text(b_fast_reconnect, "At program start, probe the radio used last time\n"
+                                                "and start it as soon as it answers.");
+  gtk_widget_show(b_fast_reconnect);
+  g_signal_connect(b_fast_reconnect, "toggled", G_CALLBACK(fast_reconnect_cb), NULL);
+  gtk_grid_attach(GTK_GRID(grid), b_fast_reconnect, 0, row, 1, 1);
   gtk_container_add(GTK_CONTAINER(content), grid);
   gtk_widget_show_all(dialog);
   gtk_dialog_run(GTK_DIALOG(dialog));
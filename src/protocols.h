@@ -25,6 +25,7 @@ extern gboolean enable_saturn_xdma;
 extern gboolean enable_stemlab;
 extern gboolean enable_usbozy;
 extern gboolean autostart;
+extern gboolean fast_reconnect;
 
 extern void protocolsRestoreState(void);
 extern void configure_protocols(GtkWidget *parent);
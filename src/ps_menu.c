@@ -1072,6 +1072,9 @@ void ps_menu(GtkWidget *parent) {
     case 6:
       g_strlcpy(text, "sln.chk", 16);
       break;
+    case 8:
+      g_strlcpy(text, "calc.ms", 16);
+      break;
     case 13:
       g_strlcpy(text, "dg.cnt", 16);
       break;
@@ -31,6 +31,7 @@
 #include "mode.h"
 #include "vfo.h"
 #include "message.h"
+#include "thread_role.h"
 
 //
 // Used fixed buffer sizes.
@@ -486,6 +487,7 @@ int audio_open_output(RECEIVER *rx) {
 }
 
 static void *mic_read_thread(gpointer arg) {
+  thread_role_enter(THREAD_ROLE_AUDIO, "PA mic");
   int err;
   t_print("%s: running=%d\n", __func__, g_atomic_int_get(&running));
   while (g_atomic_int_get(&running)) {
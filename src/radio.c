@@ -76,6 +76,7 @@
 #include "tx_off.h"
 #include "rigctl.h"
 #include "rbn.h"
+#include "spotfeed.h"
 #include "tci.h"
 #include "ext.h"
 #include "radio_menu.h"
@@ -95,6 +96,7 @@
 #include "version.h"
 #include "exit_menu.h"
 #include "message.h"
+#include "notify_bus.h"
 
 #if defined(__APPLE__)
   static int dock_guard_pixels = 0;  // wird zur Laufzeit bestimmt
@@ -320,6 +322,7 @@ int set_locked(int state) {
   }
   locked = state;
   g_idle_add(ext_vfo_update, NULL);
+  notify_post(NOTIFY_LOCK);
   if (!tci_is_applying()) {
     tci_lock_changed();
   }
@@ -434,6 +437,9 @@ int n_adc = 1;
 
 int diversity_enabled = 0;
 int diversity_brick3_mode = 0;
+
+int rx_channelizer = 0;        // derive RX2 from the RX1 DDC stream
+int rx_channelizer_rate = 48000;
 double div_cos = 1.0;      // I factor for diversity
 double div_sin = 1.0;      // Q factor for diversity
 double div_gain = 0.0;     // gain for diversity (in dB)
@@ -1769,6 +1775,7 @@ void radio_start_radio(void) {
   if (tci_enable) {
     launch_tci();
   }
+  spotfeed_init();
   if (rbn_enabled) {
     rbn_start();
   }
@@ -1890,6 +1897,7 @@ void radio_change_receivers(int r) {
   }
   radio_reconfigure_screen();
   rx_set_active(receiver[0]);
+  rx_channelizer_update();
   schedule_high_priority();
   if (protocol == ORIGINAL_PROTOCOL) {
     old_protocol_run();
@@ -2138,6 +2146,7 @@ static void radio_set_mox_now(int state) {
   tune = 0;
   vox  = 0;
   update_slider_mic_gain_btn();
+  notify_post(NOTIFY_MOX | NOTIFY_TUNE);
   if (!tci_is_applying() && (!was_tune || state)) {
     tci_mox_changed(state);
   }
@@ -2390,6 +2399,9 @@ void radio_set_tune(int state) {
 #endif
     }
   }
+  if (tune_changed) {
+    notify_post(NOTIFY_TUNE | NOTIFY_MOX);
+  }
   if (tune_changed && !tci_is_applying()) {
     tci_tune_changed(state);
     tci_mox_changed(state);
@@ -2654,12 +2666,14 @@ void radio_set_split(int val) {
       tci_split_changed();
       tci_tx_frequency_changed();
     }
+    notify_post(NOTIFY_SPLIT);
     g_idle_add(ext_vfo_update, NULL);
     update_slider_split_btn();
   }
 }
 
 static void radio_restore_state(void) {
+  gint64 start = g_get_monotonic_time();
   t_print("%s: path=%s\n", __func__, property_path);
   g_mutex_lock(&property_mutex);
   /*
@@ -2742,8 +2756,12 @@ static void radio_restore_state(void) {
   GetPropI0("diversity_enabled",                             diversity_enabled);
   GetPropI0("diversity_brick3_mode",                         diversity_brick3_mode);
   diversity_brick3_mode = diversity_brick3_mode ? 1 : 0;
+  GetPropI0("rx_channelizer",                                rx_channelizer);
+  GetPropI0("rx_channelizer_rate",                           rx_channelizer_rate);
   GetPropI0("p2_jitter_buffer_enabled",                       p2_jitter_buffer_enabled);
   GetPropI0("p2_jitter_buffer_depth_ms",                      p2_jitter_buffer_depth_ms);
+  GetPropI0("p2_hp_window_us",                                p2_hp_window_us);
+  GetPropI0("p1_tx_target_ms",                                p1_tx_target_ms);
 #ifdef __APPLE__
   GetPropI0("rx_audio_network_reserve_enabled",                rx_audio_network_reserve_enabled);
   GetPropI0("rx_audio_network_reserve_ms",                     rx_audio_network_reserve_ms);
@@ -2758,6 +2776,10 @@ static void radio_restore_state(void) {
   if (p2_jitter_buffer_depth_ms > P2_JITTER_MAX_MS) {
     p2_jitter_buffer_depth_ms = P2_JITTER_MAX_MS;
   }
+  if (p2_hp_window_us < 0) { p2_hp_window_us = 0; }
+  if (p2_hp_window_us > P2_HP_WINDOW_MAX_US) { p2_hp_window_us = P2_HP_WINDOW_MAX_US; }
+  if (p1_tx_target_ms < P1_TX_TARGET_MIN_MS) { p1_tx_target_ms = P1_TX_TARGET_MIN_MS; }
+  if (p1_tx_target_ms > P1_TX_TARGET_MAX_MS) { p1_tx_target_ms = P1_TX_TARGET_MAX_MS; }
   GetPropF0("diversity_gain",                                div_gain);
   GetPropF0("diversity_phase",                               div_phase);
   GetPropF0("diversity_cos",                                 div_cos);
@@ -2974,10 +2996,13 @@ static void radio_restore_state(void) {
     radio_bgcolor = (cairo_rgba_t) { 0.00, 0.00, 0.00, 1.0 };
     mwin_bgcolor = (cairo_rgba_t) { 0.00, 0.00, 0.00, 1.0 };
   }
+  t_print("%s: %d properties restored in %.1f ms\n", __func__, countProperties(),
+          (g_get_monotonic_time() - start) * 0.001);
   g_mutex_unlock(&property_mutex);
 }
 
 void radio_save_state(void) {
+  gint64 start = g_get_monotonic_time();
   g_mutex_lock(&property_mutex);
   clearProperties();
   if (radio && radio->name[0] != '\0') {
@@ -3059,8 +3084,12 @@ void radio_save_state(void) {
   SetPropI0("enable_tx_inhibit",                             enable_tx_inhibit);
   SetPropI0("diversity_enabled",                             diversity_enabled);
   SetPropI0("diversity_brick3_mode",                         diversity_brick3_mode);
+  SetPropI0("rx_channelizer",                                rx_channelizer);
+  SetPropI0("rx_channelizer_rate",                           rx_channelizer_rate);
   SetPropI0("p2_jitter_buffer_enabled",                       p2_jitter_buffer_enabled);
   SetPropI0("p2_jitter_buffer_depth_ms",                      p2_jitter_buffer_depth_ms);
+  SetPropI0("p2_hp_window_us",                                p2_hp_window_us);
+  SetPropI0("p1_tx_target_ms",                                p1_tx_target_ms);
 #ifdef __APPLE__
   SetPropI0("rx_audio_network_reserve_enabled",                rx_audio_network_reserve_enabled);
   SetPropI0("rx_audio_network_reserve_ms",                     rx_audio_network_reserve_ms);
@@ -3228,14 +3257,18 @@ void radio_save_state(void) {
 #ifdef MIDI
   midiSaveState();
 #endif
+  //
+  // saveProperties() writes the files asynchronously (temp file + rename),
+  // so there is no need to sync() here.
+  //
   saveProperties(property_path);
-  sync();
   if (radio && radio->name[0] != '\0' && (protocol == ORIGINAL_PROTOCOL || protocol == NEW_PROTOCOL)) {
     snprintf(property_path_bak, sizeof(property_path_bak), "bak%d_%s_%s_%s", (int) backup_index, radio->name,
              inet_ntoa(radio->info.network.address.sin_addr), property_path);
     saveProperties(property_path_bak);
-    sync();
   }
+  t_print("%s: %d properties saved in %.1f ms\n", __func__, countProperties(),
+          (g_get_monotonic_time() - start) * 0.001);
   g_mutex_unlock(&property_mutex);
 }
 
@@ -3378,6 +3411,7 @@ static gpointer auto_tune_thread(gpointer data) {
   }
   usleep(50000);       // debouncing
   auto_tune_flag = 0;
+  notify_post(NOTIFY_ATU);
   return NULL;
 }
 
@@ -3389,6 +3423,7 @@ void radio_start_auto_tune(void) {
   }
   auto_tune_flag = 1;
   auto_tune_end  = 0;
+  notify_post(NOTIFY_ATU);
   tune_thread_id = g_thread_new("TUNE", auto_tune_thread, NULL);
 }
 
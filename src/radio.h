@@ -342,6 +342,8 @@ extern int n_adc;
 
 extern int diversity_enabled;
 extern int diversity_brick3_mode;
+extern int rx_channelizer;
+extern int rx_channelizer_rate;
 extern double div_cos, div_sin;
 extern double div_gain, div_phase;
 
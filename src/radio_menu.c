@@ -51,11 +51,18 @@ static GtkWidget *ChkBtn_txinhibit = NULL;
 static GtkWidget *ChkBtn_autotune = NULL;
 static gulong callsign_box_signal_id;
 static gulong locator_box_signal_id;
+static GtkWidget *tx_fifo_label = NULL;
+static guint tx_fifo_timer = 0;
 
 static void cleanup(void) {
   if (dialog != NULL) {
     GtkWidget *tmp = dialog;
     dialog = NULL;
+    if (tx_fifo_timer != 0) {
+      g_source_remove(tx_fifo_timer);
+      tx_fifo_timer = 0;
+    }
+    tx_fifo_label = NULL;
     gtk_widget_destroy(tmp);
     sub_menu = NULL;
     active_menu  = NO_MENU;
@@ -82,6 +89,27 @@ static void vfo_divisor_value_changed_cb(GtkWidget *widget, gpointer data) {
   vfo_encoder_divisor = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(widget));
 }
 
+static void tx_target_value_changed_cb(GtkWidget *widget, gpointer data) {
+  old_protocol_set_tx_target(gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(widget)));
+}
+
+static gboolean tx_fifo_update_cb(gpointer data) {
+  char text[64];
+  double estimate, reported;
+  if (tx_fifo_label == NULL) {
+    tx_fifo_timer = 0;
+    return G_SOURCE_REMOVE;
+  }
+  old_protocol_get_tx_fifo(&estimate, &reported);
+  if (reported >= 0.0) {
+    g_snprintf(text, sizeof(text), "FIFO %.1f ms (radio %.1f ms)", estimate, reported);
+  } else {
+    g_snprintf(text, sizeof(text), "FIFO %.1f ms (est.)", estimate);
+  }
+  gtk_label_set_text(GTK_LABEL(tx_fifo_label), text);
+  return G_SOURCE_CONTINUE;
+}
+
 //-------------------------------------------------------------------------------------
 static void capture_time_changed_cb(GtkWidget *widget, gpointer data) {
   int t = 0;
@@ -722,6 +750,33 @@ void radio_menu(GtkWidget *parent) {
   gtk_grid_attach(GTK_GRID(grid), vfo_divisor, 2, row, 1, 1);
   g_signal_connect(vfo_divisor, "value_changed", G_CALLBACK(vfo_divisor_value_changed_cb), NULL);
   row++;
+  if (protocol == ORIGINAL_PROTOCOL && can_transmit) {
+    label = gtk_label_new("TX Latency (ms):");
+    gtk_widget_set_name(label, "boldlabel");
+    gtk_widget_set_halign(label, GTK_ALIGN_END);
+    gtk_grid_attach(GTK_GRID(grid), label, 0, row, 2, 1);
+    GtkWidget *tx_target = gtk_spin_button_new_with_range(P1_TX_TARGET_MIN_MS, P1_TX_TARGET_MAX_MS, 1.0);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(tx_target), (double) p1_tx_target_ms);
+    gtk_widget_set_tooltip_text(tx_target,
+                                "Target filling of the radio's TX FIFO.\n"
+                                "The TX IQ packets are paced such that the FIFO\n"
+                                "holds this amount of audio. Lower values reduce\n"
+                                "the latency, higher values protect against underruns.\n"
+                                "The HL2 reports its FIFO filling, for other radios\n"
+                                "it is estimated.\n\n"
+                                "Default setting: 30 ms");
+    gtk_widget_set_hexpand(tx_target, FALSE);
+    gtk_widget_set_halign(tx_target, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(grid), tx_target, 2, row, 1, 1);
+    g_signal_connect(tx_target, "value_changed", G_CALLBACK(tx_target_value_changed_cb), NULL);
+    row++;
+    tx_fifo_label = gtk_label_new("");
+    gtk_widget_set_halign(tx_fifo_label, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(grid), tx_fifo_label, 2, row, 1, 1);
+    tx_fifo_update_cb(NULL);
+    tx_fifo_timer = g_timeout_add(250, tx_fifo_update_cb, NULL);
+    row++;
+  }
   // cppcheck-suppress knownConditionTrueFalse
   if (row > max_row) { max_row = row; }
   //
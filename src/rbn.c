@@ -22,6 +22,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <netdb.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -35,16 +36,35 @@
 #include "radio.h"
 #include "rbn.h"
 #include "rx_panadapter.h"
+#include "spotfeed.h"
 
+//
+// Network I/O, telnet decoding and line parsing run in a worker thread.
+// Accepted spots are handed to spotfeed_push(), which batches them for
+// the GTK thread.
+//
+// If the RBN address has the form "file:<path>", no connection is made
+// and the lines of that (recorded) file are replayed instead, at a rate
+// of RBN_REPLAY_LINES_PER_SEC. This is for testing the spot pipeline
+// under contest load without network access.
+//
+// The worker may be blocked in getaddrinfo() or connect() for a long
+// time, so rbn_stop() does not join it: it clears 'running' and detaches
+// the thread, which then frees its context when it notices the flag.
+//
 #define RBN_RECONNECT_SECONDS 30
+#define RBN_POLL_MS 200
+#define RBN_REPLAY_PREFIX "file:"
+#define RBN_REPLAY_LINES_PER_SEC 200
 
 typedef struct {
   telnet_t       *telnet;
   int             sockfd;
-  GIOChannel     *gio;
-  guint           io_watch_id;
-  guint           reconnect_id;
   GString        *linebuf;
+  GThread        *thread;
+  gint            running;
+  char            address[64];
+  long int        port;
 } RbnCtx;
 
 static RbnCtx *g_rbn_ctx = NULL;
@@ -57,8 +77,6 @@ static const telnet_telopt_t rbn_telopts[] = {
   { -1, 0, 0 }
 };
 
-static gboolean rbn_reconnect_cb(gpointer data);
-
 static const char *rbn_login_call(void) {
   if (dxc_login[0] != '\0' && strcmp(dxc_login, "YOUR_CALLSIGN") != 0) {
     return dxc_login;
@@ -188,7 +206,7 @@ static void rbn_process_line(const char *line) {
     return;
   }
   // t_print("RBN: spot %s %.1f kHz %s\n", mode, freq_khz, dxcall);
-  pan_add_dx_spot_source(freq_khz, dxcall, PAN_SPOT_SOURCE_RBN);
+  spotfeed_push(freq_khz, dxcall, PAN_SPOT_SOURCE_RBN);
 }
 
 static void rbn_feed_parser(RbnCtx *ctx, const char *data, size_t len) {
@@ -208,49 +226,6 @@ static void rbn_feed_parser(RbnCtx *ctx, const char *data, size_t len) {
   }
 }
 
-static void rbn_schedule_reconnect(RbnCtx *ctx) {
-  if (!ctx || !rbn_enabled || ctx->reconnect_id != 0) {
-    return;
-  }
-  t_print("RBN: reconnect scheduled in %d seconds\n", RBN_RECONNECT_SECONDS);
-  ctx->reconnect_id = g_timeout_add_seconds(RBN_RECONNECT_SECONDS, rbn_reconnect_cb, NULL);
-}
-
-void rbn_stop(void) {
-  RbnCtx *ctx = g_rbn_ctx;
-  if (!ctx) {
-    return;
-  }
-  if (ctx->reconnect_id != 0) {
-    g_source_remove(ctx->reconnect_id);
-    ctx->reconnect_id = 0;
-  }
-  if (ctx->gio) {
-    if (ctx->io_watch_id != 0) {
-      g_source_remove(ctx->io_watch_id);
-      ctx->io_watch_id = 0;
-    }
-    g_io_channel_shutdown(ctx->gio, TRUE, NULL);
-    g_io_channel_unref(ctx->gio);
-    ctx->gio = NULL;
-  }
-  if (ctx->telnet) {
-    telnet_free(ctx->telnet);
-    ctx->telnet = NULL;
-  }
-  if (ctx->sockfd >= 0) {
-    close(ctx->sockfd);
-    ctx->sockfd = -1;
-  }
-  if (ctx->linebuf) {
-    g_string_free(ctx->linebuf, TRUE);
-    ctx->linebuf = NULL;
-  }
-  g_free(ctx);
-  g_rbn_ctx = NULL;
-  t_print("RBN: stopped\n");
-}
-
 static int rbn_connect_tcp(const char *host, long int port) {
   struct addrinfo hints;
   struct addrinfo *res = NULL;
@@ -309,37 +284,130 @@ static void rbn_telnet_event_handler(telnet_t *telnet, telnet_event_t *ev, void
   }
 }
 
-static gboolean rbn_socket_cb(GIOChannel *source, GIOCondition cond, gpointer data) {
-  (void) source;
-  RbnCtx *ctx = (RbnCtx *) data;
-  if (!ctx) {
-    return FALSE;
+//
+// Sleep for the given number of seconds, but return early if the
+// worker thread is to be stopped
+//
+static void rbn_wait(RbnCtx *ctx, int seconds) {
+  for (int i = 0; i < seconds * 10 && g_atomic_int_get(&ctx->running); i++) {
+    g_usleep(100000);
   }
-  if (cond & (G_IO_HUP | G_IO_ERR | G_IO_NVAL)) {
-    t_print("RBN: socket closed or error, reconnecting\n");
-    rbn_stop();
-    if (rbn_enabled) {
-      rbn_start();
-    }
-    return FALSE;
+}
+
+static void rbn_disconnect(RbnCtx *ctx) {
+  if (ctx->telnet) {
+    telnet_free(ctx->telnet);
+    ctx->telnet = NULL;
   }
-  if (cond & G_IO_IN) {
-    char buf[4096];
-    ssize_t n = recv(ctx->sockfd, buf, sizeof(buf), 0);
-    if (n > 0) {
-      telnet_recv(ctx->telnet, buf, (size_t) n);
-      return TRUE;
+  if (ctx->sockfd >= 0) {
+    close(ctx->sockfd);
+    ctx->sockfd = -1;
+  }
+  g_string_truncate(ctx->linebuf, 0);
+}
+
+static void rbn_replay(RbnCtx *ctx, const char *path) {
+  FILE *f = fopen(path, "r");
+  char line[512];
+  unsigned long lines = 0;
+  SPOTFEED_STATS st;
+  if (f == NULL) {
+    t_print("RBN: cannot open replay file %s: %s\n", path, g_strerror(errno));
+    return;
+  }
+  t_print("RBN: replaying %s\n", path);
+  spotfeed_reset_stats();
+  while (g_atomic_int_get(&ctx->running) && fgets(line, sizeof(line), f)) {
+    rbn_feed_parser(ctx, line, strlen(line));
+    lines++;
+    g_usleep(1000000 / RBN_REPLAY_LINES_PER_SEC);
+  }
+  fclose(f);
+  spotfeed_get_stats(&st);
+  t_print("RBN: replay done, lines=%lu received=%lu filtered=%lu dupes=%lu overflow=%lu displayed=%lu\n",
+          lines, st.received, st.filtered, st.duplicates, st.overflow, st.displayed);
+}
+
+static void rbn_free(RbnCtx *ctx) {
+  rbn_disconnect(ctx);
+  g_string_free(ctx->linebuf, TRUE);
+  g_free(ctx);
+}
+
+static gpointer rbn_thread(gpointer data) {
+  RbnCtx *ctx = (RbnCtx *) data;
+  char buf[4096];
+  if (g_str_has_prefix(ctx->address, RBN_REPLAY_PREFIX)) {
+    rbn_replay(ctx, ctx->address + strlen(RBN_REPLAY_PREFIX));
+    rbn_free(ctx);
+    return NULL;
+  }
+  while (g_atomic_int_get(&ctx->running)) {
+    t_print("RBN: connecting to %s:%ld\n", ctx->address, ctx->port);
+    ctx->sockfd = rbn_connect_tcp(ctx->address, ctx->port);
+    if (ctx->sockfd < 0) {
+      t_print("RBN: reconnect scheduled in %d seconds\n", RBN_RECONNECT_SECONDS);
+      rbn_wait(ctx, RBN_RECONNECT_SECONDS);
+      continue;
+    }
+    ctx->telnet = telnet_init(rbn_telopts, rbn_telnet_event_handler, 0, ctx);
+    if (!ctx->telnet) {
+      t_print("RBN: telnet_init failed\n");
+      rbn_disconnect(ctx);
+      rbn_wait(ctx, RBN_RECONNECT_SECONDS);
+      continue;
     }
-    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
-      t_print("RBN: recv() failed or remote closed connection, reconnecting\n");
-      rbn_stop();
-      if (rbn_enabled) {
-        rbn_start();
+    const char *login = rbn_login_call();
+    t_print("RBN: connected to %s:%ld, login %s\n", ctx->address, ctx->port, login);
+    char cmd[64];
+    snprintf(cmd, sizeof(cmd), "%s\n", login);
+    telnet_send(ctx->telnet, cmd, strlen(cmd));
+    while (g_atomic_int_get(&ctx->running)) {
+      struct pollfd pfd;
+      pfd.fd = ctx->sockfd;
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      int rc = poll(&pfd, 1, RBN_POLL_MS);
+      if (rc == 0 || (rc < 0 && errno == EINTR)) {
+        continue;
+      }
+      if (rc < 0 || (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) {
+        t_print("RBN: socket closed or error, reconnecting\n");
+        break;
+      }
+      ssize_t n = recv(ctx->sockfd, buf, sizeof(buf), 0);
+      if (n > 0) {
+        telnet_recv(ctx->telnet, buf, (size_t) n);
+        continue;
       }
-      return FALSE;
+      if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+        t_print("RBN: recv() failed or remote closed connection, reconnecting\n");
+        break;
+      }
+    }
+    rbn_disconnect(ctx);
+    if (g_atomic_int_get(&ctx->running)) {
+      rbn_wait(ctx, 1);
     }
   }
-  return TRUE;
+  rbn_free(ctx);
+  return NULL;
+}
+
+void rbn_stop(void) {
+  RbnCtx *ctx = g_rbn_ctx;
+  if (!ctx) {
+    return;
+  }
+  //
+  // Once 'running' is cleared, the context belongs to the worker thread
+  // and must no longer be touched here
+  //
+  GThread *thread = ctx->thread;
+  g_rbn_ctx = NULL;
+  g_atomic_int_set(&ctx->running, 0);
+  g_thread_unref(thread);
+  t_print("RBN: stopped\n");
 }
 
 void rbn_start(void) {
@@ -350,36 +418,14 @@ void rbn_start(void) {
   if (g_rbn_ctx != NULL) {
     return;
   }
-  t_print("RBN: connecting to %s:%ld\n", rbn_address, rbn_port);
   RbnCtx *ctx = g_new0(RbnCtx, 1);
   ctx->sockfd = -1;
   ctx->linebuf = g_string_new(NULL);
-  ctx->sockfd = rbn_connect_tcp(rbn_address, rbn_port);
-  if (ctx->sockfd < 0) {
-    g_rbn_ctx = ctx;
-    rbn_schedule_reconnect(ctx);
-    return;
-  }
-  ctx->telnet = telnet_init(rbn_telopts, rbn_telnet_event_handler, 0, ctx);
-  if (!ctx->telnet) {
-    t_print("RBN: telnet_init failed\n");
-    g_rbn_ctx = ctx;
-    rbn_schedule_reconnect(ctx);
-    return;
-  }
-  ctx->gio = g_io_channel_unix_new(ctx->sockfd);
-  g_io_channel_set_encoding(ctx->gio, NULL, NULL);
-  g_io_channel_set_buffered(ctx->gio, FALSE);
-  ctx->io_watch_id = g_io_add_watch(ctx->gio,
-                                    G_IO_IN | G_IO_HUP | G_IO_ERR | G_IO_NVAL,
-                                    rbn_socket_cb,
-                                    ctx);
+  g_atomic_int_set(&ctx->running, 1);
+  g_strlcpy(ctx->address, rbn_address, sizeof(ctx->address));
+  ctx->port = rbn_port;
   g_rbn_ctx = ctx;
-  const char *login = rbn_login_call();
-  t_print("RBN: connected to %s:%ld, login %s\n", rbn_address, rbn_port, login);
-  char cmd[64];
-  snprintf(cmd, sizeof(cmd), "%s\n", login);
-  telnet_send(ctx->telnet, cmd, strlen(cmd));
+  ctx->thread = g_thread_new("RBN", rbn_thread, ctx);
 }
 
 void rbn_update_from_settings(void) {
@@ -391,16 +437,3 @@ void rbn_update_from_settings(void) {
     rbn_stop();
   }
 }
-
-static gboolean rbn_reconnect_cb(gpointer data) {
-  (void) data;
-  if (g_rbn_ctx) {
-    g_rbn_ctx->reconnect_id = 0;
-  }
-  rbn_stop();
-  if (rbn_enabled) {
-    t_print("RBN: reconnecting\n");
-    rbn_start();
-  }
-  return FALSE;
-}
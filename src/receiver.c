@@ -23,6 +23,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <wdsp.h>
 
@@ -31,8 +32,10 @@
 #include "band.h"
 #include "bandstack.h"
 #include "channel.h"
+#include "channelizer.h"
 #include "discovered.h"
 #include "filter.h"
+#include "iq_record.h"
 #include "main.h"
 #include "meter.h"
 #include "mode.h"
@@ -43,6 +46,7 @@
 #include "vfo.h"
 #include "meter.h"
 #include "rx_panadapter.h"
+#include "rx_render.h"
 #include "zoompan.h"
 #include "sliders.h"
 #include "waterfall.h"
@@ -53,6 +57,7 @@
 #include "message.h"
 #include "tci.h"
 #include "tci_audio.h"
+#include "notify_bus.h"
 
 #define min(x,y) (x<y?x:y)
 #define max(x,y) (x<y?y:x)
@@ -76,6 +81,8 @@ static void rx_cw_zero_beat_reset(RECEIVER *rx);
 static void rx_cw_zero_beat_sample(RECEIVER *rx, double sample);
 static gboolean rx_diversity_rx_active(void);
 static int rx_diversity_effective_vfo_id(const RECEIVER *rx);
+static int rx_channelizer_effective_sample_rate(const RECEIVER *rx, int sample_rate);
+static void rx_route_iq_samples(RECEIVER *rx, double i_sample, double q_sample);
 
 long long rx_get_mode_dc_offset(int id) {
   switch (vfo[id].mode) {
@@ -141,6 +148,7 @@ void rx_set_active(RECEIVER *rx) {
   // Make rx the new active receiver
   //
   active_receiver = rx;
+  notify_post(NOTIFY_ACTIVE_RX);
   g_idle_add(menu_active_receiver_changed, NULL);
   g_idle_add(ext_vfo_update, NULL);
   g_idle_add(zoompan_active_receiver_changed, NULL);
@@ -612,12 +620,19 @@ typedef struct {
   gint64 total_us;
   gint64 max_us;
   guint late;
+  guint render_frames;
+  gint64 render_total_us;
+  gint64 render_max_us;
 } RX_DISPLAY_DEBUG_STATS;
 
 /* RX1 and RX2 only; PureSignal feedback receivers are intentionally excluded. */
 static RX_DISPLAY_DEBUG_STATS rx_display_debug_stats[2];
 
-static void rx_display_debug_update(RECEIVER *rx, gint64 elapsed_us, int rendered) {
+//
+// elapsed_us is the time spent on the GTK thread, render_us the time the
+// render worker needed for the frame drawn (0 if drawn on the GTK thread).
+//
+static void rx_display_debug_update(RECEIVER *rx, gint64 elapsed_us, int rendered, gint64 render_us) {
   if (rx->id < 0 || (guint) rx->id >= G_N_ELEMENTS(rx_display_debug_stats)) {
     return;
   }
@@ -632,6 +647,13 @@ static void rx_display_debug_update(RECEIVER *rx, gint64 elapsed_us, int rendere
   if (elapsed_us > stats->max_us) {
     stats->max_us = elapsed_us;
   }
+  if (render_us > 0) {
+    stats->render_frames++;
+    stats->render_total_us += render_us;
+    if (render_us > stats->render_max_us) {
+      stats->render_max_us = render_us;
+    }
+  }
   gint64 frame_budget_us = rx->fps > 0 ? 1000000LL / rx->fps : 0;
   if (frame_budget_us > 0 && elapsed_us > frame_budget_us) {
     stats->late++;
@@ -645,8 +667,13 @@ static void rx_display_debug_update(RECEIVER *rx, gint64 elapsed_us, int rendere
     double max_ms = (double) stats->max_us / 1000.0;
     double load = frame_budget_us > 0 ? 100.0 * ((double) stats->total_us / stats->calls) / frame_budget_us : 0.0;
     double peak = frame_budget_us > 0 ? 100.0 * stats->max_us / frame_budget_us : 0.0;
-    t_print("DISPLAY RX%d cfg=%d fps actual=%.1f rendered=%.1f avg=%.2f ms max=%.2f ms load=%.1f%% peak=%.1f%% late=%u/%u\n",
-            rx->id + 1, rx->fps, actual_fps, rendered_fps, avg_ms, max_ms, load, peak, stats->late, stats->calls);
+    double render_avg_ms = stats->render_frames > 0
+                           ? (double) stats->render_total_us / (1000.0 * stats->render_frames) : 0.0;
+    double render_max_ms = (double) stats->render_max_us / 1000.0;
+    t_print("DISPLAY RX%d cfg=%d fps actual=%.1f rendered=%.1f avg=%.2f ms max=%.2f ms load=%.1f%% peak=%.1f%% late=%u/%u"
+            " worker avg=%.2f ms max=%.2f ms\n",
+            rx->id + 1, rx->fps, actual_fps, rendered_fps, avg_ms, max_ms, load, peak, stats->late, stats->calls,
+            render_avg_ms, render_max_ms);
     *stats = (RX_DISPLAY_DEBUG_STATS) {0};
     stats->window_start_us = now_us;
   }
@@ -658,8 +685,15 @@ static int rx_update_display(gpointer data) {
   if (rx->displaying) {
     if (rx->pixels > 0) {
       int rc;
+      gint64 render_us;
       g_mutex_lock(&rx->display_mutex);
-      rc = rx_get_pixels(rx);
+      //
+      // RX1/RX2: analyzer data, spectrum trace and waterfall row come from
+      // the render worker, only the rest is drawn here
+      //
+      if (!rx_render_fetch(rx, &rc, &render_us)) {
+        rc = rx_get_pixels(rx);
+      }
       if (rc) {
         if (rx->display_panadapter) {
           rx_panadapter_update(rx);
@@ -669,6 +703,7 @@ static int rx_update_display(gpointer data) {
         }
       }
       g_mutex_unlock(&rx->display_mutex);
+      rx_render_post(rx);
       if (active_receiver == rx) {
         //
         // since rx->meter is used in other places as well (e.g. rigctl),
@@ -691,7 +726,7 @@ static int rx_update_display(gpointer data) {
         meter_update(rx, SMETER, rx->meter, 0.0, 0.0);
       }
       if (display_debug) {
-        rx_display_debug_update(rx, g_get_monotonic_time() - debug_start_us, rc);
+        rx_display_debug_update(rx, g_get_monotonic_time() - debug_start_us, rc, render_us);
       }
       return TRUE;
     }
@@ -1094,6 +1129,7 @@ RECEIVER *rx_create_receiver(int id, int pixels, int width, int height) {
 void rx_change_adc(const RECEIVER *rx) {
   schedule_high_priority();
   schedule_receive_specific();
+  rx_channelizer_update();
 }
 
 void rx_set_frequency(RECEIVER *rx, long long f) {
@@ -1180,17 +1216,21 @@ void rx_frequency_changed(RECEIVER *rx) {
   // and send the (possibly changed) frequency to the radio in any case.
   //
   rx_set_offset(rx, vfo[id].offset - rx_get_mode_dc_offset(id) + rx_get_digi_monitor_offset(id));
-  switch (protocol) {
-  case ORIGINAL_PROTOCOL:
-    // P1 does this automatically
-    break;
-  case NEW_PROTOCOL:
-    schedule_high_priority(); // send new frequency
-    break;
-  }
+  //
+  // For P1, this marks the frequency C&C registers dirty such that they
+  // are sent before the round-robin arrives there.
+  //
+  schedule_high_priority(); // send new frequency
   if (rx_diversity_rx_active() && rx_id == 0 && receivers > 1 && receiver[1] != NULL) {
     rx_frequency_changed(receiver[1]);
   }
+  rx_channelizer_update();
+  //
+  // Every frequency change ends up here, so subscribers (TCI, CAT
+  // auto-reporting, spot feed) learn about all of them, including the
+  // ones not made through the vfo_* functions (CW zero-beat, XVTR)
+  //
+  notify_post_from(NOTIFY_VFO_FREQ(id) | NOTIFY_TX_FREQ, tci_is_applying() ? NOTIFY_ORIGIN_TCI : NOTIFY_ORIGIN_NONE);
 }
 
 void rx_filter_changed(RECEIVER *rx) {
@@ -1214,6 +1254,7 @@ void rx_mode_changed(RECEIVER *rx) {
     rx_set_mode(receiver[1]);
   }
   rx_filter_changed(rx);
+  rx_channelizer_update();
 }
 
 void rx_vfo_changed(RECEIVER *rx) {
@@ -1260,6 +1301,153 @@ static void rx_diversity_sync_aux_receiver_sample_rate(const RECEIVER *rx) {
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////
+//
+// Channelizer mode: RX2 is derived from the RX1 DDC stream.
+//
+// If enabled (and RX1/RX2 use the same ADC, no diversity), the WDSP channel
+// of RX2 is fed by a channel of the shared FFT channelizer (channelizer.c),
+// centered at the RX2 DDC frequency and running at rx_channelizer_rate
+// (at most the RX1 sample rate). RX2 then needs no DDC of its own, and
+// with P1 the radio only sends the RX1 stream.
+//
+//////////////////////////////////////////////////////////////////////////////////////
+
+#define RX_CHANNELIZER_SIZE 4096
+
+static CHANNELIZER *rx_channelizer_ch = NULL;
+static int rx_channelizer_id = -1;
+static int rx_channelizer_on = 0;       // RX2 is fed by the channelizer
+static int rx_channelizer_valid = 1;
+
+int rx_channelizer_active(void) {
+  return rx_channelizer && receivers > 1 && !diversity_enabled && receiver[0] != NULL && receiver[1] != NULL
+         && receiver[0]->adc == receiver[1]->adc;
+}
+
+//
+// Whether RX2 is currently derived from the RX1 stream. This is not the
+// case while RX2 is outside the RX1 band, then it uses its own DDC.
+//
+int rx_channelizer_running(void) {
+  return g_atomic_int_get(&rx_channelizer_on);
+}
+
+static int rx_channelizer_output_rate(void) {
+  int rate = rx_channelizer_rate;
+  while (rate > 48000 && rate > receiver[0]->sample_rate) {
+    rate /= 2;
+  }
+  return rate;
+}
+
+static int rx_channelizer_effective_sample_rate(const RECEIVER *rx, int sample_rate) {
+  if (rx != NULL && rx->id == 1 && rx_channelizer && !diversity_enabled && receiver[0] != NULL
+      && receiver[0]->adc == rx->adc) {
+    //
+    // With P1, all DDCs run at the same rate. Outside the RX1 band, RX2
+    // thus falls back to a DDC at the RX1 rate.
+    //
+    if (protocol == ORIGINAL_PROTOCOL && !rx_channelizer_valid) {
+      return sample_rate;
+    }
+    return rx_channelizer_output_rate();
+  }
+  return sample_rate;
+}
+
+static long long rx_ddc_frequency(int id) {
+  //
+  // Same as the DDC frequency sent to the radio by the protocol modules
+  //
+  long long f = vfo[id].frequency + rx_get_mode_dc_offset(id);
+  if (vfo[id].mode == modeCWU) {
+    f -= (long long) cw_keyer_sidetone_frequency;
+  } else if (vfo[id].mode == modeCWL) {
+    f += (long long) cw_keyer_sidetone_frequency;
+  }
+  return apply_ppm_ll(f - vfo[id].lo);
+}
+
+static void rx_channelizer_sink(void *arg, double i_sample, double q_sample) {
+  rx_route_iq_samples((RECEIVER *) arg, i_sample, q_sample);
+}
+
+void rx_channelizer_update(void) {
+  RECEIVER *rx1 = receiver[0];
+  RECEIVER *rx2 = receiver[1];
+  if (rx1 == NULL || rx2 == NULL) {
+    return;
+  }
+  //
+  // RX2 runs at the channelizer rate, or (P1 only) at the RX1 rate
+  // once the channelizer is switched off.
+  //
+  int rate = protocol == ORIGINAL_PROTOCOL ? rx1->sample_rate : rx2->sample_rate;
+  rate = rx_diversity_effective_sample_rate(rx2, rate);
+  rate = rx_channelizer_effective_sample_rate(rx2, rate);
+  if (rate != rx2->sample_rate) {
+    rx_change_sample_rate(rx2, rate);   // calls us again
+    return;
+  }
+  int running = 0;
+  if (rx_channelizer_active()) {
+    if (rx_channelizer_ch == NULL) {
+      rx_channelizer_ch = channelizer_create(RX_CHANNELIZER_SIZE);
+      rx_channelizer_id = channelizer_attach(rx_channelizer_ch, rx_channelizer_sink, rx2);
+    }
+    long long offset = rx_ddc_frequency(rx2->id) - rx_ddc_frequency(rx1->id);
+    int valid = channelizer_configure(rx_channelizer_ch, rx_channelizer_id, rx1->sample_rate,
+                                      rx_channelizer_output_rate(), (double) offset) == 0;
+    if (valid != rx_channelizer_valid) {
+      t_print("%s: RX2 offset %lld Hz %s the RX1 band\n", __func__, offset, valid ? "inside" : "outside");
+      rx_channelizer_valid = valid;
+      //
+      // With P1, this switches RX2 between the channelizer rate and the RX1 rate
+      //
+      rate = rx_channelizer_effective_sample_rate(rx2, rx1->sample_rate);
+      if (rate != rx2->sample_rate) {
+        rx_change_sample_rate(rx2, rate);   // calls us again
+        return;
+      }
+    }
+    //
+    // If RX2 is outside the RX1 band, fall back to the RX2 DDC stream
+    // rather than feeding RX2 with silence from the channelizer.
+    //
+    running = valid;
+  }
+  if (running != g_atomic_int_get(&rx_channelizer_on)) {
+    g_atomic_int_set(&rx_channelizer_on, running);
+    //
+    // With P1 the radio sends the RX2 DDC stream only if it is needed
+    //
+    if (protocol == ORIGINAL_PROTOCOL) {
+      old_protocol_ddcs_changed();
+    }
+  }
+}
+
+void rx_set_channelizer(int enable) {
+  //
+  // With P1 this changes the number of DDCs, so restart the protocol
+  //
+  int restart = (protocol == ORIGINAL_PROTOCOL && receivers > 1);
+  if (restart) {
+    old_protocol_stop();
+  }
+  rx_channelizer = enable;
+  rx_channelizer_update();
+  if (restart) {
+    old_protocol_run();
+  }
+}
+
+void rx_set_channelizer_rate(int rate) {
+  rx_channelizer_rate = rate;
+  rx_channelizer_update();
+}
+
 static void rx_cw_zero_beat_reset(RECEIVER *rx) {
   rx->cw_zero_beat_active = 0;
   rx->cw_zero_beat_count = 0;
@@ -1572,7 +1760,45 @@ static void rx_apply_iq_correction(const RECEIVER *rx, double *i_sample, double
   *q_sample = ((q * gain) + (i * s)) / c;
 }
 
+static void rx_route_iq_samples(RECEIVER *rx, double i_sample, double q_sample) {
+  //
+  // Hook for IQ capture/replay: while replaying a capture, live samples
+  // are dropped (the replay thread calls rx_feed_iq_samples).
+  //
+  switch (g_atomic_int_get(&iq_record_flags)) {
+  case IQREC_RECORDING:
+    iq_record_sample(rx, i_sample, q_sample);
+    break;
+  case IQREC_REPLAYING:
+    return;
+  default:
+    break;
+  }
+  rx_feed_iq_samples(rx, i_sample, q_sample);
+}
+
 void rx_add_iq_samples(RECEIVER *rx, double i_sample, double q_sample) {
+  //
+  // iq_record_feeders counts the protocol threads in here, such that
+  // IQ capture/replay can wait for them when changing state.
+  //
+  g_atomic_int_inc(&iq_record_feeders);
+  //
+  // With the channelizer running, RX2 is derived from the RX1 stream,
+  // and RX2 samples from the radio (if any) are dropped.
+  //
+  if (rx->id < 2 && g_atomic_int_get(&rx_channelizer_on) && !diversity_enabled) {
+    if (rx->id == 0) {
+      channelizer_add(rx_channelizer_ch, i_sample, q_sample);
+      rx_route_iq_samples(rx, i_sample, q_sample);
+    }
+  } else {
+    rx_route_iq_samples(rx, i_sample, q_sample);
+  }
+  g_atomic_int_dec_and_test(&iq_record_feeders);
+}
+
+void rx_feed_iq_samples(RECEIVER *rx, double i_sample, double q_sample) {
   //
   // At the end of a TX/RX transition, txrxcount is set to zero,
   // and txrxmax to some suitable value.
@@ -1600,6 +1826,55 @@ void rx_add_iq_samples(RECEIVER *rx, double i_sample, double q_sample) {
   }
 }
 
+void rx_add_iq_block(RECEIVER *rx, const double *iq, int n) {
+  //
+  // Block version of rx_add_iq_samples. If any of the per-sample hooks
+  // (capture/replay, channelizer, TX/RX silencing) is active, the samples
+  // take the per-sample path. Otherwise they are copied into the input
+  // buffer in chunks, with the IQ correction factors computed once.
+  //
+  g_atomic_int_inc(&iq_record_feeders);
+  if (g_atomic_int_get(&iq_record_flags) != IQREC_IDLE || rx->txrxcount < rx->txrxmax ||
+      (rx->id < 2 && g_atomic_int_get(&rx_channelizer_on) && !diversity_enabled)) {
+    for (int i = 0; i < n; i++) {
+      rx_add_iq_samples(rx, iq[2 * i], iq[2 * i + 1]);
+    }
+    g_atomic_int_dec_and_test(&iq_record_feeders);
+    return;
+  }
+  int correct = (rx->rx_iq_gain != 0.0 || rx->rx_iq_phase != 0.0);
+  double gain = 1.0;
+  double c = 1.0;
+  double s = 0.0;
+  if (correct) {
+    gain = pow(10.0, rx->rx_iq_gain / 20.0);
+    c = cos(rx->rx_iq_phase * M_PI / 180.0);
+    s = sin(rx->rx_iq_phase * M_PI / 180.0);
+    correct = fabs(c) >= 1.0e-12;
+  }
+  while (n > 0) {
+    int k = rx->buffer_size - rx->samples;
+    if (k > n) { k = n; }
+    double *dst = &rx->iq_input_buffer[rx->samples * 2];
+    if (correct) {
+      for (int i = 0; i < k; i++) {
+        dst[2 * i] = iq[2 * i];
+        dst[2 * i + 1] = ((iq[2 * i + 1] * gain) + (iq[2 * i] * s)) / c;
+      }
+    } else {
+      memcpy(dst, iq, 2 * k * sizeof(double));
+    }
+    rx->samples += k;
+    iq += 2 * k;
+    n -= k;
+    if (rx->samples >= rx->buffer_size) {
+      rx_full_buffer(rx);
+      rx->samples = 0;
+    }
+  }
+  g_atomic_int_dec_and_test(&iq_record_feeders);
+}
+
 void rx_add_div_iq_samples(RECEIVER *rx, double i0, double q0, double i1, double q1) {
   //
   // Note that we sum the second channel onto the first one
@@ -1709,6 +1984,7 @@ void rx_change_sample_rate(RECEIVER *rx, int sample_rate) {
   // ToDo: move this outside of the WDSP wrappers and encapsulate WDSP calls
   //       in this function
   sample_rate = rx_diversity_effective_sample_rate(rx, sample_rate);
+  sample_rate = rx_channelizer_effective_sample_rate(rx, sample_rate);
   if (rx != NULL && rx->sample_rate == sample_rate) {
     rx_diversity_sync_aux_receiver_sample_rate(rx);
     return;
@@ -1764,6 +2040,7 @@ void rx_change_sample_rate(RECEIVER *rx, int sample_rate) {
   t_print("%s: RXid=%d rate=%d buffer_size=%d output_samples=%d\n", __func__, rx->id, rx->sample_rate,
           rx->buffer_size, rx->output_samples);
   rx_diversity_sync_aux_receiver_sample_rate(rx);
+  rx_channelizer_update();
 }
 
 void rx_close(const RECEIVER *rx) {
@@ -348,6 +348,13 @@ extern gboolean rx_motion_notify_event(GtkWidget *widget, GdkEventMotion *event,
 extern gboolean rx_scroll_event(GtkWidget *widget, const GdkEventScroll *event, gpointer data);
 
 extern void   rx_add_iq_samples(RECEIVER *rx, double i_sample, double q_sample);
+extern void   rx_feed_iq_samples(RECEIVER *rx, double i_sample, double q_sample);
+extern void   rx_add_iq_block(RECEIVER *rx, const double *iq, int n);
+extern int    rx_channelizer_active(void);
+extern int    rx_channelizer_running(void);
+extern void   rx_channelizer_update(void);
+extern void   rx_set_channelizer(int enable);
+extern void   rx_set_channelizer_rate(int rate);
 extern void   rx_add_div_iq_samples(RECEIVER *rx, double i0, double q0, double i1, double q1);
 
 extern void   rx_change_sample_rate(RECEIVER *rx, int sample_rate);
@@ -76,6 +76,7 @@
 #include "startup.h"
 #include "toolset.h"
 #include "main.h"
+#include "notify_bus.h"
 
 #include <math.h>
 
@@ -105,8 +106,6 @@ int autogain_is_adjusted = 1;
 gboolean rigctl_debug = FALSE;
 gboolean tci_debug = FALSE;
 
-int parse_cmd(void *data);
-
 int cat_control = 0;
 
 static GMutex mutex_numcat;   // only needed to make in/de-crements of "cat_control"  atomic
@@ -152,14 +151,17 @@ typedef struct _client {
   socklen_t address_length;         // TCP only: initialized by accept(), never used
   struct sockaddr_in address;       // TCP only: initialized by accept(), never used
   GThread *thread_id;               // ID of thread that serves the client
-  guint andromeda_timer;            // for reporting ANDROMEDA LED states
-  guint auto_timer;                 // for auto-reporting FA/FB
+  guint andromeda_timer;            // for querying the ANDROMEDA type (ZZZS)
+  int andromeda_notify;             // notification bus handle for ANDROMEDA LED updates
+  int auto_notify;                  // notification bus handle for auto-reporting FA/FB/MD
   int auto_reporting;               // auto-reporting (AI, ZZAI) 0...3
   int andromeda_type;               // 1:Andromeda, 4:G2Mk1 with CM5 upgrade, 5:G2 ultra
   int last_v;                       // Last push-button state received
   long long last_fa, last_fb;       // last VFO-A/B frequency
   int last_md;                      // VFO-A mode reported
   int last_led[MAX_ANDROMEDA_LEDS]; // last status of ANDROMEDA LEDs
+  gint pending;                     // number of command batches queued in the GTK idle queue
+  GMutex write_mutex;               // serializes responses to this client
 } CLIENT;
 
 //
@@ -179,16 +181,30 @@ static uint8_t andromeda_vfo_speedup[32] = {  0,   1,   2,   3,   4,   5,   6,
                                               25,  29,  33,  38,  43,  48,  54,  61,
                                               69,  77,  85,  95, 105, 116, 128,   4
                                            };
-typedef struct _command {
+//
+// All set-commands (and all queries that cannot take the fast path)
+// contained in one read() are handed to the GTK thread in a single
+// batch. The commands are stored back-to-back in text[] and are
+// executed in the order received.
+//
+#define CAT_BATCH_MAX 64
+
+typedef struct _cat_batch {
   CLIENT *client;
-  char *command;
-} COMMAND;
+  gint64 t_recv;                    // time stamp of the read() (for the latency statistics)
+  int count;
+  int used;
+  int offset[CAT_BATCH_MAX];
+  char text[MAXDATASIZE + 1];
+} CAT_BATCH;
 
 static CLIENT tcp_client[MAX_TCP_CLIENTS]; // TCP clients
 static CLIENT serial_client[MAX_SERIAL];   // serial clienta
 SERIALPORT SerialPorts[MAX_SERIAL + 2];
 
 static gpointer rigctl_client(gpointer data);
+static void parse_cmd(CLIENT *client, char *command);
+static void rigctl_notify_stop(CLIENT *client);
 
 //
 // This macro handles cases where RX2 is referred to but might not
@@ -862,14 +878,7 @@ void shutdown_tcp_rigctl(void) {
   // Gracefully terminate all active TCP connections
   //
   for (int id = 0; id < MAX_TCP_CLIENTS; id++) {
-    if (tcp_client[id].andromeda_timer != 0) {
-      g_source_remove(tcp_client[id].andromeda_timer);
-      tcp_client[id].andromeda_timer = 0;
-    }
-    if (tcp_client[id].auto_timer != 0) {
-      g_source_remove(tcp_client[id].auto_timer);
-      tcp_client[id].auto_timer = 0;
-    }
+    rigctl_notify_stop(&tcp_client[id]);
     tcp_client[id].running = 0;
     if (tcp_client[id].fd != -1) {
       // t_print("%s: setting SO_LINGER to 0 for client_socket: %d\n", __func__, tcp_client[id].fd);
@@ -901,11 +910,14 @@ void shutdown_tcp_rigctl(void) {
   //       non-blocking (use select())
 }
 
-static void send_resp(int fd, char *msg) {
+static void send_resp(CLIENT *client, char *msg) {
   //
-  // send_resp is ONLY called from within the GTK event queue
-  // ==> no multi-thread problems can occur.
+  // send_resp is called from the GTK event queue and, for queries
+  // answered via the fast path, from the client threads. The client's
+  // write_mutex makes sure that responses are never interleaved, while
+  // a slow client does not hold up the others.
   //
+  int fd = client->fd;
   if (fd == -1) {
     //
     // This means the client fd has been explicitly closed
@@ -917,21 +929,23 @@ static void send_resp(int fd, char *msg) {
   if (rigctl_debug) { t_print("RIGCTL: RESP=%s\n", msg); }
   int length = strlen(msg);
   int count = 0;
+  g_mutex_lock(&client->write_mutex);
   while (length > 0) {
     //
-    // Since this is in the GTK event queue, we cannot try
+    // Since this may be in the GTK event queue, we cannot try
     // for a long time. In case of an error (rc < 0) we give
     // up immediately, for rc == 0 we try at most 10 times.
     //
     int rc = write(fd, msg, length);
-    if (rc < 0) { return; }
+    if (rc < 0) { break; }
     if (rc == 0) {
       count++;
-      if (count > 10) { return; }
+      if (count > 10) { break; }
     }
     length -= rc;
     msg += rc;
   }
+  g_mutex_unlock(&client->write_mutex);
 }
 
 static int wdspmode(int kenwoodmode) {
@@ -1005,12 +1019,12 @@ static int ts2000_mode(int wdspmode) {
   return kenwoodmode;
 }
 
-static gboolean autoreport_handler(gpointer data) {
-  CLIENT *client = (CLIENT *) data;
+static void autoreport_send(CLIENT *client) {
   //
-  // This function is repeatedly called as long as the CAT
-  // connection is active. It reports VFOA and VFOB frequency changes
-  // to the client, provided it has auto-reporting enabled and is running.
+  // This function is called via the notification bus whenever the VFO
+  // frequencies or the VFO-A mode may have changed. It reports VFOA and
+  // VFOB frequency changes to the client, provided it has auto-reporting
+  // enabled and is running.
   //
   // Note this runs in the GTK event queue so it cannot interfere
   // with another CAT command.
@@ -1018,10 +1032,7 @@ static gboolean autoreport_handler(gpointer data) {
   // be echoed back and then be read again.
   //
   if (client->fifo || !client->running) {
-    //
-    // return and remove timer
-    //
-    return FALSE;
+    return;
   }
   if (client->auto_reporting > 0) {
     long long fa = vfo[VFO_A].ctun ? vfo[VFO_A].ctun_frequency : vfo[VFO_A].frequency;
@@ -1029,13 +1040,13 @@ static gboolean autoreport_handler(gpointer data) {
     if (fa != client->last_fa) {
       char reply[256];
       snprintf(reply, 256, "FA%011lld;", fa);
-      send_resp(client->fd, reply);
+      send_resp(client, reply);
       client->last_fa = fa;
     }
     if (fb != client->last_fb) {
       char reply[256];
       snprintf(reply, 256, "FB%011lld;", fb);
-      send_resp(client->fd, reply);
+      send_resp(client, reply);
       client->last_fb = fb;
     }
   }
@@ -1044,36 +1055,33 @@ static gboolean autoreport_handler(gpointer data) {
     if (md != client->last_md) {
       char reply[256];
       snprintf(reply, 256, "MD%1d;", ts2000_mode(md));
-      send_resp(client->fd, reply);
+      send_resp(client, reply);
       client->last_md = md;
     }
   }
-  return TRUE;
 }
 
-static gboolean andromeda_handler(gpointer data) {
-  //
-  // This function is repeatedly called as long as the client runs
+static void autoreport_notify_cb(unsigned int changes, gpointer data) {
+  autoreport_send((CLIENT *) data);
+}
+
+static gboolean autoreport_oneshot_handler(gpointer data) {
   //
+  // Initial report after the connection has been established
   //
-  CLIENT *client = (CLIENT *) data;
-  char reply[256];
-  if (!client->running || client->andromeda_type == 4) {
-    //
-    // If the client is no longer running, remove source.
-    // The same applies for ANDROMEDA type-4 clients since there
-    // are no LEDs on a G2MkI panel
-    //
-    return G_SOURCE_REMOVE;
-  }
+  autoreport_send((CLIENT *) data);
+  return G_SOURCE_REMOVE;
+}
+
+static void andromeda_update_leds(CLIENT *client) {
   //
-  // Do not proceed until Andromeda version is known
-  // Send a ZZZS command and re-trigger the handler
+  // Send the LED states that have changed since the last call.
+  // Nothing is done until the ANDROMEDA type is known, and for
+  // type-4 clients since there are no LEDs on a G2MkI panel.
   //
-  if (client->andromeda_type < 1) {
-    snprintf(reply, 256, "ZZZS;");
-    send_resp(client->fd, reply);
-    return TRUE;
+  char reply[256];
+  if (!client->running || client->andromeda_type < 1 || client->andromeda_type == 4) {
+    return;
   }
   for (int led = 0; led < MAX_ANDROMEDA_LEDS; led++) {
     int new = client->last_led[led];
@@ -1163,24 +1171,79 @@ static gboolean andromeda_handler(gpointer data) {
     //
     if (client->last_led[led] != new) {
       snprintf(reply, 256, "ZZZI%02d%d;", led, new);
-      send_resp(client->fd, reply);
+      send_resp(client, reply);
       client->last_led[led] = new;
     }
   }
-  return TRUE;
+}
+
+static void andromeda_notify_cb(unsigned int changes, gpointer data) {
+  andromeda_update_leds((CLIENT *) data);
+}
+
+static gboolean andromeda_handler(gpointer data) {
+  //
+  // This function is repeatedly called until the ANDROMEDA type is known.
+  // LED updates are then triggered by the notification bus.
+  //
+  CLIENT *client = (CLIENT *) data;
+  if (!client->running || client->andromeda_type == 4) {
+    client->andromeda_timer = 0;
+    return G_SOURCE_REMOVE;
+  }
+  //
+  // Do not proceed until Andromeda version is known
+  // Send a ZZZS command and re-trigger the handler
+  //
+  if (client->andromeda_type < 1) {
+    send_resp(client, "ZZZS;");
+    return TRUE;
+  }
+  andromeda_update_leds(client);
+  client->andromeda_timer = 0;
+  return G_SOURCE_REMOVE;
 }
 
 static gboolean andromeda_oneshot_handler(gpointer data) {
   //
   // This is the handler, called once, so it has to return
   // G_SOURCE_REMOVE. It is intended to be exectuted via
-  // g_idle_add() at the end of a ZZZP handling when
+  // g_idle_add() at the end of a ZZZP/ZZZS handling when
   // "immediate" LED update is desired.
   //
-  (void) andromeda_handler(data);
+  andromeda_update_leds((CLIENT *) data);
   return G_SOURCE_REMOVE;
 }
 
+//
+// Changes that are relevant for auto-reporting resp. the ANDROMEDA LEDs
+//
+#define AUTOREPORT_CHANGES (NOTIFY_VFO_A_FREQ | NOTIFY_VFO_B_FREQ | NOTIFY_VFO_A_MODE | NOTIFY_VFOS | NOTIFY_CTUN)
+#define ANDROMEDA_CHANGES  (NOTIFY_MOX | NOTIFY_TUNE | NOTIFY_PS | NOTIFY_DIVERSITY | NOTIFY_CTUN | NOTIFY_RIT_XIT | \
+                            NOTIFY_SPLIT | NOTIFY_ACTIVE_RX | NOTIFY_LOCK | NOTIFY_ATU | NOTIFY_VFOS)
+
+static void rigctl_autoreport_start(CLIENT *client) {
+  client->auto_notify = notify_subscribe(AUTOREPORT_CHANGES, NOTIFY_ORIGIN_CAT, autoreport_notify_cb, client);
+  g_timeout_add(750, autoreport_oneshot_handler, client);
+}
+
+static void rigctl_andromeda_start(CLIENT *client) {
+  client->andromeda_notify = notify_subscribe(ANDROMEDA_CHANGES, NOTIFY_ORIGIN_CAT, andromeda_notify_cb, client);
+  // Note this will send a ZZZS; command upon first invocation
+  client->andromeda_timer = g_timeout_add(500, andromeda_handler, client);
+}
+
+static void rigctl_notify_stop(CLIENT *client) {
+  if (client->andromeda_timer != 0) {
+    g_source_remove(client->andromeda_timer);
+    client->andromeda_timer = 0;
+  }
+  notify_unsubscribe(client->andromeda_notify);
+  client->andromeda_notify = 0;
+  notify_unsubscribe(client->auto_notify);
+  client->auto_notify = 0;
+}
+
 static gpointer rigctl_server(gpointer data) {
   int port = GPOINTER_TO_INT(data);
   int on = 1;
@@ -1271,6 +1334,7 @@ static gpointer rigctl_server(gpointer data) {
     tcp_client[spare].last_fb         = -1;
     tcp_client[spare].last_md         = -1;
     tcp_client[spare].last_v          = 0;
+    tcp_client[spare].pending         = 0;
     for (int i = 0; i < MAX_ANDROMEDA_LEDS; i++) {
       tcp_client[spare].last_led[i] = -1;
     }
@@ -1279,59 +1343,393 @@ static gpointer rigctl_server(gpointer data) {
     //
     tcp_client[spare].thread_id       = g_thread_new("rigctl client", rigctl_client, (gpointer) &tcp_client[spare]);
     //
-    // Launch auto-reporter task
+    // Subscribe auto-reporter to VFO changes
     //
-    tcp_client[spare].auto_timer = g_timeout_add(750, autoreport_handler, &tcp_client[spare]);
+    rigctl_autoreport_start(&tcp_client[spare]);
     //
-    // If ANDROMEDA is enabled for TCP, lauch periodic ANDROMEDA task
+    // If ANDROMEDA is enabled for TCP, subscribe to LED relevant changes
     //
     if (rigctl_tcp_andromeda) {
-      // Note this will send a ZZZS; command upon first invocation
-      tcp_client[spare].andromeda_timer = g_timeout_add(500, andromeda_handler, &tcp_client[spare]);
+      rigctl_andromeda_start(&tcp_client[spare]);
     }
   }
   close(server_socket);
   return NULL;
 }
 
+//
+// CAT fast path
+//
+// Loggers, amplifiers and digimode programs poll FA/IF/SM/TX at 10-50 Hz.
+// These read-only queries are answered directly on the client thread
+// from a snapshot of the radio state, without a round trip through the
+// GTK idle queue. The snapshot is refreshed by the GTK thread every
+// CAT_SNAP_MS while a CAT client is connected, and after each executed
+// command batch. It is protected by a sequence counter, so the client
+// threads never block the GTK thread (and vice versa).
+//
+// A query takes the fast path only if no command of the same client is
+// still waiting in the idle queue, so a "set, then read back" sequence
+// is always answered in order with the new value.
+//
+#define CAT_SNAP_MS 20
+#define CAT_SNAP_MAXAGE 500000     // usec, older snapshots are not used
+
+typedef struct {
+  gint64 stamp;                    // g_get_monotonic_time() of the update
+  long long fa, fb;                // VFO-A/B frequency (CTUN frequency if CTUN is active)
+  int mode_a;                      // VFO-A mode (WDSP encoding)
+  int step_a;
+  long long rit_a;
+  int rit_enabled_a;
+  int xit_enabled;
+  int transmitting;
+  int mox;
+  int split;
+  int ctcss_enabled;
+  int ctcss;
+  int receivers;
+  double meter[2];
+} CAT_SNAPSHOT;
+
+static CAT_SNAPSHOT cat_snap;
+static gint cat_snap_seq = 0;      // odd while an update is in progress, 0: never written
+static guint cat_snap_timer = 0;   // protected by mutex_numcat
+
+static void cat_snapshot_publish(void) {
+  //
+  // GTK thread only
+  //
+  g_atomic_int_inc(&cat_snap_seq);
+  cat_snap.stamp = g_get_monotonic_time();
+  cat_snap.fa = vfo[VFO_A].ctun ? vfo[VFO_A].ctun_frequency : vfo[VFO_A].frequency;
+  cat_snap.fb = vfo[VFO_B].ctun ? vfo[VFO_B].ctun_frequency : vfo[VFO_B].frequency;
+  cat_snap.mode_a = vfo[VFO_A].mode;
+  cat_snap.step_a = vfo[VFO_A].step;
+  cat_snap.rit_a = vfo[VFO_A].rit;
+  cat_snap.rit_enabled_a = vfo[VFO_A].rit_enabled;
+  cat_snap.transmitting = radio_is_transmitting();
+  cat_snap.mox = mox;
+  cat_snap.split = split;
+  if (can_transmit) {
+    cat_snap.xit_enabled   = vfo[vfo_get_tx_vfo()].xit_enabled;
+    cat_snap.ctcss         = transmitter->ctcss + 1;
+    cat_snap.ctcss_enabled = transmitter->ctcss_enabled;
+  } else {
+    cat_snap.xit_enabled   = 0;
+    cat_snap.ctcss         = 0;
+    cat_snap.ctcss_enabled = 0;
+  }
+  cat_snap.receivers = receivers;
+  for (int id = 0; id < 2; id++) {
+    cat_snap.meter[id] = (id < receivers && receiver[id] != NULL) ? receiver[id]->meter : -140.0;
+  }
+  g_atomic_int_inc(&cat_snap_seq);
+}
+
+static gboolean cat_snapshot_read(CAT_SNAPSHOT *snap) {
+  for (int tries = 0; tries < 100; tries++) {
+    gint seq = g_atomic_int_get(&cat_snap_seq);
+    if (seq == 0) { return FALSE; }
+    if (seq & 1) {
+      g_thread_yield();
+      continue;
+    }
+    memcpy(snap, &cat_snap, sizeof(CAT_SNAPSHOT));
+    if (g_atomic_int_get(&cat_snap_seq) == seq) {
+      return (g_get_monotonic_time() - snap->stamp) < CAT_SNAP_MAXAGE;
+    }
+  }
+  return FALSE;
+}
+
+static gboolean cat_snapshot_cb(gpointer data) {
+  cat_snapshot_publish();
+  g_mutex_lock(&mutex_numcat);
+  if (cat_control <= 0) {
+    cat_snap_timer = 0;
+    g_mutex_unlock(&mutex_numcat);
+    return G_SOURCE_REMOVE;
+  }
+  g_mutex_unlock(&mutex_numcat);
+  return G_SOURCE_CONTINUE;
+}
+
+static void cat_snapshot_start_locked(void) {
+  //
+  // called with mutex_numcat held, after cat_control has been incremented
+  //
+  if (cat_snap_timer == 0) {
+    cat_snap_timer = g_timeout_add(CAT_SNAP_MS, cat_snapshot_cb, NULL);
+  }
+}
+
+//
+// CAT latency statistics, per command, from the read() that delivered
+// the command until the response has been sent (fast path) or the
+// command has been executed (idle queue). Bucket i counts latencies
+// below 2^(i+1) usec, the last bucket everything beyond.
+//
+#define CAT_LAT_BUCKETS 20
+
+typedef struct {
+  char name[8];
+  unsigned long count;
+  unsigned long fast;
+  gint64 max_us;
+  unsigned long bucket[CAT_LAT_BUCKETS];
+} CAT_LATENCY;
+
+static GMutex lat_mutex;
+static GHashTable *lat_table = NULL;
+
+static void cat_latency_key(const char *command, char *key) {
+  int len = (command[0] == 'Z' && command[1] == 'Z') ? 4 : 2;
+  int i;
+  for (i = 0; i < len && command[i] != ';' && command[i] != '\0'; i++) {
+    key[i] = command[i];
+  }
+  key[i] = '\0';
+}
+
+static void cat_latency_record(const char *key, gint64 us, gboolean fast) {
+  int b = 0;
+  while (b < CAT_LAT_BUCKETS - 1 && us >= (2LL << b)) {
+    b++;
+  }
+  g_mutex_lock(&lat_mutex);
+  if (lat_table == NULL) {
+    lat_table = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_free);
+  }
+  CAT_LATENCY *lat = g_hash_table_lookup(lat_table, key);
+  if (lat == NULL) {
+    lat = g_new0(CAT_LATENCY, 1);
+    g_strlcpy(lat->name, key, sizeof(lat->name));
+    g_hash_table_insert(lat_table, lat->name, lat);
+  }
+  lat->count++;
+  if (fast) { lat->fast++; }
+  if (us > lat->max_us) { lat->max_us = us; }
+  lat->bucket[b]++;
+  g_mutex_unlock(&lat_mutex);
+}
+
+static long cat_latency_percentile(const CAT_LATENCY *lat, double p) {
+  unsigned long limit = (unsigned long)(p * lat->count);
+  unsigned long sum = 0;
+  for (int b = 0; b < CAT_LAT_BUCKETS; b++) {
+    sum += lat->bucket[b];
+    if (sum > limit) {
+      return 2L << b;
+    }
+  }
+  return 2L << (CAT_LAT_BUCKETS - 1);
+}
+
+static gint cat_latency_compare(gconstpointer a, gconstpointer b) {
+  const CAT_LATENCY *la = *(CAT_LATENCY * const *) a;
+  const CAT_LATENCY *lb = *(CAT_LATENCY * const *) b;
+  if (la->count == lb->count) { return 0; }
+  return (la->count < lb->count) ? 1 : -1;
+}
+
+void rigctl_latency_report(char *buf, size_t len) {
+  GPtrArray *list = g_ptr_array_new();
+  GHashTableIter iter;
+  gpointer key, value;
+  size_t pos;
+  pos = g_snprintf(buf, len, "%-5s %9s %9s %9s %9s %9s\n", "CMD", "count", "fast", "p50[us]", "p99[us]", "max[us]");
+  g_mutex_lock(&lat_mutex);
+  if (lat_table != NULL) {
+    g_hash_table_iter_init(&iter, lat_table);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+      g_ptr_array_add(list, value);
+    }
+  }
+  g_ptr_array_sort(list, cat_latency_compare);
+  for (guint i = 0; i < list->len && i < 12 && pos < len; i++) {
+    const CAT_LATENCY *lat = g_ptr_array_index(list, i);
+    pos += g_snprintf(buf + pos, len - pos, "%-5s %9lu %9lu %9ld %9ld %9lld\n", lat->name, lat->count, lat->fast,
+                      cat_latency_percentile(lat, 0.5), cat_latency_percentile(lat, 0.99), (long long) lat->max_us);
+  }
+  g_mutex_unlock(&lat_mutex);
+  if (list->len == 0 && pos < len) {
+    g_snprintf(buf + pos, len - pos, "(no CAT commands received yet)\n");
+  }
+  g_ptr_array_free(list, TRUE);
+}
+
+void rigctl_latency_reset(void) {
+  g_mutex_lock(&lat_mutex);
+  if (lat_table != NULL) {
+    g_hash_table_remove_all(lat_table);
+  }
+  g_mutex_unlock(&lat_mutex);
+}
+
+//
+// Try to answer a read-only query from the snapshot.
+// Returns FALSE if the command must go through parse_cmd().
+//
+static gboolean cat_fast_reply(const char *command, char *reply, size_t len) {
+  CAT_SNAPSHOT snap;
+  if (!cat_snapshot_read(&snap)) {
+    return FALSE;
+  }
+  if (command[0] == 'Z' && command[1] == 'Z') {
+    const char *c = command + 2;
+    if (!strcmp(c, "FA;")) {
+      snprintf(reply, len, "ZZFA%011lld;", snap.fa);
+    } else if (!strcmp(c, "FB;")) {
+      snprintf(reply, len, "ZZFB%011lld;", snap.fb);
+    } else if (!strcmp(c, "MD;")) {
+      snprintf(reply, len, "ZZMD%02d;", snap.mode_a);
+    } else if (!strcmp(c, "TX;")) {
+      snprintf(reply, len, "ZZTX%d;", snap.mox);
+    } else if (c[0] == 'S' && c[1] == 'M' && c[2] >= '0' && c[2] <= '1' && c[3] == ';' && c[4] == '\0') {
+      int id = c[2] - '0';
+      if (id >= snap.receivers) { return FALSE; }
+      double m = fmin(-10.0, fmax(-140.0, snap.meter[id]));
+      snprintf(reply, len, "ZZSM%d%03d;", id, (int)((m + 140.0) * 2));
+    } else {
+      return FALSE;
+    }
+  } else if (!strcmp(command, "FA;")) {
+    snprintf(reply, len, "FA%011lld;", snap.fa);
+  } else if (!strcmp(command, "FB;")) {
+    snprintf(reply, len, "FB%011lld;", snap.fb);
+  } else if (!strcmp(command, "ID;")) {
+    g_strlcpy(reply, "ID019;", len);
+  } else if (!strcmp(command, "MD;")) {
+    snprintf(reply, len, "MD%d;", ts2000_mode(snap.mode_a));
+  } else if (!strcmp(command, "IF;")) {
+    snprintf(reply, len, "IF%011lld%04d%+06lld%d%d%d%02d%d%d%d%d%d%d%02d%d;",
+             snap.fa, snap.step_a, snap.rit_a, snap.rit_enabled_a, snap.xit_enabled,
+             0, 0, snap.transmitting, ts2000_mode(snap.mode_a), 0, 0, snap.split,
+             snap.ctcss_enabled ? 2 : 0, snap.ctcss, 0);
+  } else if (command[0] == 'S' && command[1] == 'M' && command[2] >= '0' && command[2] <= '1'
+             && command[3] == ';' && command[4] == '\0') {
+    int id = command[2] - '0';
+    if (id >= snap.receivers) { return FALSE; }
+    int val = (int)((snap.meter[id] + 127.0) * 0.277778);
+    if (val > 30) { val = 30; }
+    if (val < 0) { val = 0; }
+    snprintf(reply, len, "SM%d%04d;", id, val);
+  } else {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+static gboolean cat_batch_cb(gpointer data) {
+  CAT_BATCH *batch = (CAT_BATCH *) data;
+  CLIENT *client = batch->client;
+  char key[8];
+  for (int i = 0; i < batch->count; i++) {
+    char *command = batch->text + batch->offset[i];
+    cat_latency_key(command, key);
+    parse_cmd(client, command);
+    cat_latency_record(key, g_get_monotonic_time() - batch->t_recv, FALSE);
+  }
+  //
+  // Make the effect of the set-commands visible to the fast path
+  // before it is re-enabled for this client
+  //
+  cat_snapshot_publish();
+  g_atomic_int_add(&client->pending, -1);
+  g_free(batch);
+  return G_SOURCE_REMOVE;
+}
+
+static void cat_post_batch(CAT_BATCH *batch) {
+  CLIENT *client = batch->client;
+  g_atomic_int_inc(&client->pending);
+  client->busy = 10;
+  g_idle_add(cat_batch_cb, batch);
+}
+
+//
+// Split the data from one read() into commands. Queries are answered
+// via the fast path as long as possible, everything else is collected
+// and handed to the GTK thread in one batch. Once a command went into
+// the batch, all following commands of this read() do so as well such
+// that the order of execution is preserved.
+//
+// command/command_index hold an incomplete command across reads.
+//
+static void cat_process_input(CLIENT *client, const char *input, int numbytes, char *command, int *command_index) {
+  gint64 t_recv = g_get_monotonic_time();
+  CAT_BATCH *batch = NULL;
+  char reply[256];
+  char key[8];
+  //
+  // No fast path for FIFOs, since serial_server must not read back its
+  // own responses (see the "busy" logic there)
+  //
+  gboolean fast = !client->fifo && g_atomic_int_get(&client->pending) == 0;
+  for (int i = 0; i < numbytes; i++) {
+    //
+    // Filter out newlines and other non-printable characters
+    // These may occur when doing CAT manually with a terminal program
+    //
+    if (input[i] < 32) {
+      continue;
+    }
+    if (*command_index >= MAXDATASIZE - 1) {
+      // garbage without a terminating ';', discard
+      *command_index = 0;
+    }
+    command[(*command_index)++] = input[i];
+    if (input[i] != ';') {
+      continue;
+    }
+    command[*command_index] = '\0';
+    if (rigctl_debug) { t_print("RIGCTL: command=%s\n", command); }
+    if (fast && cat_fast_reply(command, reply, sizeof(reply))) {
+      send_resp(client, reply);
+      cat_latency_key(command, key);
+      cat_latency_record(key, g_get_monotonic_time() - t_recv, TRUE);
+      *command_index = 0;
+      continue;
+    }
+    fast = FALSE;
+    if (batch != NULL && (batch->count >= CAT_BATCH_MAX || batch->used + *command_index + 1 > MAXDATASIZE + 1)) {
+      cat_post_batch(batch);
+      batch = NULL;
+    }
+    if (batch == NULL) {
+      batch = g_new(CAT_BATCH, 1);
+      batch->client = client;
+      batch->t_recv = t_recv;
+      batch->count = 0;
+      batch->used = 0;
+    }
+    batch->offset[batch->count++] = batch->used;
+    memcpy(batch->text + batch->used, command, *command_index + 1);
+    batch->used += *command_index + 1;
+    *command_index = 0;
+  }
+  if (batch != NULL) {
+    cat_post_batch(batch);
+  }
+}
+
 static gpointer rigctl_client(gpointer data) {
   CLIENT *client = (CLIENT *) data;
   t_print("%s: starting rigctl_client: socket=%d\n", __func__, client->fd);
   g_mutex_lock(&mutex_numcat);
   cat_control++;
   if (rigctl_debug) { t_print("RIGCTL: CTLA INC cat_control=%d\n", cat_control); }
+  cat_snapshot_start_locked();
   g_mutex_unlock(&mutex_numcat);
   g_idle_add(ext_vfo_update, NULL);
-  int i;
   int numbytes;
   char  cmd_input[MAXDATASIZE] ;
-  char *command = g_new(char, MAXDATASIZE);
+  char command[MAXDATASIZE];
   int command_index = 0;
   while (client->running && (numbytes = recv(client->fd, cmd_input, MAXDATASIZE - 2, 0)) > 0) {
-    for (i = 0; i < numbytes; i++) {
-      //
-      // Filter out newlines and other non-printable characters
-      // These may occur when doing CAT manually with a terminal program
-      //
-      if (cmd_input[i] < 32) {
-        continue;
-      }
-      command[command_index] = cmd_input[i];
-      command_index++;
-      if (cmd_input[i] == ';') {
-        command[command_index] = '\0';
-        if (rigctl_debug) { t_print("RIGCTL: command=%s\n", command); }
-        COMMAND *info = g_new(COMMAND, 1);
-        info->client = client;
-        info->command = command;
-        g_idle_add(parse_cmd, info);
-        command = g_new(char, MAXDATASIZE);
-        command_index = 0;
-      }
-    }
+    cat_process_input(client, cmd_input, numbytes, command, &command_index);
   }
-  // Release the last "command" buffer (that has not yet been used)
-  g_free(command);
   t_print("%s: Leaving rigctl_client thread\n", __func__);
   //
   // If rigctl is disabled via the GUI, the connections are closed by shutdown_rigctl_ports()
@@ -1345,14 +1743,7 @@ static gpointer rigctl_client(gpointer data) {
     if (setsockopt(client->fd, SOL_SOCKET, SO_LINGER, (const char *) &linger, sizeof(linger)) == -1) {
       t_perror("setsockopt(...,SO_LINGER,...) failed for client:");
     }
-    if (client->andromeda_timer != 0) {
-      g_source_remove(client->andromeda_timer);
-      client->andromeda_timer = 0;
-    }
-    if (client->auto_timer != 0) {
-      g_source_remove(client->auto_timer);
-      client->auto_timer = 0;
-    }
+    rigctl_notify_stop(client);
     client->running = 0;
     close(client->fd);
     client->fd = -1;
@@ -1390,7 +1781,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (command[4] == ';') {
         // read the step size
         snprintf(reply, 256, "ZZAC%02d;", vfo_get_stepindex(VFO_A));
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[6] == ';') {
         // set the step size
         int i = atoi(&command[4]) ;
@@ -1445,7 +1836,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (command[4] == ';') {
         // send reply back
         snprintf(reply, 256, "ZZAG%03d;", (int)(100.0 * pow(10.0, 0.05 * receiver[0]->volume)));
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else {
         int gain = atoi(&command[4]);
         if (gain < 2) {
@@ -1471,11 +1862,12 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (command[4] == ';') {
         // Query status
         snprintf(reply, 256, "ZZAI%d;", client->auto_reporting);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         client->auto_reporting = command[4] - '0';
         if (client->auto_reporting < 0) { client->auto_reporting = 0; }
         if (client->auto_reporting > 3) { client->auto_reporting = 3; }
+        autoreport_send(client);
       } else {
         implemented = FALSE;
       }
@@ -1491,7 +1883,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (command[4] == ';') {
         // send reply back
         snprintf(reply, 256, "ZZAR%+04d;", (int)(receiver[0]->agc_gain));
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else {
         int threshold = atoi(&command[4]);
         set_agc_gain(VFO_A, (double) threshold);
@@ -1510,7 +1902,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
         if (command[4] == ';') {
           // send reply back
           snprintf(reply, 256, "ZZAS%+04d;", (int)(receiver[1]->agc_gain));
-          send_resp(client->fd, reply) ;
+          send_resp(client, reply) ;
         } else {
           int threshold = atoi(&command[4]);
           set_agc_gain(VFO_B, (double) threshold);
@@ -1699,7 +2091,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
           break;
         }
         snprintf(reply, 256, "ZZB%c%03d;", 'S' + v, b);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[7] == ';') {
         int band = band20;
         int b = atoi(&command[4]);
@@ -1787,7 +2179,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //ENDDEF
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZCN%d;", vfo[VFO_A].ctun);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         int state = atoi(&command[4]);
         vfo_ctun_update(VFO_A, state);
@@ -1805,7 +2197,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (command[4] == ';') {
         // return the CTUN status
         snprintf(reply, 256, "ZZCO%d;", vfo[VFO_B].ctun);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         int state = atoi(&command[4]);
         vfo_ctun_update(VFO_B, state);
@@ -1817,7 +2209,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/read compander
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZCP%d;", 0);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       }
       break;
     default:
@@ -1832,7 +2224,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/read RX Reference
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZDB%d;", 0);  // currently always 0
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       }
       break;
     case 'C': //ZZDC
@@ -1840,7 +2232,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/get diversity gain
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZDC%04d;", (int) div_gain);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       }
       break;
     case 'D': //ZZDD
@@ -1848,7 +2240,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/get diversity phase
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZDD%04d;", (int) div_phase);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       }
       break;
     case 'M': //ZZDM
@@ -1862,7 +2254,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
           v = 2;
         }
         snprintf(reply, 256, "ZZDM%d;", v);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       }
       break;
     case 'N': //ZZDN
@@ -1870,7 +2262,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/read waterfall low
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZDN%+4d;", receiver[0]->waterfall_low);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       }
       break;
     case 'O': //ZZDO
@@ -1878,7 +2270,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/read waterfall high
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZDO%+4d;", receiver[0]->waterfall_high);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       }
       break;
     case 'P': //ZZDP
@@ -1886,7 +2278,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/read panadapter high
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZDP%+4d;", receiver[0]->panadapter_high);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       }
       break;
     case 'Q': //ZZDQ
@@ -1894,7 +2286,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/read panadapter low
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZDQ%+4d;", receiver[0]->panadapter_low);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       }
       break;
     case 'R': //ZZDR
@@ -1902,7 +2294,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/read panadapter step
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZDR%2d;", receiver[0]->panadapter_step);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       }
       break;
     default:
@@ -1917,7 +2309,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/read rx equalizer
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZER%d;", receiver[0]->eq_enable);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         receiver[0]->eq_enable = SET(atoi(&command[4]));
       }
@@ -1928,7 +2320,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (can_transmit) {
         if (command[4] == ';') {
           snprintf(reply, 256, "ZZET%d;", transmitter->eq_enable);
-          send_resp(client->fd, reply) ;
+          send_resp(client, reply) ;
         } else if (command[5] == ';') {
           transmitter->eq_enable = SET(atoi(&command[4]));
         }
@@ -1955,7 +2347,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
         } else {
           snprintf(reply, 256, "ZZFA%011lld;", vfo[VFO_A].frequency);
         }
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[15] == ';') {
         long long f = atoll(&command[4]);
         vfo_set_frequency(VFO_A, f);
@@ -1976,7 +2368,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
         } else {
           snprintf(reply, 256, "ZZFB%011lld;", vfo[VFO_B].frequency);
         }
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[15] == ';') {
         long long f = atoll(&command[4]);
         vfo_set_frequency(VFO_B, f);
@@ -1987,7 +2379,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZFD%d;", vfo[VFO_A].deviation == 2500 ? 0 : 1);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         int d = atoi(&command[4]);
         vfo[VFO_A].deviation = d ? 5000 : 2500;
@@ -2010,7 +2402,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //ENDDEF
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZFH%05d;", receiver[0]->filter_high);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[9] == ';') {
         int fh = atoi(&command[4]);
         fh = fmin(9999, fh);
@@ -2031,7 +2423,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZFI%02d;", vfo[VFO_A].filter);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[6] == ';') {
         int filter = atoi(&command[4]);
         vfo_id_filter_changed(VFO_A, filter);
@@ -2042,7 +2434,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZFJ%02d;", vfo[VFO_B].filter);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[6] == ';') {
         int filter = atoi(&command[4]);
         vfo_id_filter_changed(VFO_B, filter);
@@ -2061,7 +2453,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //ENDDEF
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZFL%05d;", receiver[0]->filter_low);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[9] == ';') {
         int fl = atoi(&command[4]);
         fl = fmin(9999, fl);
@@ -2095,7 +2487,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //ENDDEF
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZGT%d;", receiver[0]->agc);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         int agc = atoi(&command[4]);
         // update RX1 AGC
@@ -2119,7 +2511,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       RXCHECK(1,
       if (command[4] == ';') {
       snprintf(reply, 256, "ZZGU%d;", receiver[1]->agc);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
       int agc = atoi(&command[4]);
         // update RX2 AGC
@@ -2155,7 +2547,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (command[4] == ';') {
         // send reply back
         snprintf(reply, 256, "ZZLA%03d;", (int)(receiver[0]->volume * 100.0));
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else {
         int gain = atoi(&command[4]);
         // gain is 0..100
@@ -2180,7 +2572,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (command[4] == ';') {
       // send reply back
       snprintf(reply, 256, "ZZLC%03d;", (int)(255.0 * pow(10.0, 0.05 * receiver[1]->volume)));
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else {
         int gain = atoi(&command[4]);
         // gain is 0..100
@@ -2206,7 +2598,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
         if (command[4] == ';') {
           // send reply back
           snprintf(reply, 256, "ZZLI%d;", transmitter->puresignal);
-          send_resp(client->fd, reply) ;
+          send_resp(client, reply) ;
         } else {
           int ps = atoi(&command[4]);
           tx_ps_onoff(transmitter, ps);
@@ -2232,7 +2624,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //ENDDEF
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZMA%d;", receiver[0]->mute_radio);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else {
         int mute = atoi(&command[4]);
         receiver[0]->mute_radio = mute;
@@ -2251,7 +2643,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       RXCHECK(1,
       if (command[4] == ';') {
       snprintf(reply, 256, "ZZMA%d;", receiver[1]->mute_radio);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else {
         int mute = atoi(&command[4]);
         receiver[1]->mute_radio = mute;
@@ -2271,7 +2663,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //ENDDEF
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZMD%02d;", vfo[VFO_A].mode);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[6] == ';') {
         vfo_id_mode_changed(VFO_A, atoi(&command[4]));
       }
@@ -2286,7 +2678,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //ENDDEF
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZMD%02d;", vfo[VFO_B].mode);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[6] == ';') {
         vfo_id_mode_changed(VFO_A, atoi(&command[4]));
       }
@@ -2302,7 +2694,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (can_transmit) {
         if (command[4] == ';') {
           snprintf(reply, 256, "ZZMG%03d;", (int)((transmitter->mic_gain + 12.0) * 1.129));
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[7] == ';') {
           int val = atoi(&command[4]);
           transmitter->mic_gain = ((double) val * 0.8857) - 12.0;
@@ -2316,7 +2708,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZML LSB00: USB01: DSB02: CWL03: CWU04: FMN05:  AM06:DIGU07:SPEC08:DIGL09: SAM10: DRM11;");
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       }
       break;
     case 'N': //ZZMN
@@ -2331,7 +2723,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
           g_strlcat(reply, temp, 256);
         }
         g_strlcat(reply, ";", 256);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       }
       break;
     case 'O': //ZZMO
@@ -2339,14 +2731,14 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       // set/read MON status
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZMO%d;", 0);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       }
       break;
     case 'R': //ZZMR
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZMR%d;", active_receiver->smetermode + 1);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         int val = atoi(&command[4]) - 1;
         switch (val) {
@@ -2363,7 +2755,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZMT%02d;", 1);  // forward power
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else {
       }
       break;
@@ -2378,7 +2770,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZNA%d;", (receiver[0]->nb == 1));
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         if (atoi(&command[4])) { receiver[0]->nb = 1; }
         update_noise();
@@ -2388,7 +2780,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZNB%d;", (receiver[0]->nb == 2));
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         if (atoi(&command[4])) { receiver[0]->nb = 2; }
         update_noise();
@@ -2399,7 +2791,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (receivers == 2) {
         if (command[4] == ';') {
           snprintf(reply, 256, "ZZNC%d;", (receiver[1]->nb == 1));
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[5] == ';') {
           if (atoi(&command[4])) { receiver[1]->nb = 1; }
           update_noise();
@@ -2413,7 +2805,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (receivers == 2) {
         if (command[4] == ';') {
           snprintf(reply, 256, "ZZND%d;", (receiver[1]->nb == 2));
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[5] == ';') {
           if (atoi(&command[4])) { receiver[1]->nb = 2; }
           update_noise();
@@ -2426,7 +2818,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZNN%d;", receiver[0]->snb);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         receiver[0]->snb = atoi(&command[4]);
         update_noise();
@@ -2437,7 +2829,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (receivers == 2) {
         if (command[4] == ';') {
           snprintf(reply, 256, "ZZNO%d;", receiver[1]->snb);
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[5] == ';') {
           receiver[1]->snb = atoi(&command[4]);
           update_noise();
@@ -2451,7 +2843,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (receivers == 2) {
         if (command[4] == ';') {
           snprintf(reply, 256, "ZZNR%d;", (receiver[0]->nr == 1));
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[5] == ';') {
           if (atoi(&command[4])) { receiver[0]->nr = 1; }
           update_noise();
@@ -2462,7 +2854,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZNS%d;", (receiver[0]->nr == 2));
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         if (atoi(&command[4])) { receiver[0]->nr = 2; }
         update_noise();
@@ -2472,7 +2864,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZNT%d;", receiver[0]->anf);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         if (atoi(&command[4])) { receiver[0]->anf = 1; }
         update_noise();
@@ -2483,7 +2875,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (receivers == 2) {
         if (command[4] == ';') {
           snprintf(reply, 256, "ZZNU%d;", receiver[1]->anf);
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[5] == ';') {
           if (atoi(&command[4])) { receiver[1]->anf = 1; }
           update_noise();
@@ -2497,7 +2889,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (receivers == 2) {
         if (command[4] == ';') {
           snprintf(reply, 256, "ZZNV%d;", (receiver[1]->nr == 1));
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[5] == ';') {
           if (atoi(&command[4])) { receiver[1]->nr = 1; }
           update_noise();
@@ -2511,7 +2903,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (receivers == 2) {
         if (command[4] == ';') {
           snprintf(reply, 256, "ZZNW%d;", (receiver[1]->nr == 2));
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[5] == ';') {
           if (atoi(&command[4])) { receiver[1]->nr = 2; }
           update_noise();
@@ -2546,7 +2938,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
           a = 3;
         }
         snprintf(reply, 256, "ZZPA%d;", a);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';' && have_rx_att) {
         int a = atoi(&command[4]);
         switch (a) {
@@ -2575,7 +2967,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZPY%d;", receiver[0]->zoom);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[7] == ';') {
         int zoom = atoi(&command[4]);
         set_zoom(0, zoom);
@@ -2610,7 +3002,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZRF%+5lld;", vfo[VFO_A].rit);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[9] == ';') {
         vfo_rit_value(VFO_A, atoi(&command[4]));
         g_idle_add(ext_vfo_update, NULL);
@@ -2620,14 +3012,14 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[5] == ';') {
         snprintf(reply, 256, "ZZRM%d%20d;", active_receiver->smetermode, (int) receiver[0]->meter);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       }
       break;
     case 'S': //ZZRS
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZRS%d;", receivers == 2);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         int state = atoi(&command[4]);
         if (state) {
@@ -2641,7 +3033,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZRT%d;", vfo[VFO_A].rit_enabled);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         vfo_rit_onoff(VFO_A, SET(atoi(&command[4])));
       }
@@ -2710,7 +3102,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
           m = fmax(-140.0, m);
           m = fmin(-10.0, m);
           snprintf(reply, 256, "ZZSM%d%03d;", v, (int)((m + 140.0) * 2));
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else {
           implemented = FALSE;
         }
@@ -2720,7 +3112,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZSP%d;", split);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         int val = atoi(&command[4]);
         radio_set_split(val);
@@ -2730,7 +3122,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZSW%d;", split);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         int val = atoi(&command[4]);
         radio_set_split(val);
@@ -2747,7 +3139,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZTU%d;", tune);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         radio_tune_update(atoi(&command[4]));
       }
@@ -2762,7 +3154,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //ENDDEF
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZTX%d;", mox);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         radio_mox_update(atoi(&command[4]));
       }
@@ -2785,7 +3177,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       if (can_transmit) {
         if (command[4] == ';') {
           snprintf(reply, 256, "ZZUT%d;", transmitter->twotone);
-          send_resp(client->fd, reply) ;
+          send_resp(client, reply) ;
         } else if (command[5] == ';') {
           tx_set_twotone(transmitter, atoi(&command[4]));
         }
@@ -2836,7 +3228,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZXT%+05lld;", vfo[vfo_get_tx_vfo()].xit);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[9] == ';') {
         vfo_xit_value(atoi(&command[4]));
       }
@@ -2866,7 +3258,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
         if (receiver[0]->snb) { status |=  0x0800; }
         if (receiver[0]->anf) { status |=  0x1000; }
         snprintf(reply, 256, "ZZXN%04d;", status);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       }
       break;
     case 'O': //ZZXO
@@ -2895,7 +3287,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
           if (receiver[1]->snb) { status |=  0x0800; }
           if (receiver[1]->anf) { status |=  0x1000; }
           snprintf(reply, 256, "ZZXO%04d;", status);
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         }
       } else {
         implemented = FALSE;
@@ -2905,11 +3297,9 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZXS%d;", vfo[vfo_get_tx_vfo()].xit_enabled);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
-        vfo[vfo_get_tx_vfo()].xit_enabled = atoi(&command[4]);
-        schedule_high_priority();
-        g_idle_add(ext_vfo_update, NULL);
+        vfo_xit_onoff(atoi(&command[4]));
       }
       break;
     case 'V': //ZZXV
@@ -2951,7 +3341,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
           status = status | 0x100;
         }
         snprintf(reply, 256, "ZZXV%03d;", status);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       }
       break;
     default:
@@ -2971,7 +3361,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
       //ENDDEF
       if (command[4] == ';') {
         snprintf(reply, 256, "ZZYR%01d;", active_receiver->id);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         int v = atoi(&command[4]);
         if (v >= 0 && v < receivers) {
@@ -3233,7 +3623,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
             case 28:
               schedule_action(toolbar_switches[p - 21].switch_function, (v == 0) ? PRESSED : RELEASED, 0);
               snprintf(reply, 256, "ZZZI11%d;", locked);
-              send_resp(client->fd, reply);
+              send_resp(client, reply);
               break;
             case 46: // SDR On
               if (v == 0) {
@@ -3317,7 +3707,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
                 schedule_action(DIV, (v == 0) ? PRESSED : RELEASED, 0);
                 if (v == 0) {
                   snprintf(reply, 256, "ZZZI05%d;", diversity_enabled ^ 1);
-                  send_resp(client->fd, reply);
+                  send_resp(client, reply);
                 }
               }
               break;
@@ -3325,15 +3715,15 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
               schedule_action(RIT_CLEAR, (v == 0) ? PRESSED : RELEASED, 0);
               schedule_action(XIT_CLEAR, (v == 0) ? PRESSED : RELEASED, 0);
               snprintf(reply, 256, "ZZZI080;");
-              send_resp(client->fd, reply);
+              send_resp(client, reply);
               snprintf(reply, 256, "ZZZI090;");
-              send_resp(client->fd, reply);
+              send_resp(client, reply);
               break;
             case 29: // Shift
               if (v == 0) {
                 shift ^= 1;
                 snprintf(reply, 256, "ZZZI06%d;", shift);
-                send_resp(client->fd, reply);
+                send_resp(client, reply);
               }
               break;
             case 30: // Band Buttons
@@ -3365,7 +3755,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
                 vfo_band_changed(active_receiver->id ? VFO_B : VFO_A, band);
                 shift = 0;
                 snprintf(reply, 256, "ZZZI060;");
-                send_resp(client->fd, reply);
+                send_resp(client, reply);
               } else if (!shift && v == 1) {
                 if (p == 30) { start_tx(); }                                  // MODE DATA
                 else if (p == 31) { schedule_action(MODE_PLUS, PRESSED, 0); }  // MODE+
@@ -3393,23 +3783,23 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
                   // neither RIT nor XIT: ==> activate RIT
                   vfo_rit_onoff(active_receiver->id, 1);
                   snprintf(reply, 256, "ZZZI081;");
-                  send_resp(client->fd, reply);
+                  send_resp(client, reply);
                 } else if (vfo[active_receiver->id].rit_enabled && !vfo[vfo_get_tx_vfo()].xit_enabled) {
                   // RIT but no XIT: ==> de-activate RIT and activate XIT
                   vfo_rit_onoff(active_receiver->id, 0);
                   vfo_xit_onoff(1);
                   snprintf(reply, 256, "ZZZI080;");
-                  send_resp(client->fd, reply);
+                  send_resp(client, reply);
                   snprintf(reply, 256, "ZZZI091;");
-                  send_resp(client->fd, reply);
+                  send_resp(client, reply);
                 } else {
                   // else deactivate both.
                   vfo_rit_onoff(active_receiver->id, 0);
                   vfo_xit_onoff(0);
                   snprintf(reply, 256, "ZZZI080;");
-                  send_resp(client->fd, reply);
+                  send_resp(client, reply);
                   snprintf(reply, 256, "ZZZI090;");
-                  send_resp(client->fd, reply);
+                  send_resp(client, reply);
                 }
                 g_idle_add(ext_vfo_update, NULL);
               }
@@ -3420,19 +3810,19 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
                   if (active_receiver->id == 0) {
                     schedule_action(RX2, PRESSED, 0);
                     snprintf(reply, 256, "ZZZI07%d;", vfo[VFO_B].ctun);
-                    send_resp(client->fd, reply);
+                    send_resp(client, reply);
                     snprintf(reply, 256, "ZZZI08%d;", vfo[VFO_B].rit_enabled);
-                    send_resp(client->fd, reply);
+                    send_resp(client, reply);
                     snprintf(reply, 256, "ZZZI100;");
                   } else {
                     schedule_action(RX1, PRESSED, 0);
                     snprintf(reply, 256, "ZZZI07%d;", vfo[VFO_A].ctun);
-                    send_resp(client->fd, reply);
+                    send_resp(client, reply);
                     snprintf(reply, 256, "ZZZI08%d;", vfo[VFO_A].rit_enabled);
-                    send_resp(client->fd, reply);
+                    send_resp(client, reply);
                     snprintf(reply, 256, "ZZZI101;");
                   }
-                  send_resp(client->fd, reply);
+                  send_resp(client, reply);
                   g_idle_add(ext_vfo_update, NULL);
                 }
               }
@@ -3441,14 +3831,14 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
               if (v == 1) {
                 schedule_action(CTUN, PRESSED, 0);
                 snprintf(reply, 256, "ZZZI07%d;", vfo[active_receiver->id].ctun ^ 1);
-                send_resp(client->fd, reply);
+                send_resp(client, reply);
                 g_idle_add(ext_vfo_update, NULL);
               }
               break;
             case 47: // MOX
               if (v == 0) {
                 snprintf(reply, 256, "ZZZI01%d;", mox);
-                send_resp(client->fd, reply);
+                send_resp(client, reply);
               } else {
                 radio_mox_update(mox ^ 1);
               }
@@ -3456,7 +3846,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
             case 48: // TUNE
               if (v == 0) {
                 snprintf(reply, 256, "ZZZI03%d;", tune);
-                send_resp(client->fd, reply);
+                send_resp(client, reply);
               } else {
                 radio_tune_update(tune ^ 1);
               }
@@ -3472,7 +3862,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
                   if (can_transmit) {
                     tx_ps_onoff(transmitter, NOT(transmitter->puresignal));
                     snprintf(reply, 256, "ZZZI04%d;", transmitter->puresignal);
-                    send_resp(client->fd, reply);
+                    send_resp(client, reply);
                   }
                 }
               } else if (v == 2) {
@@ -3490,7 +3880,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
               } else {
                 set_locked(!locked);
                 snprintf(reply, 256, "ZZZI11%d;", locked);
-                send_resp(client->fd, reply);
+                send_resp(client, reply);
               }
             }
           }
@@ -3733,6 +4123,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
         t_print("RIGCTL:INFO: Andromeda Client: Type:%c%c h/w:%c%c s/w:%c%c%c\n",
                 command[4], command[5],
                 command[6], command[7], command[8], command[9], command[10]);
+        g_idle_add(andromeda_oneshot_handler, (gpointer) client);
       }
       break;
     case 'U': //ZZZU ANDROMEDA command operating on VFO of active receiver
@@ -3769,10 +4160,7 @@ gboolean parse_extended_cmd(const char *command, CLIENT *client) {
 }
 
 // called with g_idle_add so that the processing is running on the main thread
-int parse_cmd(void *data) {
-  COMMAND *info = (COMMAND *) data;
-  CLIENT *client = info->client;
-  char *command = info->command;
+static void parse_cmd(CLIENT *client, char *command) {
   char reply[256];
   reply[0] = '\0';
   gboolean implemented = TRUE;
@@ -3807,7 +4195,7 @@ int parse_cmd(void *data) {
         int id = SET(command[2] == '1');
         RXCHECK(id,
                 snprintf(reply, 256, "AG%1d%03d;", id, (int)(255.0 * pow(10.0, 0.05 * receiver[id]->volume)));
-                send_resp(client->fd, reply);
+                send_resp(client, reply);
                )
       } else if (command[6] == ';') {
         int id = SET(command[2] == '1');
@@ -3829,11 +4217,12 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "AI%d;", client->auto_reporting);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[3] == ';') {
         client->auto_reporting = command[2] - '0';
         if (client->auto_reporting < 0) { client->auto_reporting = 0; }
         if (client->auto_reporting > 3) { client->auto_reporting = 3; }
+        autoreport_send(client);
       }
       break;
     case 'L': // AL
@@ -3932,7 +4321,7 @@ int parse_cmd(void *data) {
       if (can_transmit) {
         if (command[2] == ';') {
           snprintf(reply, 256, "CN%02d;", transmitter->ctcss + 1);
-          send_resp(client->fd, reply) ;
+          send_resp(client, reply) ;
         } else if (command[4] == ';') {
           transmitter->ctcss = atoi(&command[2]) - 1;
           tx_set_ctcss(transmitter);
@@ -3951,7 +4340,7 @@ int parse_cmd(void *data) {
       if (can_transmit) {
         if (command[2] == ';') {
           snprintf(reply, 256, "CT%d;", transmitter->ctcss_enabled);
-          send_resp(client->fd, reply) ;
+          send_resp(client, reply) ;
         } else if (command[3] == ';') {
           transmitter->ctcss_enabled = SET(command[2] == '1');
           tx_set_ctcss(transmitter);
@@ -4014,7 +4403,7 @@ int parse_cmd(void *data) {
         } else {
           snprintf(reply, 256, "FA%011lld;", vfo[VFO_A].frequency);
         }
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[13] == ';') {
         long long f = atoll(&command[2]);
         vfo_set_frequency(VFO_A, f);
@@ -4035,7 +4424,7 @@ int parse_cmd(void *data) {
         } else {
           snprintf(reply, 256, "FB%011lld;", vfo[VFO_B].frequency);
         }
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[13] == ';') {
         long long f = atoll(&command[2]);
         vfo_set_frequency(VFO_B, f);
@@ -4060,7 +4449,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "FR%d;", active_receiver->id);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[3] == ';') {
         int id = SET(command[2] == '1');
         RXCHECK(id, schedule_action(id == 0 ? RX1 : RX2, PRESSED, 0));
@@ -4081,7 +4470,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "FT%d;", split);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[3] == ';') {
         int id = SET(command[2] == '1');
         radio_set_split(id);
@@ -4120,7 +4509,7 @@ int parse_cmd(void *data) {
         }
         if (implemented) {
           snprintf(reply, 256, "FW%04d;", val);
-          send_resp(client->fd, reply) ;
+          send_resp(client, reply) ;
         }
       } else if (command[6] == ';') {
         // make sure filter is filterVar1
@@ -4191,7 +4580,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "GT%03d;", receiver[0]->agc * 5);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[5] == ';') {
         receiver[0]->agc = atoi(&command[2]) / 5;
         rx_set_agc(receiver[0]);
@@ -4224,7 +4613,7 @@ int parse_cmd(void *data) {
       //NOTE      deskHPSDR responds ID019; (so does the Kenwood TS-2000)
       //ENDDEF
       g_strlcpy(reply, "ID019;", sizeof(reply));
-      send_resp(client->fd, reply);
+      send_resp(client, reply);
       break;
     case 'F': { //IF
       //CATDEF    IF
@@ -4260,14 +4649,14 @@ int parse_cmd(void *data) {
                vfo[VFO_A].ctun ? vfo[VFO_A].ctun_frequency : vfo[VFO_A].frequency,
                vfo[VFO_A].step, vfo[VFO_A].rit, vfo[VFO_A].rit_enabled, tx_xit_en,
                0, 0, radio_is_transmitting(), mode, 0, 0, split, tx_ctcss_en ? 2 : 0, tx_ctcss, 0);
-      send_resp(client->fd, reply);
+      send_resp(client, reply);
     }
     break;
     case 'S': //IS
       //DO NOT DOCUMENT, THIS WILL BE REMOVED
       if (command[2] == ';') {
         g_strlcpy(reply, "IS 0000;", 256);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else {
         implemented = FALSE;
       }
@@ -4296,7 +4685,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "KS%03d;", cw_keyer_speed);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         int speed = atoi(&command[2]);
         if (speed >= 1 && speed <= 60) {
@@ -4330,7 +4719,7 @@ int parse_cmd(void *data) {
         } else {
           snprintf(reply, 256, "KY1;");
         }
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[2] == '0' && command[3] == ';') {
         cw_engine_clear();
         radio_mox_update(0);
@@ -4377,7 +4766,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "LK%d%d;", locked, locked);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[4] == ';') {
         set_locked(atoi(&command[2]));
       }
@@ -4414,7 +4803,7 @@ int parse_cmd(void *data) {
       if (command[2] == ';') {
         int mode = ts2000_mode(vfo[VFO_A].mode);
         snprintf(reply, 256, "MD%d;", mode);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[3] == ';') {
         int mode = wdspmode(atoi(&command[2]));
         vfo_id_mode_changed(VFO_A, mode);
@@ -4435,7 +4824,7 @@ int parse_cmd(void *data) {
       if (can_transmit) {
         if (command[2] == ';') {
           snprintf(reply, 256, "MG%03d;", (int)(((transmitter->mic_gain + 12.0) / 62.0) * 100.0));
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[5] == ';') {
           double gain = (double) atoi(&command[2]);
           gain = ((gain / 100.0) * 62.0) - 12.0;
@@ -4485,7 +4874,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "NB%d;", receiver[0]->nb);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[3] == ';') {
         receiver[0]->nb = atoi(&command[2]);
         update_noise();
@@ -4505,7 +4894,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "NR%d;", receiver[0]->nr);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[3] == ';')  {
         receiver[0]->nr = atoi(&command[2]);
         update_noise();
@@ -4521,7 +4910,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "NT%d;", receiver[0]->anf);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[3] == ';') {
         receiver[0]->anf = atoi(&command[2]);
         update_noise();
@@ -4565,7 +4954,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "PA%d0;", receiver[0]->preamp);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[4] == ';') {
         receiver[0]->preamp = command[2] == '1';
       }
@@ -4585,7 +4974,7 @@ int parse_cmd(void *data) {
       if (can_transmit) {
         if (command[2] == ';') {
           snprintf(reply, 256, "PC%03d;", (int) transmitter->drive);
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[5] == ';') {
           set_drive((double) atoi(&command[2]));
           tci_drive_changed();
@@ -4612,7 +5001,7 @@ int parse_cmd(void *data) {
       if (can_transmit) {
         if (command[2] == ';') {
           snprintf(reply, 256, "PL%03d000;", (int)(5.0 * transmitter->compressor_level));
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[8] == ';') {
           command[5] = '\0';
           double level = (double) atoi(&command[2]);
@@ -4643,7 +5032,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "PS1;");
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[3] == ';') {
         int pwrc = atoi(&command[2]);
         if (pwrc == 0) {
@@ -4705,7 +5094,7 @@ int parse_cmd(void *data) {
           att = (int)(((double) att / 31.0) * 99.0);
         }
         snprintf(reply, 256, "RA%02d00;", att);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[4] == ';') {
         int att = atoi(&command[2]);
         if (have_rx_gain) {
@@ -4771,10 +5160,9 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "RT%d;", vfo[VFO_A].rit_enabled);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[3] == ';') {
-        vfo[VFO_A].rit_enabled = atoi(&command[2]);
-        g_idle_add(ext_vfo_update, NULL);
+        vfo_rit_onoff(VFO_A, atoi(&command[2]));
       }
       break;
     case 'U': //RU
@@ -4835,7 +5223,7 @@ int parse_cmd(void *data) {
       if (command[2] == ';') {
         snprintf(reply, 256, "SA%d%d%d%d%d%d%dSAT     ;", (sat_mode == SAT_MODE) || (sat_mode == RSAT_MODE), 0, 0, 0,
                  sat_mode == SAT_MODE, sat_mode == RSAT_MODE, 0);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[9] == ';') {
         if (command[2] == '0') {
           radio_set_satmode(SAT_NONE);
@@ -4873,7 +5261,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "SD%04d;", (int) fmin(cw_keyer_hang_time, 1000));
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[6] == ';') {
         int b = fmin(atoi(&command[2]), 1000);
         cw_breakin = (b == 0);
@@ -4938,7 +5326,7 @@ int parse_cmd(void *data) {
         }
         if (implemented) {
           snprintf(reply, 256, "SH%02d;", fh);
-          send_resp(client->fd, reply) ;
+          send_resp(client, reply) ;
         }
       } else if (command[4] == ';') {
         // make sure filter is filterVar1
@@ -5056,7 +5444,7 @@ int parse_cmd(void *data) {
           fl = 11;
         }
         snprintf(reply, 256, "SL%02d;", fl);
-        send_resp(client->fd, reply) ;
+        send_resp(client, reply) ;
       } else if (command[4] == ';') {
         // make sure filter is filterVar1
         if (vfo[VFO_A].filter != filterVar1) {
@@ -5136,7 +5524,7 @@ int parse_cmd(void *data) {
         if (val > 30) { val = 30; }
       if (val < 0) { val = 0; }
       snprintf(reply, 256, "SM%d%04d;", id, val);
-      send_resp(client->fd, reply);
+      send_resp(client, reply);
              )
       }
       break;
@@ -5153,7 +5541,7 @@ int parse_cmd(void *data) {
         int id = atoi(&command[2]);
         RXCHECK(id,
                 snprintf(reply, 256, "SQ%d%03d;", id, (int)((double) receiver[id]->squelch / 100.0 * 255.0 + 0.5));
-                send_resp(client->fd, reply);
+                send_resp(client, reply);
                )
       } else if (command[6] == ';') {
         int id = atoi(&command[2]);
@@ -5233,7 +5621,7 @@ int parse_cmd(void *data) {
       //NOTE      x is always zero
       //ENDDEF
       if (command[2] == ';') {
-        send_resp(client->fd, "TY000;");
+        send_resp(client, "TY000;");
       }
       break;
     default:
@@ -5279,7 +5667,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "VG%03d;", (int)((vox_threshold * 100.0) * 0.9));
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[5] == ';') {
         vox_threshold = atof(&command[2]) / 9.0;
         g_idle_add(ext_vfo_update, NULL);
@@ -5299,7 +5687,7 @@ int parse_cmd(void *data) {
       //ENDDEF
       if (command[2] == ';') {
         snprintf(reply, 256, "VX%d;", vox_enabled);
-        send_resp(client->fd, reply);
+        send_resp(client, reply);
       } else if (command[3] == ';') {
         vox_enabled = atoi(&command[2]);
         g_idle_add(ext_vfo_update, NULL);
@@ -5330,7 +5718,7 @@ int parse_cmd(void *data) {
       if (can_transmit) {
         if (command[2] == ';') {
           snprintf(reply, 256, "XT%d;", vfo[vfo_get_tx_vfo()].xit_enabled);
-          send_resp(client->fd, reply);
+          send_resp(client, reply);
         } else if (command[3] == ';') {
           vfo_xit_onoff(SET(atoi(&command[2])));
         }
@@ -5363,13 +5751,10 @@ int parse_cmd(void *data) {
     break;
   }
   if (!implemented) {
-    if (rigctl_debug) { t_print("RIGCTL: UNIMPLEMENTED COMMAND: %s\n", info->command); }
-    send_resp(client->fd, "?;");
+    if (rigctl_debug) { t_print("RIGCTL: UNIMPLEMENTED COMMAND: %s\n", command); }
+    send_resp(client, "?;");
   }
   client->done = 1; // possibly inform server that command is finished
-  g_free(info->command);
-  g_free(info);
-  return 0;
 }
 
 // Serial Port Launch
@@ -5432,15 +5817,15 @@ static gpointer serial_server(gpointer data) {
   // when we get data we'll send it to parse_cmd
   CLIENT *client = (CLIENT *) data;
   char cmd_input[MAXDATASIZE];
-  char *command = g_new(char, MAXDATASIZE);
+  char command[MAXDATASIZE];
   int command_index = 0;
-  int i;
   fd_set fds;
   struct timeval tv;
   t_print("%s: Entering Thread\n", __func__);
   g_mutex_lock(&mutex_numcat);
   cat_control++;
   // if (rigctl_debug) { t_print("RIGCTL: SER INC cat_control=%d\n", cat_control); }
+  cat_snapshot_start_locked();
   g_mutex_unlock(&mutex_numcat);
   g_idle_add(ext_vfo_update, NULL);
   client->running = TRUE;
@@ -5487,32 +5872,9 @@ static gpointer serial_server(gpointer data) {
     // shut down by the rigctl menu.
     if (!client->running) { break; }
     if (numbytes > 0) {
-      for (i = 0; i < numbytes; i++) {
-        //
-        // Filter out newlines and other non-printable characters
-        // These may occur when doing CAT manually with a terminal program
-        //
-        if (cmd_input[i] < 32) {
-          continue;
-        }
-        command[command_index] = cmd_input[i];
-        command_index++;
-        if (cmd_input[i] == ';') {
-          command[command_index] = '\0';
-          if (rigctl_debug) { t_print("RIGCTL: serial command=%s\n", command); }
-          COMMAND *info = g_new(COMMAND, 1);
-          info->client = client;
-          info->command = command;
-          client->busy = 10;
-          g_idle_add(parse_cmd, info);
-          command = g_new(char, MAXDATASIZE);
-          command_index = 0;
-        }
-      }
+      cat_process_input(client, cmd_input, numbytes, command, &command_index);
     }
   }
-  // Release the last "command" buffer (that has not yet been used)
-  g_free(command);
   g_mutex_lock(&mutex_numcat);
   cat_control--;
   // if (rigctl_debug) { t_print("RIGCTL: SER DEC - cat_control=%d\n", cat_control); }
@@ -5569,6 +5931,7 @@ int launch_serial_rigctl(int id) {
   serial_client[id].andromeda_type = 0;
   serial_client[id].last_fa = 0;
   serial_client[id].last_fb = 0;
+  serial_client[id].pending = 0;
   for (int i = 0; i < MAX_ANDROMEDA_LEDS; i++) {
     serial_client[id].last_led[i] = -1;
   }
@@ -5577,11 +5940,11 @@ int launch_serial_rigctl(int id) {
   //
   serial_client[id].thread_id = g_thread_new("Serial server", serial_server, (gpointer) &serial_client[id]);
   //
-  // Launch auto-reporter task
+  // Subscribe auto-reporter to VFO changes
   //
-  serial_client[id].auto_timer = g_timeout_add(750, autoreport_handler, &serial_client[id]);
+  rigctl_autoreport_start(&serial_client[id]);
   //
-  // If this is a serial line to an ANDROMEDA controller, initialize it and start a periodic GTK task
+  // If this is a serial line to an ANDROMEDA controller, initialize it and subscribe to LED relevant changes
   //
   if (SerialPorts[id].andromeda) {
     //
@@ -5589,8 +5952,7 @@ int launch_serial_rigctl(int id) {
     // reset and then the device stays in bootloader mode for half a second or so.
     //
     usleep(700000L);
-    // Note this will send a ZZZS; command upon first invocation
-    serial_client[id].andromeda_timer = g_timeout_add(500, andromeda_handler, &serial_client[id]);
+    rigctl_andromeda_start(&serial_client[id]);
   }
   return 1;
 }
@@ -5598,14 +5960,7 @@ int launch_serial_rigctl(int id) {
 // Serial Port close
 void disable_serial_rigctl(int id) {
   t_print("%s: Close Serial Port %s\n", __func__, SerialPorts[id].port);
-  if (serial_client[id].andromeda_timer != 0) {
-    g_source_remove(serial_client[id].andromeda_timer);
-    serial_client[id].andromeda_timer = 0;
-  }
-  if (serial_client[id].auto_timer != 0) {
-    g_source_remove(serial_client[id].auto_timer);
-    serial_client[id].auto_timer = 0;
-  }
+  rigctl_notify_stop(&serial_client[id]);
   serial_client[id].running = FALSE;
   if (serial_client[id].fifo) {
     //
@@ -72,5 +72,7 @@ extern int autogain_is_adjusted;
 extern volatile int rigctld_enabled;
 extern volatile int use_rigctld;
 extern void stop_rigctld (void);
+extern void rigctl_latency_report (char *buf, size_t len);
+extern void rigctl_latency_reset (void);
 
 #endif // RIGCTL_H
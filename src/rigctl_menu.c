@@ -47,8 +47,19 @@ static GtkWidget *rigctld_btn;
 static GtkWidget *rigctl_andromeda_btn;
 static GtkWidget *rigctl_port_select;
 static GtkWidget *tci_port_select;
+static GtkWidget *cat_latency_label = NULL;
+static guint cat_latency_timer_id = 0;
+
+static void cat_latency_stop(void) {
+  if (cat_latency_timer_id != 0) {
+    g_source_remove(cat_latency_timer_id);
+    cat_latency_timer_id = 0;
+  }
+  cat_latency_label = NULL;
+}
 
 static void cleanup(void) {
+  cat_latency_stop();
   if (dialog != NULL) {
     GtkWidget *tmp = dialog;
     dialog = NULL;
@@ -64,6 +75,24 @@ static gboolean close_cb(void) {
   return TRUE;
 }
 
+static gboolean cat_latency_update_cb(gpointer data) {
+  char text[1024];
+  if (cat_latency_label == NULL) {
+    cat_latency_timer_id = 0;
+    return G_SOURCE_REMOVE;
+  }
+  rigctl_latency_report(text, sizeof(text));
+  char *markup = g_markup_printf_escaped("<tt>%s</tt>", text);
+  gtk_label_set_markup(GTK_LABEL(cat_latency_label), markup);
+  g_free(markup);
+  return G_SOURCE_CONTINUE;
+}
+
+static void cat_latency_reset_cb(GtkWidget *widget, gpointer data) {
+  rigctl_latency_reset();
+  cat_latency_update_cb(NULL);
+}
+
 static void block_cat_rx_if_tune_cb(GtkWidget *widget, gpointer data) {
   if (can_transmit) {
     block_cat_rx_if_tune = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(widget));
@@ -769,6 +798,28 @@ void rigctl_menu(GtkWidget *parent) {
   g_signal_connect(w, "toggled", G_CALLBACK(chkbtn_toggle_cb), &tci_audio_monitor);
 #endif
   //------------------------------------------------------------------------------------------------------------------------
+  row++;
+  w = gtk_separator_new(GTK_ORIENTATION_HORIZONTAL);
+  gtk_widget_set_size_request(w, -1, 3);
+  gtk_grid_attach(GTK_GRID(grid), w, 0, row, 7, 1);
+  row++;
+  w = gtk_label_new("CAT Latency");
+  gtk_widget_set_name(w, "boldlabel");
+  gtk_widget_set_halign(w, GTK_ALIGN_START);
+  gtk_grid_attach(GTK_GRID(grid), w, 0, row, 1, 1);
+  w = gtk_button_new_with_label("Reset");
+  gtk_widget_set_tooltip_text(w, "Clear the CAT latency statistics");
+  g_signal_connect(w, "clicked", G_CALLBACK(cat_latency_reset_cb), NULL);
+  gtk_grid_attach(GTK_GRID(grid), w, 0, row + 1, 1, 1);
+  cat_latency_label = gtk_label_new(NULL);
+  gtk_widget_set_halign(cat_latency_label, GTK_ALIGN_START);
+  gtk_widget_set_tooltip_text(cat_latency_label,
+                              "Time from receiving a CAT command until it has been answered/executed,\n"
+                              "for the most frequent commands. \"fast\" counts the queries that were\n"
+                              "answered directly by the CAT thread without waiting for the GUI.");
+  gtk_grid_attach(GTK_GRID(grid), cat_latency_label, 1, row, 6, 2);
+  cat_latency_update_cb(NULL);
+  cat_latency_timer_id = g_timeout_add(1000, cat_latency_update_cb, NULL);
   //------------------------------------------------------------------------------------------------------------------------
   gtk_container_add(GTK_CONTAINER(content), grid);
   sub_menu = dialog;
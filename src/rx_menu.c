@@ -344,10 +344,19 @@ static void sample_rate_cb(GtkToggleButton *widget, gpointer data) {
   // we just "scanf" from the combobox text entry
   //
   if (p == NULL || sscanf(p, "%d", &samplerate) != 1) { return; }
+  if (rx->id == 1 && rx_channelizer) {
+    // RX2 rate is the channelizer output rate, independent of RX1
+    rx_set_channelizer_rate(samplerate);
+    return;
+  }
   rx_change_sample_rate(rx, samplerate);
   rx_menu_sync_shared_sample_rate(rx, samplerate);
 }
 
+static void channelizer_cb(GtkWidget *widget, gpointer data) {
+  rx_set_channelizer(gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(widget)));
+}
+
 static void adc_cb(GtkToggleButton *widget, gpointer data) {
   RECEIVER *rx = rx_from_data(data);
   rx->adc = gtk_combo_box_get_active(GTK_COMBO_BOX(widget));
@@ -536,6 +545,18 @@ static void add_sample_rate_control(GtkWidget *grid, RECEIVER *rx, int *row) {
   }
   g_signal_connect(sample_rate_combo_box, "changed", G_CALLBACK(sample_rate_cb), rx);
   (*row)++;
+  if (rx->id == 1) {
+    GtkWidget *channelizer_b = gtk_check_button_new_with_label("Derive RX2 from RX1 stream");
+    gtk_widget_set_name(channelizer_b, "boldlabel");
+    gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(channelizer_b), rx_channelizer);
+    gtk_widget_set_tooltip_text(channelizer_b,
+                                "RX2 uses no DDC of its own but is cut out of the RX1 stream\n"
+                                "(same ADC, RX2 frequency within the RX1 panadapter).\n"
+                                "RX2 may then use a lower sample rate than RX1.");
+    gtk_grid_attach(GTK_GRID(grid), channelizer_b, 1, *row, 1, 1);
+    g_signal_connect(channelizer_b, "toggled", G_CALLBACK(channelizer_cb), NULL);
+    (*row)++;
+  }
 }
 
 static void add_adc_control(GtkWidget *grid, RECEIVER *rx, int *row) {
@@ -794,6 +815,11 @@ static void p2_jitter_depth_cb(GtkSpinButton *spin, gpointer data) {
   new_protocol_set_jitter_buffer(p2_jitter_buffer_enabled, depth_ms);
 }
 
+static void p2_hp_window_cb(GtkSpinButton *spin, gpointer data) {
+  (void)data;
+  new_protocol_set_hp_window(gtk_spin_button_get_value_as_int(spin));
+}
+
 #ifdef __APPLE__
 static void rx_audio_reserve_toggle_cb(GtkToggleButton *button, gpointer data) {
   (void)data;
@@ -910,6 +936,23 @@ static GtkWidget *build_general_page(void) {
     GtkWidget *depth_unit = gtk_label_new("ms");
     gtk_widget_set_halign(depth_unit, GTK_ALIGN_START);
     gtk_grid_attach(GTK_GRID(network_grid), depth_unit, 2, network_row, 1, 1);
+    network_row++;
+    GtkWidget *hp_window_label = gtk_label_new("HighPrio window");
+    gtk_widget_set_name(hp_window_label, "boldlabel");
+    gtk_widget_set_halign(hp_window_label, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(network_grid), hp_window_label, 0, network_row, 1, 1);
+    GtkWidget *hp_window_b = gtk_spin_button_new_with_range(0.0, (double)P2_HP_WINDOW_MAX_US, 250.0);
+    gtk_spin_button_set_numeric(GTK_SPIN_BUTTON(hp_window_b), TRUE);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(hp_window_b), p2_hp_window_us);
+    gtk_widget_set_tooltip_text(hp_window_b,
+                                "Frequency/state changes within this window are merged into\n"
+                                "one HighPrio packet sent to the radio.\n"
+                                "MOX/PTT changes are always sent immediately.");
+    gtk_grid_attach(GTK_GRID(network_grid), hp_window_b, 1, network_row, 1, 1);
+    g_signal_connect(hp_window_b, "value-changed", G_CALLBACK(p2_hp_window_cb), NULL);
+    GtkWidget *hp_window_unit = gtk_label_new("usec");
+    gtk_widget_set_halign(hp_window_unit, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(network_grid), hp_window_unit, 2, network_row, 1, 1);
 #ifdef __APPLE__
     network_row++;
     GtkWidget *audio_reserve_b =
@@ -40,6 +40,7 @@
 #include "receiver.h"
 #include "transmitter.h"
 #include "rx_panadapter.h"
+#include "rx_render.h"
 #include "vfo.h"
 #include "mode.h"
 #include "actions.h"
@@ -152,28 +153,13 @@ static void rx_panadapter_peak_hold_shift(PAN_PEAK_HOLD *ph, int width, int dp)
 }
 
 typedef struct {
-  long long freq;      // absolute RF-Frequenz in Hz
-  gboolean enabled;
-  char label[32];
-  gint64 expire_time;       // 0 = nie automatisch entfernen, sonst Monotonic-Time (us)
-  gint64 last_update_time;  // Monotonic-Time (us), used for RBN refresh throttling
-  PAN_SPOT_SOURCE source;
-} PAN_LABEL;
-
-typedef struct {
-  int index;
   double x;
   int row;
 } PAN_LABEL_POS;
 
 #define PAN_LABEL_MIN_DX 40.0   // Mindestabstand in Pixeln in einer Zeile
-#define MAX_PAN_LABELS 64 // max. saved DX spots
-#define PAN_DXSPOT_DUPE_WINDOW_HZ 500LL
+#define MAX_PAN_LABELS_VISIBLE 256 // max. labels drawn per panadapter
 #define PAN_RBN_MAX_LIFETIME_MS 60000
-#define PAN_RBN_REFRESH_GUARD_US (30LL * 1000000LL)
-
-static PAN_LABEL pan_labels[MAX_PAN_LABELS];
-static int pan_label_count = 0;
 
 void panadapter_set_max_label_rows(int r) {
   if (r < 1) { r = 1; }
@@ -208,20 +194,6 @@ void rx_panadapter_force_noisefloor_update(void) {
   }
 }
 
-static int pan_spot_source_priority(PAN_SPOT_SOURCE source) {
-  switch (source) {
-  case PAN_SPOT_SOURCE_TCI:
-    return 3;
-  case PAN_SPOT_SOURCE_CLUSTER:
-    return 2;
-  case PAN_SPOT_SOURCE_RBN:
-    return 1;
-  case PAN_SPOT_SOURCE_CUSTOM:
-  default:
-    return 0;
-  }
-}
-
 static void pan_label_set_source_color(cairo_t *cr, PAN_SPOT_SOURCE source) {
   switch (source) {
   case PAN_SPOT_SOURCE_RBN:
@@ -238,7 +210,7 @@ static void pan_label_set_source_color(cairo_t *cr, PAN_SPOT_SOURCE source) {
   }
 }
 
-static void pan_label_draw_with_halo(cairo_t *cr, double x, double y, const PAN_LABEL *pl) {
+static void pan_label_draw_with_halo(cairo_t *cr, double x, double y, const DXSPOT_VIEW *pl) {
   static const double offset[][2] = {
     { -1.0,  0.0 },
     {  1.0,  0.0 },
@@ -259,156 +231,27 @@ static void pan_label_draw_with_halo(cairo_t *cr, double x, double y, const PAN_
   cairo_show_text(cr, pl->label);
 }
 
-/* Check whether a DX spot with the same call already exists close to the
- * requested frequency. RBN and cluster spots often differ by a few hundred Hz,
- * so an exact frequency match is not sufficient. If a duplicate is found,
- * refresh its timeout and move it to the latest reported frequency.
- */
-static gboolean pan_dxspot_update_if_exists(long long freq_hz, const char *text, int lifetime_ms,
-    PAN_SPOT_SOURCE source) {
-  gint64 now;
-  int new_priority;
-  int i;
-  if (text == NULL || text[0] == '\0') {
-    return FALSE;
-  }
-  now = g_get_monotonic_time();      /* us */
-  new_priority = pan_spot_source_priority(source);
-  for (i = 0; i < pan_label_count; i++) {
-    PAN_LABEL *pl = &pan_labels[i];
-    int old_priority;
-    if (!pl->enabled) {
-      continue;
-    }
-    if (g_ascii_strcasecmp(pl->label, text) != 0) {
-      continue;
-    }
-    if (llabs(pl->freq - freq_hz) > PAN_DXSPOT_DUPE_WINDOW_HZ) {
-      continue;
-    }
-    old_priority = pan_spot_source_priority(pl->source);
-    /* RBN is a high-rate skimmer source.  Do not let repeated RBN decodes
-     * continuously refresh existing labels, otherwise the normal spot lifetime
-     * never gets a chance to expire them.  Also do not let lower-priority RBN
-     * duplicates keep manually added cluster/TCI spots alive.
-     */
-    if (source == PAN_SPOT_SOURCE_RBN) {
-      if (old_priority > new_priority) {
-        return TRUE;
-      }
-      if (pl->source == PAN_SPOT_SOURCE_RBN &&
-          pl->last_update_time != 0 &&
-          now - pl->last_update_time < PAN_RBN_REFRESH_GUARD_US) {
-        return TRUE;
-      }
-    }
-    pl->freq = freq_hz;
-    if (new_priority > old_priority) {
-      pl->source = source;
-    }
-    pl->last_update_time = now;
-    if (lifetime_ms > 0) {
-      pl->expire_time = now + (gint64) lifetime_ms * 1000;
-    } else {
-      pl->expire_time = 0;
-    }
-    return TRUE;
-  }
-  return FALSE;
-}
-
-/* interner Helfer: freien Slot für ein neues Label ermitteln
-* - bevorzugt deaktivierte Einträge wiederverwenden
-* - wenn alle Slots belegt/aktiv sind: FIFO -> ältestes Label (Index 0) raus
-*/
-static PAN_LABEL *pan_label_get_slot(void) {
-  int i;
-  /* 1) deaktivierte Einträge wiederverwenden */
-  for (i = 0; i < pan_label_count; i++) {
-    if (!pan_labels[i].enabled) {
-      return &pan_labels[i];
-    }
-  }
-  /* 2) noch Platz im Array: anhängen */
-  if (pan_label_count < MAX_PAN_LABELS) {
-    return &pan_labels[pan_label_count++];
-  }
-  /* 3) FIFO: ältestes Label (Index 0) verwerfen, Rest nach vorne schieben */
-  memmove(&pan_labels[0], &pan_labels[1],
-          (MAX_PAN_LABELS - 1) * sizeof(PAN_LABEL));
-  pan_label_count = MAX_PAN_LABELS - 1;
-  return &pan_labels[pan_label_count++];
-}
-
-static int pan_label_cmp(const void *a, const void *b) {
-  const PAN_LABEL_POS *pa = (const PAN_LABEL_POS *) a;
-  const PAN_LABEL_POS *pb = (const PAN_LABEL_POS *) b;
-  if (pa->x < pb->x) { return -1; }
-  if (pa->x > pb->x) { return 1; }
-  return 0;
-}
-
 // Example:
 // pan_add_label(7100000LL, "Beacon");
 // pan_add_label(7074000LL, "Relais");
 
 void pan_add_label(long long freq, const char *text) {
-  PAN_LABEL *pl;
-  if (text == NULL) {
-    return;
-  }
-  pl = pan_label_get_slot();
-  pl->freq = freq;
-  pl->enabled = TRUE;
-  pl->source = PAN_SPOT_SOURCE_CUSTOM;
-  pl->last_update_time = g_get_monotonic_time();
-  g_strlcpy(pl->label, text, sizeof(pl->label));
-  pl->expire_time = 0;  /* 0 => kein automatisches Entfernen */
+  dxspot_add(freq, text, PAN_SPOT_SOURCE_CUSTOM, 0);  /* 0 => kein automatisches Entfernen */
 }
 
 // Example:
 // pan_add_label_timeout(7100000LL, "Spot", 5000);  // 5 Sekunden sichtbar
 
 void pan_add_label_timeout(long long freq, const char *text, int lifetime_ms) {
-  PAN_LABEL *pl;
-  if (text == NULL) {
-    return;
-  }
-  pl = pan_label_get_slot();
-  pl->freq = freq;
-  pl->enabled = TRUE;
-  pl->source = PAN_SPOT_SOURCE_CUSTOM;
-  pl->last_update_time = g_get_monotonic_time();
-  g_strlcpy(pl->label, text, sizeof(pl->label));
-  if (lifetime_ms > 0) {
-    gint64 now = g_get_monotonic_time();  /* us */
-    pl->expire_time = now + (gint64) lifetime_ms * 1000;
-  } else {
-    pl->expire_time = 0;  /* 0 => kein Timeout */
-  }
+  dxspot_add(freq, text, PAN_SPOT_SOURCE_CUSTOM, lifetime_ms);
 }
 
 void pan_clear_labels(void) {
-  pan_label_count = 0;
+  dxspot_clear();
 }
 
 void pan_delete_dx_spot(const char *dxcall) {
-  int i;
-  if (dxcall == NULL || dxcall[0] == '\0') {
-    return;
-  }
-  for (i = 0; i < pan_label_count;) {
-    PAN_LABEL *pl = &pan_labels[i];
-    if (pl->enabled && g_strcmp0(pl->label, dxcall) == 0) {
-      if (i < pan_label_count - 1) {
-        memmove(&pan_labels[i], &pan_labels[i + 1],
-                (size_t)(pan_label_count - i - 1) * sizeof(PAN_LABEL));
-      }
-      pan_label_count--;
-      continue;
-    }
-    i++;
-  }
+  dxspot_delete_call(dxcall);
 }
 
 void pan_add_dx_spot(double freq_khz, const char *dxcall) {
@@ -417,8 +260,6 @@ void pan_add_dx_spot(double freq_khz, const char *dxcall) {
 
 void pan_add_dx_spot_source(double freq_khz, const char *dxcall, PAN_SPOT_SOURCE source) {
   long long freq_hz;
-  PAN_LABEL *pl;
-  char label[32];
   if (pan_spot_lifetime_min < 1) { pan_spot_lifetime_min = 1; } // 1min minimum
   if (pan_spot_lifetime_min > 720) { pan_spot_lifetime_min = 720; } // 720min = 12h = maximum
   int lifetime_ms = pan_spot_lifetime_min * 60000;
@@ -430,25 +271,8 @@ void pan_add_dx_spot_source(double freq_khz, const char *dxcall, PAN_SPOT_SOURCE
   }
   /* Cluster-Frequenz kHz → Hz, sauber gerundet */
   freq_hz = (long long)(freq_khz * 1000.0 + 0.5);
-  /* Label-Text – hier nur das Call, ggf. später erweitern */
-  g_strlcpy(label, dxcall, sizeof(label));
-  /* Doublet-Check: gleicher Call auf gleicher Frequenz? -> nur Timeout erneuern */
-  if (pan_dxspot_update_if_exists(freq_hz, label, lifetime_ms, source)) {
-    return;
-  }
-  /* Kein bestehender Eintrag -> neues Label anlegen */
-  pl = pan_label_get_slot();
-  pl->freq = freq_hz;
-  pl->enabled = TRUE;
-  pl->source = source;
-  pl->last_update_time = g_get_monotonic_time();
-  g_strlcpy(pl->label, label, sizeof(pl->label));
-  if (lifetime_ms > 0) {
-    gint64 now = pl->last_update_time;
-    pl->expire_time = now + (gint64) lifetime_ms * 1000;
-  } else {
-    pl->expire_time = 0;
-  }
+  /* Doublet-Check erfolgt im Spot-Store: gleicher Call auf gleicher Frequenz -> nur Timeout erneuern */
+  dxspot_add_dx(freq_hz, dxcall, source, lifetime_ms);
 }
 
 //------------------------------------------------------------------------------
@@ -1308,6 +1132,191 @@ static void rx_panadapter_grid_cache_paint(RECEIVER *rx,
   }
 }
 
+//
+// soffset contains all corrections for attenuation and preamps
+// Perhaps some adjustment is necessary for those old radios which have
+// switchable preamps.
+//
+static double rx_panadapter_soffset(const RECEIVER *rx, int vfo_id) {
+  const BAND *band = band_get_band(vfo[vfo_id].band);
+  int calib = rx_gain_calibration - band->gain;
+  double soffset = (double) calib + (double) adc[rx->adc].attenuation - adc[rx->adc].gain;
+  if (filter_board == ALEX && rx->adc == 0) {
+    soffset += (double)(10 * rx->alex_attenuation - 20 * rx->preamp);
+  }
+  if (filter_board == CHARLY25 && rx->adc == 0) {
+    soffset += (double)(12 * rx->alex_attenuation - 18 * rx->preamp - 18 * rx->dither);
+  }
+  return soffset;
+}
+
+static void rx_panadapter_trace_fill(const RECEIVER *rx, RX_TRACE *t, int width, int height,
+                                     double soffset, double shift, int vfo_id, gboolean active) {
+  t->width = width;
+  t->height = height;
+  t->pan = rx->pan;
+  t->soffset = soffset;
+  t->shift = shift;
+  t->high = rx->panadapter_high;
+  t->low = rx->panadapter_low;
+  t->vhf = vfo[vfo_id].frequency > 30000000LL;
+  t->active = active;
+  t->gradient = rx->display_gradient;
+  t->filled = rx->display_filled;
+  t->peak_preserve = rx->pan_peak_preserve;
+}
+
+//
+// Collect everything the spectrum trace depends on, such that it can
+// be drawn by the render worker. Must be called from the GTK thread.
+//
+gboolean rx_panadapter_trace_setup(RECEIVER *rx, RX_TRACE *t) {
+  if (!rx || !rx->panadapter || !rx->panadapter_surface || rx->hz_per_pixel <= 0.0) {
+    return FALSE;
+  }
+  int vfo_id = rx_panadapter_effective_vfo_id(rx);
+  rx_panadapter_trace_fill(rx, t, gtk_widget_get_allocated_width(rx->panadapter),
+                           gtk_widget_get_allocated_height(rx->panadapter),
+                           rx_panadapter_soffset(rx, vfo_id),
+                           (double) rx_get_mode_dc_offset(vfo_id) / rx->hz_per_pixel,
+                           vfo_id, active_receiver == rx);
+  return TRUE;
+}
+
+gboolean rx_panadapter_trace_equal(const RX_TRACE *a, const RX_TRACE *b) {
+  return a->width == b->width && a->height == b->height && a->pan == b->pan &&
+         a->soffset == b->soffset && a->shift == b->shift && a->high == b->high &&
+         a->low == b->low && a->vhf == b->vhf && a->active == b->active &&
+         a->gradient == b->gradient && a->filled == b->filled &&
+         a->peak_preserve == b->peak_preserve;
+}
+
+//
+// Draw the spectrum trace. This only touches cr and samples and may
+// therefore run on any thread if cr draws to a private image surface.
+//
+void rx_panadapter_trace_draw(cairo_t *cr, const RX_TRACE *t, const float *samples) {
+  int i;
+  int mywidth = t->width;
+  int myheight = t->height;
+  int pan = t->pan;
+  double soffset = t->soffset;
+  double s1;
+  //
+  // most HPSDR only have attenuation (no gain), while HermesLite-II use gain (no attenuation)
+  //
+  s1 = (double) samples[pan] + soffset;
+  s1 = floor((t->high - s1)
+             * (double) myheight
+             / (t->high - t->low));
+  cairo_save(cr);
+  cairo_translate(cr, t->shift, 0.0);
+  cairo_move_to(cr, 0.0, s1);
+  for (i = 1; i < mywidth; i++) {
+    double s2;
+    if (t->peak_preserve) {
+      if (i == mywidth - 1) {
+        s2 = (double) samples[i + pan] + soffset;
+      } else {
+        double yv = (double) samples[i + pan - 1];
+        if ((double) samples[i + pan] > yv) {
+          yv = (double) samples[i + pan];
+        }
+        if ((double) samples[i + pan + 1] > yv) {
+          yv = (double) samples[i + pan + 1];
+        }
+        s2 = yv + soffset;
+      }
+    } else {
+      s2 = (double) samples[i + pan] + soffset;
+    }
+    s2 = floor((t->high - s2)
+               * (double) myheight
+               / (t->high - t->low));
+    cairo_line_to(cr, i, s2);
+  }
+  cairo_pattern_t *gradient;
+  gradient = NULL;
+  if (t->gradient) {
+    gradient = cairo_pattern_create_linear(0.0, myheight, 0.0, 0.0);
+    // calculate where S9 is as gradient offset (0.0 = bottom, 1.0 = top)
+    double denom = (double) t->high - (double) t->low;
+    if (denom <= 0.0) { denom = 1.0; } // Fallback, falls high<=low
+    double S9 = t->vhf ? -93.0 : -73.0;
+    S9 += 10; // 10db nach oben schieben
+    S9 = (S9 - (double) t->low) / denom;
+    S9 = (S9 < 0.0) ? 0.0 : (S9 > 1.0) ? 1.0 : S9;
+    // t_print("S9(off)=%.6f low=%d high=%d h=%d\n", S9, t->low, t->high, myheight);
+    if (t->active) {
+      cairo_pattern_add_color_stop_rgba(gradient, 0.0,       GRAD_GREEN);
+      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.20, GRAD_YELLOW);
+      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.55, GRAD_ORANGE);
+      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.80, GRAD_RED);
+      cairo_pattern_add_color_stop_rgba(gradient, S9,        GRAD_PURPLE);
+    } else {
+      cairo_pattern_add_color_stop_rgba(gradient, 0.0,       GRAD_GREEN_WEAK);
+      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.20, GRAD_YELLOW_WEAK);
+      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.55, GRAD_ORANGE_WEAK);
+      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.80, GRAD_RED_WEAK);
+      cairo_pattern_add_color_stop_rgba(gradient, S9,        GRAD_PURPLE_WEAK);
+    }
+    /*
+        // calculate where S9 is
+        double S9 = -73;
+
+        if (vfo[rx->id].frequency > 30000000LL) {
+          S9 = -93;
+        }
+
+        S9 = floor((t->high - S9)
+                   * (double) myheight
+                   / (t->high - t->low));
+        S9 = 1.0 - (S9 / (double)myheight);
+
+    if (t->active) {
+      cairo_pattern_add_color_stop_rgba(gradient, 0.0,              GRAD_GREEN);
+      cairo_pattern_add_color_stop_rgba(gradient, S9 / 3.0,         GRAD_YELLOW);
+      cairo_pattern_add_color_stop_rgba(gradient, (S9 / 3.0) * 2.0, GRAD_ORANGE);
+      cairo_pattern_add_color_stop_rgba(gradient, S9,               GRAD_RED);
+    } else {
+      cairo_pattern_add_color_stop_rgba(gradient, 0.0,              GRAD_GREEN_WEAK);
+      cairo_pattern_add_color_stop_rgba(gradient, S9 / 3.0,         GRAD_YELLOW_WEAK);
+      cairo_pattern_add_color_stop_rgba(gradient, (S9 / 3.0) * 2.0, GRAD_ORANGE_WEAK);
+      cairo_pattern_add_color_stop_rgba(gradient, S9,               GRAD_RED_WEAK);
+    }
+    */
+    cairo_set_source(cr, gradient);
+  } else {
+    //
+    // Different shades of white
+    //
+    if (t->active) {
+      if (!t->filled) {
+        cairo_set_source_rgba(cr, COLOUR_PAN_FILL3);
+      } else {
+        cairo_set_source_rgba(cr, COLOUR_PAN_FILL2);
+      }
+    } else {
+      cairo_set_source_rgba(cr, COLOUR_PAN_FILL1);
+    }
+  }
+  if (t->filled) {
+    cairo_close_path(cr);
+    cairo_fill_preserve(cr);
+    cairo_set_line_width(cr, PAN_LINE_THIN);
+  } else {
+    //
+    // if not filling, use thicker line
+    //
+    cairo_set_line_width(cr, PAN_LINE_THICK);
+  }
+  cairo_stroke(cr);
+  cairo_restore(cr);
+  if (gradient) {
+    cairo_pattern_destroy(gradient);
+  }
+}
+
 void rx_panadapter_update(RECEIVER *rx) {
   if (!rx || !rx->panadapter_surface) {
     return;
@@ -1343,14 +1352,8 @@ void rx_panadapter_update(RECEIVER *rx) {
   int vfoband = vfo[vfo_id].band;
   long long offset;
   double pan_display_shift = 0.0;
-  //
-  // soffset contains all corrections for attenuation and preamps
-  // Perhaps some adjustment is necessary for those old radios which have
-  // switchable preamps.
-  //
   const BAND *band = band_get_band(vfoband);
-  int calib = rx_gain_calibration - band->gain;
-  soffset = (double) calib + (double) adc[rx->adc].attenuation - adc[rx->adc].gain;
+  soffset = rx_panadapter_soffset(rx, vfo_id);
   //
   // offset is used to calculate the filter edges. They move  with the RIT value
   //
@@ -1359,12 +1362,6 @@ void rx_panadapter_update(RECEIVER *rx) {
   } else {
     offset = vfo[vfo_id].rit_enabled ? vfo[vfo_id].rit : 0;
   }
-  if (filter_board == ALEX && rx->adc == 0) {
-    soffset += (double)(10 * rx->alex_attenuation - 20 * rx->preamp);
-  }
-  if (filter_board == CHARLY25 && rx->adc == 0) {
-    soffset += (double)(12 * rx->alex_attenuation - 18 * rx->preamp - 18 * rx->dither);
-  }
   long long half = (long long) rx->sample_rate / 2LL;
   double vfofreq = ((double) half / HzPerPixel) - (double) rx->pan;
   //
@@ -1480,33 +1477,20 @@ void rx_panadapter_update(RECEIVER *rx) {
    * The user can either keep the overlay on the active RX only, or show spots
    * on all RX panadapters where the spot frequency is in the visible range.
    */
-  if ((!dx_spots_active_rx_only || active) && pan_label_count > 0) {
-    PAN_LABEL_POS pos[MAX_PAN_LABELS];
-    int pos_count = 0;
-    gint64 now = g_get_monotonic_time();  /* us */
-    /* Sichtbare Labels einsammeln, abgelaufene deaktivieren */
-    for (int m = 0; m < pan_label_count; m++) {
-      PAN_LABEL *pl = &pan_labels[m];
-      if (!pl->enabled) {
-        continue;
-      }
-      /* Timeout-Check */
-      if (pl->expire_time != 0 && now >= pl->expire_time) {
-        pl->enabled = FALSE;
-        continue;
-      }
-      /* Außerhalb des sichtbaren Frequenzbereichs */
-      if (pl->freq < min_display || pl->freq > max_display) {
-        continue;
-      }
-      double x = ((double) pl->freq - min_display) / HzPerPixel;
-      pos[pos_count].index = m;
-      pos[pos_count].x = x;
-      pos[pos_count].row = 0;
-      pos_count++;
-      if (pos_count >= MAX_PAN_LABELS) {
-        break;
-      }
+  if (!dx_spots_active_rx_only || active) {
+    DXSPOT_VIEW spots[MAX_PAN_LABELS_VISIBLE];
+    PAN_LABEL_POS pos[MAX_PAN_LABELS_VISIBLE];
+    int pos_count;
+    /* Abgelaufene Spots entfernen, dann nur den sichtbaren Frequenzbereich
+     * abfragen. Der Spot-Store liefert die Spots bereits nach Frequenz
+     * (= von links nach rechts) sortiert.
+     */
+    dxspot_expire(g_get_monotonic_time());
+    pos_count = dxspot_range((long long) ceil(min_display), (long long) floor(max_display),
+                             spots, MAX_PAN_LABELS_VISIBLE);
+    for (int m = 0; m < pos_count; m++) {
+      pos[m].x = ((double) spots[m].freq - min_display) / HzPerPixel;
+      pos[m].row = 0;
     }
     if (pos_count > 0) {
       double last_x_in_row[max_pan_label_rows];
@@ -1514,8 +1498,6 @@ void rx_panadapter_update(RECEIVER *rx) {
       for (int r = 0; r < max_pan_label_rows; r++) {
         last_x_in_row[r] = -1e9;
       }
-      /* Links-nach-rechts sortieren */
-      qsort(pos, pos_count, sizeof(PAN_LABEL_POS), pan_label_cmp);
       /* Reihen (Y-Level) zuweisen, um Überlappung zu minimieren */
       for (int i = 0; i < pos_count; i++) {
         double x = pos[i].x;
@@ -1537,7 +1519,7 @@ void rx_panadapter_update(RECEIVER *rx) {
       }
       /* Labels zeichnen */
       for (int i = 0; i < pos_count; i++) {
-        PAN_LABEL *pl = &pan_labels[pos[i].index];
+        const DXSPOT_VIEW *pl = &spots[i];
         double x = pos[i].x;
         int row = pos[i].row;
         cairo_select_font_face(cr,
@@ -1611,7 +1593,6 @@ void rx_panadapter_update(RECEIVER *rx) {
   cairo_close_path(cr);
   cairo_fill(cr);
   // signal
-  double s1;
   int pan = rx->pan;
   samples[pan] = -200.0;
   samples[mywidth - 1 + pan] = -200.0;
@@ -1712,116 +1693,11 @@ void rx_panadapter_update(RECEIVER *rx) {
       }
     }
   }
-  //
-  // most HPSDR only have attenuation (no gain), while HermesLite-II use gain (no attenuation)
-  //
-  s1 = (double) samples[pan] + soffset;
-  s1 = floor((rx->panadapter_high - s1)
-             * (double) myheight
-             / (rx->panadapter_high - rx->panadapter_low));
-  cairo_save(cr);
-  cairo_translate(cr, pan_display_shift, 0.0);
-  cairo_move_to(cr, 0.0, s1);
-  for (i = 1; i < mywidth; i++) {
-    double s2;
-    if (rx->pan_peak_preserve) {
-      if (i == mywidth - 1) {
-        s2 = (double) samples[i + pan] + soffset;
-      } else {
-        double yv = (double) samples[i + pan - 1];
-        if ((double) samples[i + pan] > yv) {
-          yv = (double) samples[i + pan];
-        }
-        if ((double) samples[i + pan + 1] > yv) {
-          yv = (double) samples[i + pan + 1];
-        }
-        s2 = yv + soffset;
-      }
-    } else {
-      s2 = (double) samples[i + pan] + soffset;
-    }
-    s2 = floor((rx->panadapter_high - s2)
-               * (double) myheight
-               / (rx->panadapter_high - rx->panadapter_low));
-    cairo_line_to(cr, i, s2);
-  }
-  cairo_pattern_t *gradient;
-  gradient = NULL;
-  if (rx->display_gradient) {
-    gradient = cairo_pattern_create_linear(0.0, myheight, 0.0, 0.0);
-    // calculate where S9 is as gradient offset (0.0 = bottom, 1.0 = top)
-    double denom = (double) rx->panadapter_high - (double) rx->panadapter_low;
-    if (denom <= 0.0) { denom = 1.0; } // Fallback, falls high<=low
-    double S9 = ((vfo[vfo_id].frequency > 30000000LL) ? -93.0 : -73.0);
-    S9 += 10; // 10db nach oben schieben
-    S9 = (S9 - (double) rx->panadapter_low) / denom;
-    S9 = (S9 < 0.0) ? 0.0 : (S9 > 1.0) ? 1.0 : S9;
-    // t_print("S9(off)=%.6f low=%d high=%d h=%d\n", S9, rx->panadapter_low, rx->panadapter_high, myheight);
-    if (active) {
-      cairo_pattern_add_color_stop_rgba(gradient, 0.0,       GRAD_GREEN);
-      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.20, GRAD_YELLOW);
-      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.55, GRAD_ORANGE);
-      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.80, GRAD_RED);
-      cairo_pattern_add_color_stop_rgba(gradient, S9,        GRAD_PURPLE);
-    } else {
-      cairo_pattern_add_color_stop_rgba(gradient, 0.0,       GRAD_GREEN_WEAK);
-      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.20, GRAD_YELLOW_WEAK);
-      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.55, GRAD_ORANGE_WEAK);
-      cairo_pattern_add_color_stop_rgba(gradient, S9 * 0.80, GRAD_RED_WEAK);
-      cairo_pattern_add_color_stop_rgba(gradient, S9,        GRAD_PURPLE_WEAK);
-    }
-    /*
-        // calculate where S9 is
-        double S9 = -73;
-
-        if (vfo[rx->id].frequency > 30000000LL) {
-          S9 = -93;
-        }
-
-        S9 = floor((rx->panadapter_high - S9)
-                   * (double) myheight
-                   / (rx->panadapter_high - rx->panadapter_low));
-        S9 = 1.0 - (S9 / (double)myheight);
-
-    if (active) {
-      cairo_pattern_add_color_stop_rgba(gradient, 0.0,              GRAD_GREEN);
-      cairo_pattern_add_color_stop_rgba(gradient, S9 / 3.0,         GRAD_YELLOW);
-      cairo_pattern_add_color_stop_rgba(gradient, (S9 / 3.0) * 2.0, GRAD_ORANGE);
-      cairo_pattern_add_color_stop_rgba(gradient, S9,               GRAD_RED);
-    } else {
-      cairo_pattern_add_color_stop_rgba(gradient, 0.0,              GRAD_GREEN_WEAK);
-      cairo_pattern_add_color_stop_rgba(gradient, S9 / 3.0,         GRAD_YELLOW_WEAK);
-      cairo_pattern_add_color_stop_rgba(gradient, (S9 / 3.0) * 2.0, GRAD_ORANGE_WEAK);
-      cairo_pattern_add_color_stop_rgba(gradient, S9,               GRAD_RED_WEAK);
-    }
-    */
-    cairo_set_source(cr, gradient);
-  } else {
-    //
-    // Different shades of white
-    //
-    if (active) {
-      if (!rx->display_filled) {
-        cairo_set_source_rgba(cr, COLOUR_PAN_FILL3);
-      } else {
-        cairo_set_source_rgba(cr, COLOUR_PAN_FILL2);
-      }
-    } else {
-      cairo_set_source_rgba(cr, COLOUR_PAN_FILL1);
-    }
-  }
-  if (rx->display_filled) {
-    cairo_close_path(cr);
-    cairo_fill_preserve(cr);
-    cairo_set_line_width(cr, PAN_LINE_THIN);
-  } else {
-    //
-    // if not filling, use thicker line
-    //
-    cairo_set_line_width(cr, PAN_LINE_THICK);
+  RX_TRACE trace;
+  rx_panadapter_trace_fill(rx, &trace, mywidth, myheight, soffset, pan_display_shift, vfo_id, active);
+  if (!rx_render_paint_trace(rx, cr, &trace)) {
+    rx_panadapter_trace_draw(cr, &trace, samples);
   }
-  cairo_stroke(cr);
-  cairo_restore(cr);
   //---------------------------------------------------------------------------------------
   // Peak-and-Hold trace rendering
   if (pan_peak_hold_enabled && rx->id >= 0 && rx->id < PAN_PEAK_HOLD_MAX_RX) {
@@ -1850,9 +1726,6 @@ void rx_panadapter_update(RECEIVER *rx) {
       cairo_restore(cr);
     }
   }
-  if (gradient) {
-    cairo_pattern_destroy(gradient);
-  }
   rx_panadapter_draw_image_measure(cr, rx, mywidth, myheight);
   //---------------------------------------------------------------------------------------
   // move downward to show the line, otherwise the spectrum overlay this line
@@ -22,23 +22,41 @@
 #ifndef _PANADAPTER_H
 #define _PANADAPTER_H
 
+#include "dxspot.h"
+
+//
+// Parameters of the spectrum trace. rx_panadapter_trace_setup() collects
+// them on the GTK thread, rx_panadapter_trace_draw() may run on the render
+// worker.
+//
+typedef struct {
+  int width;
+  int height;
+  int pan;
+  double soffset;
+  double shift;
+  int high;
+  int low;
+  int vhf;
+  int active;
+  int gradient;
+  int filled;
+  int peak_preserve;
+} RX_TRACE;
+
 // int compare_doubles(const void *a, const void *b);
 void panadapter_set_max_label_rows(int r);
 void pan_add_label(long long freq, const char *text);
 void pan_add_label_timeout(long long freq, const char *text, int lifetime_ms);
 void pan_clear_labels(void);
-typedef enum {
-  PAN_SPOT_SOURCE_CUSTOM = 0,
-  PAN_SPOT_SOURCE_CLUSTER,
-  PAN_SPOT_SOURCE_TCI,
-  PAN_SPOT_SOURCE_RBN
-} PAN_SPOT_SOURCE;
-
 void pan_delete_dx_spot(const char *dxcall);
 void pan_add_dx_spot(double freq_khz, const char *dxcall);
 void pan_add_dx_spot_source(double freq_khz, const char *dxcall, PAN_SPOT_SOURCE source);
 void rx_panadapter_peak_hold_clear(RECEIVER *rx);
 void rx_panadapter_update(RECEIVER* rx);
+gboolean rx_panadapter_trace_setup(RECEIVER *rx, RX_TRACE *t);
+gboolean rx_panadapter_trace_equal(const RX_TRACE *a, const RX_TRACE *b);
+void rx_panadapter_trace_draw(cairo_t *cr, const RX_TRACE *t, const float *samples);
 void rx_panadapter_init(RECEIVER *rx, int width, int height);
 void display_panadapter_messages(cairo_t *cr, int width, unsigned int fps);
 void rx_update_mnf_from_gui(RECEIVER *rx);
@@ -0,0 +1,271 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Render worker for the receiver displays.
+ *
+ * Each display tick of a receiver runs on the GTK thread as
+ *
+ *   rx_render_fetch()   pick up the frame finished by the worker
+ *   (draw)              panadapter overlays and waterfall scroll, using
+ *                       rx_render_paint_trace() and rx_render_take_row()
+ *   rx_render_post()    hand the current display parameters to the worker
+ *
+ * while the worker, for each posted receiver,
+ *
+ * - fetches the analyzer output (GetPixels),
+ * - draws the spectrum trace into a private ARGB image surface,
+ * - colour-maps the next waterfall row.
+ *
+ * The GTK thread thus only blits the trace and copies one waterfall row,
+ * at the cost of one frame of display latency. If the display parameters
+ * changed between post and fetch (resize, pan, levels), the stale trace or
+ * row is ignored and drawn on the GTK thread instead.
+ *
+ * Job ownership is handed over through the job state: while a job is
+ * QUEUED or BUSY, its buffers belong to the worker, else to the GTK thread.
+ */
+
+#include <gtk/gtk.h>
+#include <string.h>
+
+#include <wdsp.h>
+
+#include "receiver.h"
+#include "rx_panadapter.h"
+#include "rx_render.h"
+#include "waterfall.h"
+
+typedef enum {
+  RX_RENDER_IDLE = 0,
+  RX_RENDER_QUEUED,
+  RX_RENDER_BUSY,
+  RX_RENDER_DONE
+} RX_RENDER_STATE;
+
+typedef struct {
+  RX_RENDER_STATE state;
+  RECEIVER *rx;
+  //
+  // input, set by rx_render_post()
+  //
+  gboolean want_trace;
+  gboolean want_row;
+  RX_TRACE trace;
+  WATERFALL_ROW row;
+  //
+  // output
+  //
+  int rc;
+  int pixels;
+  float *samples;
+  cairo_surface_t *layer;
+  unsigned char *wf_row;
+  int wf_row_width;
+  float wf_low;
+  float wf_high;
+  gint64 render_us;
+  //
+  // set by rx_render_fetch() if trace and row belong to the frame
+  // just fetched
+  //
+  gboolean have_trace;
+  gboolean have_row;
+} RX_RENDER_JOB;
+
+static GMutex render_mutex;
+static GCond render_cond;
+static GThread *render_thread_id = NULL;
+static RX_RENDER_JOB jobs[RX_RENDER_MAX_RX];
+
+static RX_RENDER_JOB *rx_render_job(const RECEIVER *rx) {
+  if (rx == NULL || rx->id < 0 || rx->id >= RX_RENDER_MAX_RX) {
+    return NULL;
+  }
+  return &jobs[rx->id];
+}
+
+static void rx_render_run(RX_RENDER_JOB *job) {
+  RECEIVER *rx = job->rx;
+  gint64 start = g_get_monotonic_time();
+  g_mutex_lock(&rx->display_mutex);
+  if (job->pixels != rx->pixels) {
+    g_free(job->samples);
+    job->pixels = rx->pixels;
+    job->samples = g_new(float, job->pixels);
+  }
+  GetPixels(rx->id, 0, job->samples, &job->rc);
+  g_mutex_unlock(&rx->display_mutex);
+  job->have_trace = FALSE;
+  job->have_row = FALSE;
+  if (job->rc) {
+    RX_TRACE *t = &job->trace;
+    WATERFALL_ROW *w = &job->row;
+    if (job->want_trace && t->width > 0 && t->height > 0 && t->pan >= 0 && t->pan + t->width <= job->pixels) {
+      if (job->layer == NULL || cairo_image_surface_get_width(job->layer) != t->width
+          || cairo_image_surface_get_height(job->layer) != t->height) {
+        if (job->layer != NULL) {
+          cairo_surface_destroy(job->layer);
+        }
+        job->layer = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, t->width, t->height);
+      }
+      //
+      // same edge handling as in rx_panadapter_update(), the waterfall
+      // row below then sees the same samples as on the GTK thread
+      //
+      job->samples[t->pan] = -200.0;
+      job->samples[t->width - 1 + t->pan] = -200.0;
+      cairo_t *cr = cairo_create(job->layer);
+      cairo_set_operator(cr, CAIRO_OPERATOR_CLEAR);
+      cairo_paint(cr);
+      cairo_set_operator(cr, CAIRO_OPERATOR_OVER);
+      rx_panadapter_trace_draw(cr, t, job->samples);
+      cairo_destroy(cr);
+      cairo_surface_flush(job->layer);
+      job->have_trace = cairo_surface_status(job->layer) == CAIRO_STATUS_SUCCESS;
+    }
+    if (job->want_row && w->width > 0 && w->pan >= 0 && w->pan + w->width <= job->pixels) {
+      if (job->wf_row_width != w->width) {
+        g_free(job->wf_row);
+        job->wf_row_width = w->width;
+        job->wf_row = g_new(unsigned char, (size_t) 3 * w->width);
+      }
+      waterfall_row_render(w, job->samples, job->wf_row, &job->wf_low, &job->wf_high);
+      job->have_row = TRUE;
+    }
+  }
+  job->render_us = g_get_monotonic_time() - start;
+}
+
+static gpointer rx_render_thread(gpointer data) {
+  g_mutex_lock(&render_mutex);
+  for (;;) {
+    RX_RENDER_JOB *job = NULL;
+    for (int i = 0; i < RX_RENDER_MAX_RX; i++) {
+      if (jobs[i].state == RX_RENDER_QUEUED) {
+        job = &jobs[i];
+        break;
+      }
+    }
+    if (job == NULL) {
+      g_cond_wait(&render_cond, &render_mutex);
+      continue;
+    }
+    job->state = RX_RENDER_BUSY;
+    g_mutex_unlock(&render_mutex);
+    rx_render_run(job);
+    g_mutex_lock(&render_mutex);
+    job->state = RX_RENDER_DONE;
+  }
+  return NULL;
+}
+
+//
+// Called on the GTK thread with rx->display_mutex held, in place of
+// rx_get_pixels(). Returns FALSE if rx is not handled by the worker.
+// Otherwise *rc is the GetPixels() result of the finished frame (0 if the
+// worker has nothing new, in which case nothing needs to be drawn), and
+// the frame's samples have been copied to rx->pixel_samples.
+//
+gboolean rx_render_fetch(RECEIVER *rx, int *rc, gint64 *render_us) {
+  RX_RENDER_JOB *job = rx_render_job(rx);
+  *rc = 0;
+  *render_us = 0;
+  if (job == NULL) {
+    return FALSE;
+  }
+  g_mutex_lock(&render_mutex);
+  if (job->state != RX_RENDER_DONE) {
+    g_mutex_unlock(&render_mutex);
+    return TRUE;
+  }
+  job->state = RX_RENDER_IDLE;
+  g_mutex_unlock(&render_mutex);
+  *render_us = job->render_us;
+  if (job->rc && job->pixels == rx->pixels && rx->pixel_samples != NULL) {
+    memcpy(rx->pixel_samples, job->samples, (size_t) job->pixels * sizeof(float));
+    *rc = job->rc;
+  } else {
+    job->have_trace = FALSE;
+    job->have_row = FALSE;
+  }
+  return TRUE;
+}
+
+//
+// Called on the GTK thread after the display has been updated: queue the
+// next frame, unless the worker is still busy with the previous one.
+//
+void rx_render_post(RECEIVER *rx) {
+  RX_RENDER_JOB *job = rx_render_job(rx);
+  if (job == NULL) {
+    return;
+  }
+  g_mutex_lock(&render_mutex);
+  if (job->state == RX_RENDER_QUEUED || job->state == RX_RENDER_BUSY) {
+    g_mutex_unlock(&render_mutex);
+    return;
+  }
+  g_mutex_unlock(&render_mutex);
+  job->rx = rx;
+  job->have_trace = FALSE;
+  job->have_row = FALSE;
+  job->want_trace = rx->display_panadapter && rx_panadapter_trace_setup(rx, &job->trace);
+  job->want_row = rx->display_waterfall && waterfall_row_setup(rx, &job->row);
+  g_mutex_lock(&render_mutex);
+  job->state = RX_RENDER_QUEUED;
+  if (render_thread_id == NULL) {
+    render_thread_id = g_thread_new("RX render", rx_render_thread, NULL);
+  }
+  g_cond_signal(&render_cond);
+  g_mutex_unlock(&render_mutex);
+}
+
+//
+// Blit the trace drawn by the worker. Returns FALSE (nothing drawn) if
+// there is none for this frame or it was drawn with other parameters.
+//
+gboolean rx_render_paint_trace(RECEIVER *rx, cairo_t *cr, const RX_TRACE *t) {
+  RX_RENDER_JOB *job = rx_render_job(rx);
+  if (job == NULL || !job->have_trace || !rx_panadapter_trace_equal(&job->trace, t)) {
+    return FALSE;
+  }
+  job->have_trace = FALSE;
+  cairo_save(cr);
+  cairo_set_source_surface(cr, job->layer, 0.0, 0.0);
+  cairo_paint(cr);
+  cairo_restore(cr);
+  return TRUE;
+}
+
+//
+// Copy the waterfall row rendered by the worker to p. Returns FALSE if
+// there is none for this frame or it was rendered with other parameters.
+//
+gboolean rx_render_take_row(RECEIVER *rx, const WATERFALL_ROW *w, unsigned char *p,
+                            float *low, float *high) {
+  RX_RENDER_JOB *job = rx_render_job(rx);
+  if (job == NULL || !job->have_row || !waterfall_row_equal(&job->row, w)) {
+    return FALSE;
+  }
+  job->have_row = FALSE;
+  memcpy(p, job->wf_row, (size_t) 3 * w->width);
+  *low = job->wf_low;
+  *high = job->wf_high;
+  return TRUE;
+}
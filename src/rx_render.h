@@ -0,0 +1,38 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef _RX_RENDER_H
+#define _RX_RENDER_H
+
+#include "receiver.h"
+#include "rx_panadapter.h"
+#include "waterfall.h"
+
+//
+// Receivers handled by the render worker (RX1 and RX2). Other receivers
+// (PureSignal feedback) are drawn on the GTK thread as before.
+//
+#define RX_RENDER_MAX_RX 2
+
+extern gboolean rx_render_fetch(RECEIVER *rx, int *rc, gint64 *render_us);
+extern void rx_render_post(RECEIVER *rx);
+extern gboolean rx_render_paint_trace(RECEIVER *rx, cairo_t *cr, const RX_TRACE *t);
+extern gboolean rx_render_take_row(RECEIVER *rx, const WATERFALL_ROW *w, unsigned char *p,
+                                   float *low, float *high);
+
+#endif
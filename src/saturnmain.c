@@ -62,6 +62,7 @@
 #include "discovered.h"
 #include "new_protocol.h"
 #include "message.h"
+#include "thread_role.h"
 
 extern sem_t DDCInSelMutex;                 // protect access to shared DDC input select register
 extern sem_t DDCResetFIFOMutex;             // protect access to FIFO reset register
@@ -660,6 +661,7 @@ void start_saturn_high_priority_thread(void) {
 }
 
 static gpointer saturn_high_priority_thread(gpointer arg) {
+  thread_role_enter(THREAD_ROLE_RADIO_RX, "SATURN HP OUT");
   uint8_t Byte;                                   // data being encoded
   uint16_t Word;                                  // data being encoded
   uint8_t ADCOverflows = 0;                       // set to non-zero if ADC overflows detected
@@ -791,6 +793,7 @@ void start_saturn_micaudio_thread(void) {
 }
 
 static gpointer saturn_micaudio_thread(gpointer arg) {
+  thread_role_enter(THREAD_ROLE_RADIO_TX, "SATURN MIC");
   t_print("%s\n", __func__);
   //
   // variables for DMA buffer
@@ -938,6 +941,7 @@ extern struct ThreadSocketData SocketData[VPORTTABLESIZE];
 extern struct sockaddr_in reply_addr;
 
 static gpointer saturn_rx_thread(gpointer arg) {
+  thread_role_enter(THREAD_ROLE_RADIO_RX, "SATURN RX");
   t_print("%s\n", __func__);
   //
   // memory buffers
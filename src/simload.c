@@ -0,0 +1,195 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Load-generator mode for hpsdrsim (option -load <scenario file>)
+ *
+ * The normal simulator computes cos/sin per sample for its test tones,
+ * which limits the number of DDCs it can feed at high sample rates.
+ * In load mode, the RX signal is a 100 msec table at 1536 kHz, built
+ * once from the scenario, and the sample loops of both protocols only
+ * step through this table (decimating for lower sample rates, like the
+ * diversity table). Additionally, the outgoing RX IQ packets can be
+ * dropped, re-ordered and delayed at random.
+ *
+ * The number of DDCs and their sample rates are those requested by
+ * the client, so these are set up in the client.
+ *
+ * Scenario file: one statement per line, '#' starts a comment.
+ *
+ *   tone    <offset Hz> <level dBm>              (up to LOAD_MAX_TONES)
+ *   noise   <level dBm>                          broadband noise
+ *   pulse   <pulses/sec> <width usec> <level dBm> impulse noise
+ *   loss    <percent>                            drop packets
+ *   reorder <percent>                            swap with the next packet
+ *   jitter  <usec>                               random send delay
+ *
+ * Tone offsets are rounded to the 10 Hz raster of the table, and should
+ * be within +/- half the lowest sample rate in use. A level of -73 dBm
+ * corresponds to the S9 signal of the normal simulator.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#define EXTERN extern
+#include "hpsdrsim.h"
+
+#define LOAD_MAX_TONES 32
+#define LOAD_REPORT    100000  // report statistics every so many packets
+
+typedef struct {
+  unsigned int seed;
+  int held;                    // a packet is held back, to be sent after the next one
+  size_t held_len;
+  struct sockaddr_in held_addr;
+  unsigned char held_buf[1444];
+  unsigned long sent, lost, reordered;
+} LOAD_STREAM;
+
+static LOAD_STREAM streams[LOAD_STREAMS];
+
+static double load_amplitude(double dbm) {
+  return 0.0002239 * pow(10.0, 0.05 * (dbm + 73.0));
+}
+
+int load_scenario(const char *filename) {
+  FILE *fp;
+  char line[256];
+  double tone_off[LOAD_MAX_TONES];
+  double tone_amp[LOAD_MAX_TONES];
+  int tones = 0;
+  double noise_amp = 0.0;
+  double pulse_rate = 0.0, pulse_width = 0.0, pulse_amp = 0.0;
+  double a, b, c;
+  unsigned int seed = 4711;
+  int lineno = 0;
+  fp = fopen(filename, "r");
+  if (fp == NULL) {
+    t_perror(filename);
+    return -1;
+  }
+  load_loss = 0.0;
+  load_reorder = 0.0;
+  load_jitter = 0;
+  while (fgets(line, sizeof(line), fp)) {
+    char *cp = strchr(line, '#');
+    lineno++;
+    if (cp) { *cp = 0; }
+    if (sscanf(line, " tone %lf %lf", &a, &b) == 2) {
+      if (tones < LOAD_MAX_TONES) {
+        tone_off[tones] = 10.0 * round(0.1 * a);
+        tone_amp[tones] = load_amplitude(b);
+        tones++;
+      }
+    } else if (sscanf(line, " noise %lf", &a) == 1) {
+      noise_amp = load_amplitude(a);
+    } else if (sscanf(line, " pulse %lf %lf %lf", &a, &b, &c) == 3) {
+      pulse_rate = a;
+      pulse_width = b;
+      pulse_amp = load_amplitude(c);
+    } else if (sscanf(line, " loss %lf", &a) == 1) {
+      load_loss = a;
+    } else if (sscanf(line, " reorder %lf", &a) == 1) {
+      load_reorder = a;
+    } else if (sscanf(line, " jitter %lf", &a) == 1) {
+      load_jitter = (int) a;
+    } else if (strspn(line, " \t\r\n") != strlen(line)) {
+      t_print("%s:%d: invalid line ignored\n", filename, lineno);
+    }
+  }
+  fclose(fp);
+  //
+  // Build the signal table. The table length is 100 msec, so tones on
+  // a 10 Hz raster are periodic within the table.
+  //
+  for (int i = 0; i < LENLOAD; i++) {
+    loadItab[i] = noise_amp * ((double) rand_r(&seed) / (RAND_MAX / 2) - 1.0);
+    loadQtab[i] = noise_amp * ((double) rand_r(&seed) / (RAND_MAX / 2) - 1.0);
+  }
+  for (int k = 0; k < tones; k++) {
+    double delta = 6.283185307179586476925286766559 * tone_off[k] / 1536000.0;
+    for (int i = 0; i < LENLOAD; i++) {
+      loadItab[i] += tone_amp[k] * cos(delta * i);
+      loadQtab[i] += tone_amp[k] * sin(delta * i);
+    }
+  }
+  if (pulse_rate > 0.0 && pulse_width > 0.0) {
+    int num = (int)(pulse_rate * LENLOAD / 1536000.0 + 0.5);
+    int width = (int)(pulse_width * 1.536 + 0.5);
+    if (num < 1) { num = 1; }
+    if (width > LENLOAD / num) { width = LENLOAD / num; }
+    for (int n = 0; n < num; n++) {
+      int start = n * (LENLOAD / num);
+      for (int i = start; i < start + width; i++) {
+        loadItab[i] += pulse_amp;
+      }
+    }
+  }
+  for (int i = 0; i < LOAD_STREAMS; i++) {
+    memset(&streams[i], 0, sizeof(LOAD_STREAM));
+    streams[i].seed = 1234 + i;
+  }
+  t_print("LOAD scenario %s: %d tones, noise=%g, pulses=%g/sec\n", filename, tones, noise_amp, pulse_rate);
+  t_print("LOAD network: loss=%g%% reorder=%g%% jitter=%d usec\n", load_loss, load_reorder, load_jitter);
+  load_mode = 1;
+  return 0;
+}
+
+//
+// sendto() replacement for the RX IQ packets. Each stream must only be
+// used by a single thread.
+//
+ssize_t load_sendto(int stream, int sock, const void *buf, size_t len, const struct sockaddr_in *addr) {
+  ssize_t rc;
+  LOAD_STREAM *s;
+  if (!load_mode || stream < 0 || stream >= LOAD_STREAMS) {
+    return sendto(sock, buf, len, 0, (const struct sockaddr *)addr, sizeof(*addr));
+  }
+  s = &streams[stream];
+  if (load_jitter > 0) {
+    usleep(rand_r(&s->seed) % load_jitter);
+  }
+  if (100.0 * rand_r(&s->seed) < load_loss * RAND_MAX) {
+    s->lost++;
+    return (ssize_t) len;
+  }
+  if (!s->held && len <= sizeof(s->held_buf) && 100.0 * rand_r(&s->seed) < load_reorder * RAND_MAX) {
+    memcpy(s->held_buf, buf, len);
+    s->held_len = len;
+    s->held_addr = *addr;
+    s->held = 1;
+    return (ssize_t) len;
+  }
+  rc = sendto(sock, buf, len, 0, (const struct sockaddr *)addr, sizeof(*addr));
+  if (s->held) {
+    sendto(sock, s->held_buf, s->held_len, 0, (const struct sockaddr *)&s->held_addr, sizeof(s->held_addr));
+    s->held = 0;
+    s->reordered++;
+  }
+  if (++s->sent % LOAD_REPORT == 0) {
+    t_print("LOAD stream %d: sent=%lu lost=%lu reordered=%lu\n", stream, s->sent, s->lost, s->reordered);
+  }
+  return rc;
+}
@@ -0,0 +1,239 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Batched hand-over of DX spots from the RBN and DX cluster worker threads
+ * to the GTK thread.
+ *
+ * spotfeed_push() may be called from any thread. It
+ *
+ * - drops RBN spots that are not on a band shown by any receiver
+ *   (RBN spots live for one minute only, so nothing is lost), and
+ *   drops spots if the pending batch overflows (counted separately),
+ * - drops duplicates (same call within 1 kHz, RBN within 30 sec,
+ *   other sources within the same batch),
+ * - collects the remaining spots in a pending batch.
+ *
+ * The batch is handed to the spot store from a GTK timeout at most every
+ * SPOTFEED_FLUSH_MS, such that a busy RBN feed does not create one main
+ * loop event per spot.
+ */
+
+#include <gtk/gtk.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "band.h"
+#include "notify_bus.h"
+#include "radio.h"
+#include "receiver.h"
+#include "rx_panadapter.h"
+#include "spotfeed.h"
+#include "vfo.h"
+
+#define SPOTFEED_MAX_PENDING 2048
+#define SPOTFEED_MAX_BANDS 8
+#define SPOTFEED_RBN_DUPE_US (30LL * 1000000LL)
+#define SPOTFEED_DUPE_PRUNE 4096
+
+typedef struct {
+  double freq_khz;
+  char call[32];
+  PAN_SPOT_SOURCE source;
+} SPOTFEED_ITEM;
+
+typedef struct {
+  long long low;
+  long long high;
+} SPOTFEED_RANGE;
+
+static GMutex spotfeed_mutex;
+static SPOTFEED_ITEM pending[SPOTFEED_MAX_PENDING];
+static int pending_count = 0;
+static guint flush_id = 0;
+static GHashTable *recent = NULL;      // "CALL/kHz" -> last time seen (us)
+static SPOTFEED_STATS stats;
+
+//
+// Bands shown by the receivers. Written by the GTK thread whenever a VFO
+// or the set of receivers changes, read by the worker threads (both under
+// spotfeed_mutex). band_count == 0 means "no band restriction".
+//
+static SPOTFEED_RANGE bands[SPOTFEED_MAX_BANDS];
+static int band_count = 0;
+static int notify_handle = 0;
+
+static gboolean spotfeed_flush_cb(gpointer data);
+
+static void spotfeed_update_bands_locked(void) {
+  int n = 0;
+  for (int i = 0; i < receivers && i < SPOTFEED_MAX_BANDS; i++) {
+    if (receiver[i] == NULL) { continue; }
+    const BAND *b = band_get_band(vfo[receiver[i]->id].band);
+    if (b == NULL || b->frequencyMin == 0LL || b->frequencyMax <= b->frequencyMin) {
+      // general coverage, do not restrict
+      n = 0;
+      break;
+    }
+    bands[n].low = b->frequencyMin;
+    bands[n].high = b->frequencyMax;
+    n++;
+  }
+  band_count = n;
+}
+
+static gboolean spotfeed_on_band_locked(long long freq) {
+  if (band_count == 0) {
+    return TRUE;
+  }
+  for (int i = 0; i < band_count; i++) {
+    if (freq >= bands[i].low && freq <= bands[i].high) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+static gboolean spotfeed_prune_cb(gpointer key, gpointer value, gpointer data) {
+  gint64 limit = *(const gint64 *) data;
+  return *(const gint64 *) value < limit;
+}
+
+static gboolean spotfeed_is_dupe_locked(const char *call, double freq_khz, PAN_SPOT_SOURCE source, gint64 now) {
+  char key[48];
+  gint64 window;
+  gint64 *last;
+  if (recent == NULL) {
+    recent = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+  }
+  window = (source == PAN_SPOT_SOURCE_RBN) ? SPOTFEED_RBN_DUPE_US : SPOTFEED_FLUSH_MS * 1000LL;
+  snprintf(key, sizeof(key), "%s/%lld", call, (long long)(freq_khz + 0.5));
+  for (char *p = key; *p; p++) {
+    *p = g_ascii_toupper(*p);
+  }
+  last = g_hash_table_lookup(recent, key);
+  if (last != NULL) {
+    if (now - *last < window) {
+      return TRUE;
+    }
+    *last = now;
+    return FALSE;
+  }
+  if (g_hash_table_size(recent) >= SPOTFEED_DUPE_PRUNE) {
+    gint64 limit = now - SPOTFEED_RBN_DUPE_US;
+    g_hash_table_foreach_remove(recent, spotfeed_prune_cb, &limit);
+  }
+  last = g_new(gint64, 1);
+  *last = now;
+  g_hash_table_insert(recent, g_strdup(key), last);
+  return FALSE;
+}
+
+void spotfeed_push(double freq_khz, const char *call, PAN_SPOT_SOURCE source) {
+  gint64 now;
+  if (call == NULL || call[0] == '\0' || freq_khz <= 0.0) {
+    return;
+  }
+  now = g_get_monotonic_time();
+  g_mutex_lock(&spotfeed_mutex);
+  stats.received++;
+  if (source == PAN_SPOT_SOURCE_RBN && !spotfeed_on_band_locked((long long)(freq_khz * 1000.0 + 0.5))) {
+    stats.filtered++;
+    g_mutex_unlock(&spotfeed_mutex);
+    return;
+  }
+  if (pending_count >= SPOTFEED_MAX_PENDING) {
+    //
+    // GTK thread is not keeping up, drop the spot. This is checked before
+    // the dupe check, such that a dropped spot is not remembered as "seen"
+    // and suppressed when it is re-spotted.
+    //
+    stats.overflow++;
+    g_mutex_unlock(&spotfeed_mutex);
+    return;
+  }
+  if (spotfeed_is_dupe_locked(call, freq_khz, source, now)) {
+    stats.duplicates++;
+    g_mutex_unlock(&spotfeed_mutex);
+    return;
+  }
+  SPOTFEED_ITEM *item = &pending[pending_count++];
+  item->freq_khz = freq_khz;
+  item->source = source;
+  g_strlcpy(item->call, call, sizeof(item->call));
+  if (flush_id == 0) {
+    flush_id = g_timeout_add(SPOTFEED_FLUSH_MS, spotfeed_flush_cb, NULL);
+  }
+  g_mutex_unlock(&spotfeed_mutex);
+}
+
+//
+// Runs on the GTK thread: hand the pending batch to the spot store.
+//
+void spotfeed_flush_now(void) {
+  static SPOTFEED_ITEM batch[SPOTFEED_MAX_PENDING];
+  int n;
+  g_mutex_lock(&spotfeed_mutex);
+  n = pending_count;
+  memcpy(batch, pending, (size_t) n * sizeof(SPOTFEED_ITEM));
+  pending_count = 0;
+  stats.displayed += n;
+  g_mutex_unlock(&spotfeed_mutex);
+  for (int i = 0; i < n; i++) {
+    pan_add_dx_spot_source(batch[i].freq_khz, batch[i].call, batch[i].source);
+  }
+}
+
+static gboolean spotfeed_flush_cb(gpointer data) {
+  g_mutex_lock(&spotfeed_mutex);
+  flush_id = 0;
+  g_mutex_unlock(&spotfeed_mutex);
+  spotfeed_flush_now();
+  return G_SOURCE_REMOVE;
+}
+
+//
+// Runs on the GTK thread: refresh the band snapshot used by the workers
+// after a band change, a frequency change (which may cross a band edge),
+// or a change of the number of receivers (which re-activates RX1).
+//
+static void spotfeed_notify_cb(unsigned int changes, gpointer data) {
+  g_mutex_lock(&spotfeed_mutex);
+  spotfeed_update_bands_locked();
+  g_mutex_unlock(&spotfeed_mutex);
+}
+
+void spotfeed_init(void) {
+  if (notify_handle == 0) {
+    notify_handle = notify_subscribe(NOTIFY_VFOS | NOTIFY_VFO_A_FREQ | NOTIFY_VFO_B_FREQ | NOTIFY_ACTIVE_RX,
+                                     NOTIFY_ORIGIN_NONE, spotfeed_notify_cb, NULL);
+  }
+  spotfeed_notify_cb(NOTIFY_ALL, NULL);
+}
+
+void spotfeed_get_stats(SPOTFEED_STATS *s) {
+  g_mutex_lock(&spotfeed_mutex);
+  *s = stats;
+  g_mutex_unlock(&spotfeed_mutex);
+}
+
+void spotfeed_reset_stats(void) {
+  g_mutex_lock(&spotfeed_mutex);
+  memset(&stats, 0, sizeof(stats));
+  g_mutex_unlock(&spotfeed_mutex);
+}
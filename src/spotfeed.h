@@ -0,0 +1,43 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef _SPOTFEED_H
+#define _SPOTFEED_H
+
+#include "dxspot.h"
+
+//
+// Interval (ms) at which batched spots are handed to the panadapter
+//
+#define SPOTFEED_FLUSH_MS 250
+
+typedef struct {
+  unsigned long received;     // spots parsed from RBN/cluster
+  unsigned long filtered;     // dropped because not on a visible band
+  unsigned long duplicates;   // dropped as duplicates
+  unsigned long overflow;     // dropped because the pending batch was full
+  unsigned long displayed;    // handed to the spot store
+} SPOTFEED_STATS;
+
+extern void spotfeed_init(void);
+extern void spotfeed_push(double freq_khz, const char *call, PAN_SPOT_SOURCE source);
+extern void spotfeed_get_stats(SPOTFEED_STATS *stats);
+extern void spotfeed_reset_stats(void);
+extern void spotfeed_flush_now(void);
+
+#endif
@@ -50,6 +50,7 @@
 #include "main.h"
 #include "discovery.h"
 #include "tci_audio.h"
+#include "tci_lookup.h"
 #include "cw_engine.h"
 #include "rtty_engine.h"
 #include "audio.h"
@@ -62,6 +63,7 @@
 #include "receiver.h"
 #include "rx_panadapter.h"
 #include "tx_off.h"
+#include "notify_bus.h"
 
 #define MAXDATASIZE     1024
 #define MAXMSGSIZE      512
@@ -92,6 +94,8 @@ enum OpCode {
 
 static GThread *tci_server_thread_id = NULL;
 static int tci_running = 0;
+static int tci_notify_handle = 0;
+static void tci_notify_cb(unsigned int changes, gpointer data);
 static struct lws_context *tci_lws_context = NULL;
 static int tci_lws_seq = 0;
 static int tci_lws_pending_writable = 0;
@@ -322,8 +326,22 @@ typedef struct {
   TCI_HANDLER handler;
 } TCI_DISPATCH;
 
+//
+// Per-command dispatch counters. tci_handle_text() only runs on the LWS
+// service thread, so these are not locked.
+//
+typedef struct {
+  unsigned long calls;
+  gint64 total_us;
+  gint64 max_us;
+} TCI_DISPATCH_STATS;
+
 static void tci_handle_text(CLIENT *client, char *msg);
+static void tci_dispatch_init(void);
+static void tci_dispatch_stats_dump(void);
 static const TCI_DISPATCH tci_dispatch[];
+static TCI_DISPATCH_STATS *tci_dispatch_stats = NULL;
+static GHashTable *tci_dispatch_index = NULL;   // command name -> TCI_DISPATCH
 
 static void tci_send_smeter(CLIENT *client, int v);
 static void tci_send_rx_filter_band(CLIENT *client, int v);
@@ -360,8 +378,6 @@ int tci_is_tune_transition(void) {
   return tci_tune_transition;
 }
 
-
-
 //
 // Launch TCI system. Called upon program start if TCI is
 // enabled in the props file, and from the CAT/TCI menu
@@ -369,12 +385,17 @@ int tci_is_tune_transition(void) {
 //
 void launch_tci(void) {
   t_print("---- LAUNCHING TCI LWS SERVER ----\n");
+  tci_dispatch_init();
   tci_audio_set_wakeup_callback(tci_audio_wakeup);
   tci_audio_set_tx_chrono_callback(tci_audio_tx_chrono_wakeup);
   cw_engine_set_start_delay(tci_cw_macros_delay_ms);
   cw_engine_set_empty_callback(tci_cw_macros_empty);
   rtty_engine_set_buffer_empty_callback(tci_rtty_buffer_empty);
   tci_running = 1;
+  if (tci_notify_handle == 0) {
+    tci_notify_handle = notify_subscribe(NOTIFY_VFO_A_FREQ | NOTIFY_VFO_B_FREQ | NOTIFY_VFO_A_MODE | NOTIFY_VFO_B_MODE |
+                                         NOTIFY_TX_FREQ | NOTIFY_VFOS, NOTIFY_ORIGIN_TCI, tci_notify_cb, NULL);
+  }
   tci_server_thread_id = g_thread_new("tci lws server", tci_lws_server, GINT_TO_POINTER(tci_port));
 }
 
@@ -463,6 +484,8 @@ void shutdown_tci(void) {
     }
   }
   tci_running = 0;
+  notify_unsubscribe(tci_notify_handle);
+  tci_notify_handle = 0;
   if (tci_lws_context != NULL) {
     lws_cancel_service(tci_lws_context);
   }
@@ -472,6 +495,9 @@ void shutdown_tci(void) {
     }
     tci_server_thread_id = NULL;
   }
+  if (rigctl_debug) {
+    tci_dispatch_stats_dump();
+  }
 }
 
 static int tci_queue_frame(CLIENT *client, int type, const char *msg, int check_running) {
@@ -2789,14 +2815,16 @@ static int tci_parse_agc_mode(const char *mode) {
   if (mode == NULL) {
     return AGC_MEDIUM;
   }
-  if (!g_ascii_strcasecmp(mode, "off")) {
-    return AGC_OFF;
-  }
-  if (!g_ascii_strcasecmp(mode, "fast")) {
-    return AGC_FAST;
-  }
-  if (!g_ascii_strcasecmp(mode, "normal")) {
-    return AGC_MEDIUM;
+  switch (g_ascii_tolower(mode[0])) {
+  case 'o':
+    if (!g_ascii_strcasecmp(mode, "off")) { return AGC_OFF; }
+    break;
+  case 'f':
+    if (!g_ascii_strcasecmp(mode, "fast")) { return AGC_FAST; }
+    break;
+  case 'n':
+    if (!g_ascii_strcasecmp(mode, "normal")) { return AGC_MEDIUM; }
+    break;
   }
   return -1;
 }
@@ -3013,6 +3041,25 @@ void tci_tx_frequency_changed(void) {
   tci_broadcast_txfreq();
 }
 
+//
+// VFO frequency/mode changes reach TCI via the notification bus, such that
+// fast tuning results in one broadcast per main loop iteration. Changes
+// applied by a TCI client are posted with NOTIFY_ORIGIN_TCI and are not
+// echoed.
+//
+static void tci_notify_cb(unsigned int changes, gpointer data) {
+  if (!tci_running) { return; }
+  if (changes & NOTIFY_VFOS) {
+    tci_vfos_changed();
+    return;
+  }
+  if (changes & NOTIFY_VFO_A_FREQ) { tci_vfo_changed(VFO_A); }
+  if (changes & NOTIFY_VFO_B_FREQ) { tci_vfo_changed(VFO_B); }
+  if (changes & NOTIFY_VFO_A_MODE) { tci_mode_changed(VFO_A); }
+  if (changes & NOTIFY_VFO_B_MODE) { tci_mode_changed(VFO_B); }
+  if (changes & NOTIFY_TX_FREQ) { tci_tx_frequency_changed(); }
+}
+
 void tci_drive_changed(void) {
   if (!tci_running) { return; }
   tci_broadcast_drive();
@@ -3026,25 +3073,6 @@ void tci_tune_drive_changed(void) {
   tci_broadcast_tune_drive();
 }
 
-static int tci_parse_mode(const char *mode_str) {
-  if (mode_str == NULL) { return -1; }
-  if (!g_ascii_strcasecmp(mode_str, "lsb"))  { return modeLSB; }
-  if (!g_ascii_strcasecmp(mode_str, "usb"))  { return modeUSB; }
-  if (!g_ascii_strcasecmp(mode_str, "dsb"))  { return modeDSB; }
-  if (!g_ascii_strcasecmp(mode_str, "cw"))   { return modeCWU; }
-  if (!g_ascii_strcasecmp(mode_str, "cwl"))  { return modeCWL; }
-  if (!g_ascii_strcasecmp(mode_str, "cwu"))  { return modeCWU; }
-  if (!g_ascii_strcasecmp(mode_str, "fmn"))  { return modeFMN; }
-  if (!g_ascii_strcasecmp(mode_str, "fm"))   { return modeFMN; }
-  if (!g_ascii_strcasecmp(mode_str, "am"))   { return modeAM; }
-  if (!g_ascii_strcasecmp(mode_str, "digu")) { return modeDIGU; }
-  if (!g_ascii_strcasecmp(mode_str, "spec")) { return modeSPEC; }
-  if (!g_ascii_strcasecmp(mode_str, "digl")) { return modeDIGL; }
-  if (!g_ascii_strcasecmp(mode_str, "sam"))  { return modeSAM; }
-  if (!g_ascii_strcasecmp(mode_str, "drm"))  { return modeDRM; }
-  return -1;
-}
-
 typedef struct {
   int vfo_id;
   int mode;
@@ -3063,7 +3091,7 @@ static int tci_mode_change_cb(void *data) {
 static void tci_set_mode(CLIENT *client, int VfoNr, const char *mode_str) {
   if (VfoNr < 0 || VfoNr > 1) { return; }
   if (VfoNr >= receivers || receiver[VfoNr] == NULL) { return; }
-  int m = tci_parse_mode(mode_str);
+  int m = tci_lookup_mode(mode_str);
   if (m < 0) {
     t_print("TCI%d unknown mode: %s\n", client->seq, mode_str);
     tci_send_mode(client, VfoNr);
@@ -5430,6 +5458,38 @@ static const TCI_DISPATCH tci_dispatch[] = {
   { NULL,                0,  0, NULL }
 };
 
+//
+// Build the lookup table for the command dispatch.
+// Called once from launch_tci().
+//
+static void tci_dispatch_init(void) {
+  int n = 0;
+  if (tci_dispatch_index != NULL) {
+    return;
+  }
+  tci_dispatch_index = tci_lookup_index_new(tci_dispatch, sizeof(TCI_DISPATCH));
+  while (tci_dispatch[n].name != NULL) {
+    n++;
+  }
+  tci_dispatch_stats = g_new0(TCI_DISPATCH_STATS, n);
+}
+
+//
+// Print the per-command counters (calls, average and max. handler time)
+//
+static void tci_dispatch_stats_dump(void) {
+  if (tci_dispatch_stats == NULL) {
+    return;
+  }
+  t_print("TCI command statistics:\n");
+  for (int i = 0; tci_dispatch[i].name != NULL; i++) {
+    const TCI_DISPATCH_STATS *st = &tci_dispatch_stats[i];
+    if (st->calls == 0) { continue; }
+    t_print("  %-22s calls=%lu avg=%.1f us max=%lld us\n", tci_dispatch[i].name, st->calls,
+            (double) st->total_us / (double) st->calls, (long long) st->max_us);
+  }
+}
+
 static void tci_handle_text(CLIENT *client, char *msg) {
   TCI_CMD cmd;
   if (tci_parse_text(msg, &cmd) < 0 || cmd.cmd == NULL) { return; }
@@ -5455,26 +5515,28 @@ static void tci_handle_text(CLIENT *client, char *msg) {
     }
     return;
   }
-  bool handled = false;
-  for (int i = 0; tci_dispatch[i].name != NULL; i++) {
-    const TCI_DISPATCH *d = &tci_dispatch[i];
-    if (cmd.cmd[0] != d->name[0] || strcmp(cmd.cmd, d->name) != 0) { continue; }
-    handled = true;
-    if (cmd.argc < d->min_args) {
-      t_print("TCI%d %s: too few args (%d < %d)\n", client->seq, d->name, cmd.argc, d->min_args);
-      return;
-    }
-    if (d->max_args >= 0 && cmd.argc > d->max_args) {
-      t_print("TCI%d %s: too many args (%d > %d)\n", client->seq, d->name, cmd.argc, d->max_args);
-      return;
+  const TCI_DISPATCH *d = tci_dispatch_index ? g_hash_table_lookup(tci_dispatch_index, cmd.cmd) : NULL;
+  if (d == NULL) {
+    if (rigctl_debug) {
+      t_print("TCI%d unknown command: %s\n", client->seq, cmd.cmd);
     }
-    d->handler(client, &cmd);
     return;
   }
-  if (!handled && rigctl_debug) {
-    t_print("TCI%d unknown command: %s\n",
-            client->seq, cmd.cmd ? cmd.cmd : "(null)");
+  if (cmd.argc < d->min_args) {
+    t_print("TCI%d %s: too few args (%d < %d)\n", client->seq, d->name, cmd.argc, d->min_args);
+    return;
+  }
+  if (d->max_args >= 0 && cmd.argc > d->max_args) {
+    t_print("TCI%d %s: too many args (%d > %d)\n", client->seq, d->name, cmd.argc, d->max_args);
+    return;
   }
+  gint64 t0 = g_get_monotonic_time();
+  d->handler(client, &cmd);
+  gint64 dt = g_get_monotonic_time() - t0;
+  TCI_DISPATCH_STATS *st = &tci_dispatch_stats[d - tci_dispatch];
+  st->calls++;
+  st->total_us += dt;
+  if (dt > st->max_us) { st->max_us = dt; }
 }
 
 static void tci_send_smeter(CLIENT *client, int v) {
@@ -0,0 +1,79 @@
+/*  Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+//
+// Hashed name lookup for the TCI server. This is kept apart from tci.c
+// such that tests/tci_lookup_test.c can check it against the former
+// linear searches.
+//
+
+#include <glib.h>
+
+#include "mode.h"
+#include "tci_lookup.h"
+
+GHashTable *tci_lookup_index_new(const void *table, size_t entry_size) {
+  GHashTable *index = g_hash_table_new(g_str_hash, g_str_equal);
+  for (const char *p = table; *(const char * const *) p != NULL; p += entry_size) {
+    const char *name = *(const char * const *) p;
+    // first entry wins, as with a linear search
+    if (!g_hash_table_contains(index, name)) {
+      g_hash_table_insert(index, (gpointer) name, (gpointer) p);
+    }
+  }
+  return index;
+}
+
+int tci_lookup_mode(const char *name) {
+  static const struct {
+    const char *name;
+    int mode;
+  } modes[] = {
+    { "lsb",  modeLSB },
+    { "usb",  modeUSB },
+    { "dsb",  modeDSB },
+    { "cw",   modeCWU },
+    { "cwl",  modeCWL },
+    { "cwu",  modeCWU },
+    { "fmn",  modeFMN },
+    { "fm",   modeFMN },
+    { "am",   modeAM },
+    { "digu", modeDIGU },
+    { "spec", modeSPEC },
+    { "digl", modeDIGL },
+    { "sam",  modeSAM },
+    { "drm",  modeDRM },
+  };
+  static GHashTable *mode_index = NULL;   // lower case mode name -> mode + 1
+  char key[8];
+  size_t i;
+  if (g_once_init_enter(&mode_index)) {
+    GHashTable *h = g_hash_table_new(g_str_hash, g_str_equal);
+    for (i = 0; i < G_N_ELEMENTS(modes); i++) {
+      g_hash_table_insert(h, (gpointer) modes[i].name, GINT_TO_POINTER(modes[i].mode + 1));
+    }
+    g_once_init_leave(&mode_index, h);
+  }
+  if (name == NULL) { return -1; }
+  for (i = 0; name[i] != 0; i++) {
+    if (i >= sizeof(key) - 1) { return -1; }
+    key[i] = g_ascii_tolower(name[i]);
+  }
+  key[i] = 0;
+  return GPOINTER_TO_INT(g_hash_table_lookup(mode_index, key)) - 1;
+}
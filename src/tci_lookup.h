@@ -0,0 +1,41 @@
+/*  Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+//
+// Name lookup for the TCI server: command dispatch and mode names
+//
+
+#ifndef _TCI_LOOKUP_H
+#define _TCI_LOOKUP_H
+
+#include <glib.h>
+#include <stddef.h>
+
+//
+// Index a table whose entries start with a "const char *name" member and
+// which is terminated by an entry with name == NULL. The returned hash maps
+// each name to its (first) entry.
+//
+extern GHashTable *tci_lookup_index_new(const void *table, size_t entry_size);
+
+//
+// TCI mode name (case-insensitive) to mode, -1 if unknown
+//
+extern int tci_lookup_mode(const char *name);
+
+#endif
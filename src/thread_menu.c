@@ -0,0 +1,211 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#include <gtk/gtk.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "css.h"
+#include "main.h"
+#include "new_menu.h"
+#include "thread_menu.h"
+#include "thread_role.h"
+
+static GtkWidget *dialog = NULL;
+static GtkWidget *cpus_entry[THREAD_ROLE_COUNT];
+static GtkWidget *priority_b[THREAD_ROLE_COUNT];
+static GtkWidget *threads_label = NULL;
+
+static void thread_menu_update_list(void) {
+  THREAD_ROLE_INFO info[THREAD_ROLE_MAX_THREADS];
+  GString *text = g_string_new(NULL);
+  int n = thread_role_list(info, THREAD_ROLE_MAX_THREADS);
+  if (n == 0) {
+    g_string_append(text, "No radio threads running.");
+  }
+  for (int i = 0; i < n; i++) {
+    const char *pin = info[i].affinity_ok < 0 ? "-" : info[i].affinity_ok ? "ok" : "failed";
+    const char *sched = info[i].sched_ok < 0 ? "normal" : info[i].sched_ok ? "real-time" : "normal (no privilege)";
+    g_string_append_printf(text, "%s%-14s %-9s tid %-7d pinning %-6s %s", i > 0 ? "\n" : "",
+                           info[i].name, thread_role_name(info[i].role), info[i].tid, pin, sched);
+  }
+  char *escaped = g_markup_escape_text(text->str, -1);
+  char *markup = g_strdup_printf("<tt>%s</tt>", escaped);
+  gtk_label_set_markup(GTK_LABEL(threads_label), markup);
+  g_free(markup);
+  g_free(escaped);
+  g_string_free(text, TRUE);
+}
+
+static void thread_menu_apply(THREAD_ROLE role) {
+  thread_role_apply(role);
+  StartConfigSave();
+  thread_menu_update_list();
+}
+
+static void cpus_changed_cb(GtkWidget *widget, gpointer data) {
+  THREAD_ROLE role = GPOINTER_TO_INT(data);
+  const char *cpus = gtk_entry_get_text(GTK_ENTRY(widget));
+  if (!thread_role_check_cpus(cpus)) {
+    // invalid CPU list: restore the current setting
+    gtk_entry_set_text(GTK_ENTRY(widget), thread_role_config[role].cpus);
+    return;
+  }
+  if (strcmp(cpus, thread_role_config[role].cpus) == 0) {
+    return;
+  }
+  g_strlcpy(thread_role_config[role].cpus, cpus, sizeof(thread_role_config[role].cpus));
+  thread_menu_apply(role);
+}
+
+static gboolean cpus_focus_out_cb(GtkWidget *widget, GdkEvent *event, gpointer data) {
+  cpus_changed_cb(widget, data);
+  return FALSE;
+}
+
+static void policy_changed_cb(GtkWidget *widget, gpointer data) {
+  THREAD_ROLE role = GPOINTER_TO_INT(data);
+  thread_role_config[role].policy = gtk_combo_box_get_active(GTK_COMBO_BOX(widget));
+  gtk_widget_set_sensitive(priority_b[role], thread_role_config[role].policy != THREAD_SCHED_NORMAL);
+  thread_menu_apply(role);
+}
+
+static void priority_changed_cb(GtkWidget *widget, gpointer data) {
+  THREAD_ROLE role = GPOINTER_TO_INT(data);
+  thread_role_config[role].priority = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(widget));
+  if (thread_role_config[role].policy != THREAD_SCHED_NORMAL) {
+    thread_menu_apply(role);
+  }
+}
+
+static void refresh_cb(GtkButton *button, gpointer data) {
+  thread_menu_update_list();
+}
+
+static void cleanup(void) {
+  if (dialog != NULL) {
+    GtkWidget *tmp = dialog;
+    dialog = NULL;
+    gtk_widget_destroy(tmp);
+    sub_menu = NULL;
+    active_menu = NO_MENU;
+  }
+}
+
+static gboolean delete_event_cb(GtkWidget *widget, GdkEvent *event, gpointer data) {
+  cleanup();
+  return TRUE;
+}
+
+static void destroy_cb(GtkWidget *widget, gpointer data) {
+  dialog = NULL;
+  sub_menu = NULL;
+  active_menu = NO_MENU;
+}
+
+static void close_button_clicked_cb(GtkButton *button, gpointer data) {
+  cleanup();
+}
+
+void thread_menu(GtkWidget *parent) {
+  if (dialog != NULL) {
+    gtk_window_present(GTK_WINDOW(dialog));
+    return;
+  }
+  dialog = gtk_dialog_new();
+  gtk_window_set_transient_for(GTK_WINDOW(dialog), GTK_WINDOW(parent));
+  gtk_window_set_position(GTK_WINDOW(dialog), GTK_WIN_POS_CENTER_ON_PARENT);
+  gtk_window_set_resizable(GTK_WINDOW(dialog), FALSE);
+  GtkWidget *headerbar = gtk_header_bar_new();
+  gtk_window_set_titlebar(GTK_WINDOW(dialog), headerbar);
+  gtk_header_bar_set_show_close_button(GTK_HEADER_BAR(headerbar), TRUE);
+  char _title[64];
+  snprintf(_title, sizeof(_title), "%s - Thread Priorities", PGNAME);
+  gtk_header_bar_set_title(GTK_HEADER_BAR(headerbar), _title);
+  g_signal_connect(dialog, "delete-event", G_CALLBACK(delete_event_cb), NULL);
+  g_signal_connect(dialog, "destroy", G_CALLBACK(destroy_cb), NULL);
+  GtkWidget *content = gtk_dialog_get_content_area(GTK_DIALOG(dialog));
+  GtkWidget *grid = gtk_grid_new();
+  gtk_grid_set_column_spacing(GTK_GRID(grid), 10);
+  gtk_grid_set_row_spacing(GTK_GRID(grid), 8);
+  gtk_container_set_border_width(GTK_CONTAINER(grid), 10);
+  int row = 0;
+  GtkWidget *close_b = gtk_button_new_with_label("Close");
+  gtk_widget_set_name(close_b, "close_button");
+  g_signal_connect(close_b, "clicked", G_CALLBACK(close_button_clicked_cb), NULL);
+  gtk_grid_attach(GTK_GRID(grid), close_b, 0, row, 1, 1);
+  row++;
+  GtkWidget *note = gtk_label_new("CPU pinning and scheduling of the time-critical threads.\n"
+                                  "CPUs: list such as \"2,3\" or \"2-3\", empty for no pinning (Linux only).\n"
+                                  "FIFO/RR need CAP_SYS_NICE or an rtprio limit, else normal scheduling is kept.");
+  gtk_label_set_line_wrap(GTK_LABEL(note), TRUE);
+  gtk_widget_set_halign(note, GTK_ALIGN_START);
+  gtk_grid_attach(GTK_GRID(grid), note, 0, row, 4, 1);
+  row++;
+  const char *headings[4] = { "Role", "CPUs", "Scheduling", "Priority" };
+  for (int i = 0; i < 4; i++) {
+    GtkWidget *label = gtk_label_new(headings[i]);
+    gtk_widget_set_name(label, "boldlabel");
+    gtk_widget_set_halign(label, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(grid), label, i, row, 1, 1);
+  }
+  row++;
+  for (int r = 0; r < THREAD_ROLE_COUNT; r++) {
+    THREAD_ROLE_CONFIG *c = &thread_role_config[r];
+    GtkWidget *label = gtk_label_new(thread_role_name(r));
+    gtk_widget_set_halign(label, GTK_ALIGN_START);
+    gtk_grid_attach(GTK_GRID(grid), label, 0, row, 1, 1);
+    cpus_entry[r] = gtk_entry_new();
+    gtk_entry_set_width_chars(GTK_ENTRY(cpus_entry[r]), 10);
+    gtk_entry_set_text(GTK_ENTRY(cpus_entry[r]), c->cpus);
+    gtk_grid_attach(GTK_GRID(grid), cpus_entry[r], 1, row, 1, 1);
+    g_signal_connect(cpus_entry[r], "activate", G_CALLBACK(cpus_changed_cb), GINT_TO_POINTER(r));
+    g_signal_connect(cpus_entry[r], "focus-out-event", G_CALLBACK(cpus_focus_out_cb), GINT_TO_POINTER(r));
+    GtkWidget *policy_combo = gtk_combo_box_text_new();
+    gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(policy_combo), NULL, "Normal");
+    gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(policy_combo), NULL, "SCHED_FIFO");
+    gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(policy_combo), NULL, "SCHED_RR");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(policy_combo), c->policy);
+    gtk_grid_attach(GTK_GRID(grid), policy_combo, 2, row, 1, 1);
+    priority_b[r] = gtk_spin_button_new_with_range(1.0, 99.0, 1.0);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(priority_b[r]), c->priority < 1 ? 50 : c->priority);
+    c->priority = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(priority_b[r]));
+    gtk_widget_set_sensitive(priority_b[r], c->policy != THREAD_SCHED_NORMAL);
+    gtk_grid_attach(GTK_GRID(grid), priority_b[r], 3, row, 1, 1);
+    g_signal_connect(policy_combo, "changed", G_CALLBACK(policy_changed_cb), GINT_TO_POINTER(r));
+    g_signal_connect(priority_b[r], "value-changed", G_CALLBACK(priority_changed_cb), GINT_TO_POINTER(r));
+    row++;
+  }
+  GtkWidget *title = gtk_label_new("Running threads");
+  gtk_widget_set_name(title, "boldlabel");
+  gtk_widget_set_halign(title, GTK_ALIGN_START);
+  gtk_grid_attach(GTK_GRID(grid), title, 0, row, 3, 1);
+  GtkWidget *refresh_b = gtk_button_new_with_label("Refresh");
+  g_signal_connect(refresh_b, "clicked", G_CALLBACK(refresh_cb), NULL);
+  gtk_grid_attach(GTK_GRID(grid), refresh_b, 3, row, 1, 1);
+  row++;
+  threads_label = gtk_label_new(NULL);
+  gtk_widget_set_name(threads_label, "small_txt");
+  gtk_label_set_selectable(GTK_LABEL(threads_label), TRUE);
+  gtk_widget_set_halign(threads_label, GTK_ALIGN_START);
+  gtk_grid_attach(GTK_GRID(grid), threads_label, 0, row, 4, 1);
+  thread_menu_update_list();
+  gtk_container_add(GTK_CONTAINER(content), grid);
+  sub_menu = dialog;
+  gtk_widget_show_all(dialog);
+}
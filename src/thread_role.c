@@ -0,0 +1,313 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Registry of the time-critical threads, with per-role CPU pinning and
+ * real-time scheduling.
+ *
+ * A thread calls thread_role_enter() once at its start. The entry is
+ * removed automatically when the thread terminates (GPrivate destructor),
+ * so threads that come and go (e.g. WDSP channel threads on TX/RX
+ * transitions) need no further bookkeeping.
+ *
+ * SCHED_FIFO/SCHED_RR need CAP_SYS_NICE or a suitable RLIMIT_RTPRIO
+ * (e.g. "@audio - rtprio 95" in /etc/security/limits.conf). Without the
+ * privilege the thread keeps normal scheduling; this is reported once per
+ * role and shown in the thread menu. CPU pinning is only available on
+ * Linux.
+ */
+
+#ifdef __linux__
+  #ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+  #endif
+  #include <sched.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+#include <errno.h>
+#include <glib.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <wdsp.h>
+
+#include "message.h"
+#include "property.h"
+#include "thread_role.h"
+
+typedef struct {
+  int in_use;
+  pthread_t thread;
+  THREAD_ROLE_INFO info;
+} THREAD_ROLE_ENTRY;
+
+THREAD_ROLE_CONFIG thread_role_config[THREAD_ROLE_COUNT];
+
+static const char *role_names[THREAD_ROLE_COUNT] = {
+  "Radio RX", "IQ", "Radio TX", "WDSP", "Audio"
+};
+
+static const char *role_keys[THREAD_ROLE_COUNT] = {
+  "radio_rx", "iq", "radio_tx", "dsp", "audio"
+};
+
+static GMutex registry_mutex;
+static THREAD_ROLE_ENTRY registry[THREAD_ROLE_MAX_THREADS];
+static int warned[THREAD_ROLE_COUNT];
+#ifdef __linux__
+static cpu_set_t process_cpus;        // CPU mask of the process, for unpinning
+static int process_cpus_valid = 0;
+#endif
+
+static void thread_role_exit(gpointer data);
+static GPrivate thread_role_key = G_PRIVATE_INIT(thread_role_exit);
+
+const char *thread_role_name(THREAD_ROLE role) {
+  if (role < 0 || role >= THREAD_ROLE_COUNT) {
+    return "?";
+  }
+  return role_names[role];
+}
+
+#ifdef __linux__
+//
+// Parse "0,2-3" into set. Returns the number of CPUs, or -1 on a syntax
+// error or a CPU that is not online.
+//
+static int thread_role_parse_cpus(const char *cpus, cpu_set_t *set) {
+  long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+  const char *p = cpus;
+  int n = 0;
+  CPU_ZERO(set);
+  while (*p) {
+    char *end;
+    long lo, hi;
+    while (*p == ' ' || *p == ',') { p++; }
+    if (*p == '\0') { break; }
+    lo = strtol(p, &end, 10);
+    if (end == p) { return -1; }
+    hi = lo;
+    p = end;
+    if (*p == '-') {
+      p++;
+      hi = strtol(p, &end, 10);
+      if (end == p) { return -1; }
+      p = end;
+    }
+    if (lo < 0 || hi < lo || hi >= ncpu || hi >= CPU_SETSIZE) { return -1; }
+    for (long c = lo; c <= hi; c++) {
+      if (!CPU_ISSET(c, set)) {
+        CPU_SET(c, set);
+        n++;
+      }
+    }
+  }
+  return n;
+}
+#endif
+
+//
+// Returns 1 if cpus is empty or a valid CPU list for this machine
+//
+int thread_role_check_cpus(const char *cpus) {
+  if (cpus == NULL || cpus[0] == '\0') {
+    return 1;
+  }
+#ifdef __linux__
+  cpu_set_t set;
+  return thread_role_parse_cpus(cpus, &set) > 0;
+#else
+  return 0;
+#endif
+}
+
+//
+// Apply the role configuration to one registry entry.
+// Must be called with registry_mutex held.
+//
+static void thread_role_apply_entry(THREAD_ROLE_ENTRY *e) {
+  const THREAD_ROLE_CONFIG *c = &thread_role_config[e->info.role];
+  struct sched_param param;
+  int policy, rc;
+  e->info.affinity_ok = -1;
+#ifdef __linux__
+  {
+    cpu_set_t set;
+    int n = c->cpus[0] ? thread_role_parse_cpus(c->cpus, &set) : 0;
+    if (n <= 0) {
+      //
+      // No (valid) pinning: allow all CPUs of the process again, in case
+      // the thread had been pinned before or has inherited the mask of a
+      // pinned creator
+      //
+      if (process_cpus_valid) {
+        (void) pthread_setaffinity_np(e->thread, sizeof(process_cpus), &process_cpus);
+      }
+    } else {
+      e->info.affinity_ok = pthread_setaffinity_np(e->thread, sizeof(set), &set) == 0;
+    }
+  }
+#endif
+  memset(&param, 0, sizeof(param));
+  switch (c->policy) {
+  case THREAD_SCHED_FIFO:
+    policy = SCHED_FIFO;
+    break;
+  case THREAD_SCHED_RR:
+    policy = SCHED_RR;
+    break;
+  default:
+    policy = SCHED_OTHER;
+    break;
+  }
+  if (policy != SCHED_OTHER) {
+    int lo = sched_get_priority_min(policy);
+    int hi = sched_get_priority_max(policy);
+    param.sched_priority = c->priority < lo ? lo : c->priority > hi ? hi : c->priority;
+  }
+  rc = pthread_setschedparam(e->thread, policy, &param);
+  e->info.sched_ok = policy == SCHED_OTHER ? -1 : rc == 0;
+  if ((rc != 0 || e->info.affinity_ok == 0) && !warned[e->info.role]) {
+    warned[e->info.role] = 1;
+    if (rc != 0) {
+      t_print("%s: %s: cannot set real-time scheduling (%s), keeping normal scheduling\n",
+              __func__, role_names[e->info.role], rc == EPERM ? "no privilege" : strerror(rc));
+    }
+    if (e->info.affinity_ok == 0) {
+      t_print("%s: %s: cannot pin to CPUs %s\n", __func__, role_names[e->info.role], c->cpus);
+    }
+  }
+}
+
+static void thread_role_exit(gpointer data) {
+  THREAD_ROLE_ENTRY *e = (THREAD_ROLE_ENTRY *) data;
+  g_mutex_lock(&registry_mutex);
+  e->in_use = 0;
+  g_mutex_unlock(&registry_mutex);
+}
+
+//
+// Register the calling thread and apply its role's configuration
+//
+void thread_role_enter(THREAD_ROLE role, const char *name) {
+  THREAD_ROLE_ENTRY *e = NULL;
+  if (role < 0 || role >= THREAD_ROLE_COUNT) {
+    return;
+  }
+  // time-critical thread: never block in t_print
+  log_thread_async();
+  g_mutex_lock(&registry_mutex);
+  for (int i = 0; i < THREAD_ROLE_MAX_THREADS; i++) {
+    if (!registry[i].in_use) {
+      e = &registry[i];
+      break;
+    }
+  }
+  if (e == NULL) {
+    g_mutex_unlock(&registry_mutex);
+    t_print("%s: registry full, %s not registered\n", __func__, name);
+    return;
+  }
+  e->in_use = 1;
+  e->thread = pthread_self();
+  g_strlcpy(e->info.name, name, sizeof(e->info.name));
+  e->info.role = role;
+#ifdef __linux__
+  e->info.tid = (int) syscall(SYS_gettid);
+#else
+  e->info.tid = 0;
+#endif
+  thread_role_apply_entry(e);
+  g_mutex_unlock(&registry_mutex);
+  g_private_replace(&thread_role_key, e);
+}
+
+//
+// Re-apply the configuration of a role to all its running threads,
+// after the configuration has been changed.
+//
+void thread_role_apply(THREAD_ROLE role) {
+  if (role < 0 || role >= THREAD_ROLE_COUNT) {
+    return;
+  }
+  g_mutex_lock(&registry_mutex);
+  warned[role] = 0;
+  for (int i = 0; i < THREAD_ROLE_MAX_THREADS; i++) {
+    if (registry[i].in_use && registry[i].info.role == role) {
+      thread_role_apply_entry(&registry[i]);
+    }
+  }
+  g_mutex_unlock(&registry_mutex);
+}
+
+static void thread_role_wdsp_cb(int channel) {
+  char name[32];
+  snprintf(name, sizeof(name), "WDSP ch%d", channel);
+  thread_role_enter(THREAD_ROLE_DSP, name);
+}
+
+//
+// Called once from main() on the GTK thread, before any thread is pinned
+//
+void thread_role_init(void) {
+#ifdef __linux__
+  process_cpus_valid = sched_getaffinity(0, sizeof(process_cpus), &process_cpus) == 0;
+#endif
+  SetChannelThreadCallback(thread_role_wdsp_cb);
+}
+
+int thread_role_list(THREAD_ROLE_INFO *info, int max) {
+  int n = 0;
+  g_mutex_lock(&registry_mutex);
+  for (int i = 0; i < THREAD_ROLE_MAX_THREADS && n < max; i++) {
+    if (registry[i].in_use) {
+      info[n++] = registry[i].info;
+    }
+  }
+  g_mutex_unlock(&registry_mutex);
+  return n;
+}
+
+void thread_role_save_state(void) {
+  for (int i = 0; i < THREAD_ROLE_COUNT; i++) {
+    SetPropS1("thread_%s_cpus", role_keys[i], thread_role_config[i].cpus);
+    SetPropI1("thread_%s_policy", role_keys[i], thread_role_config[i].policy);
+    SetPropI1("thread_%s_priority", role_keys[i], thread_role_config[i].priority);
+  }
+}
+
+void thread_role_restore_state(void) {
+  for (int i = 0; i < THREAD_ROLE_COUNT; i++) {
+    THREAD_ROLE_CONFIG *c = &thread_role_config[i];
+    GetPropS1("thread_%s_cpus", role_keys[i], c->cpus);
+    GetPropI1("thread_%s_policy", role_keys[i], c->policy);
+    GetPropI1("thread_%s_priority", role_keys[i], c->priority);
+    if (c->policy < THREAD_SCHED_NORMAL || c->policy > THREAD_SCHED_RR) {
+      c->policy = THREAD_SCHED_NORMAL;
+    }
+    if (c->priority < 1 || c->priority > 99) {
+      c->priority = 50;
+    }
+    if (!thread_role_check_cpus(c->cpus)) {
+      c->cpus[0] = '\0';
+    }
+  }
+}
@@ -0,0 +1,70 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef _THREAD_ROLE_H
+#define _THREAD_ROLE_H
+
+//
+// Time-critical threads register themselves with a role. CPU pinning and
+// scheduling policy are configured per role (thread menu, stored in
+// startup_config.props) and applied when a thread registers and whenever
+// the configuration of its role changes.
+//
+typedef enum {
+  THREAD_ROLE_RADIO_RX = 0,   // packets/DMA from the radio
+  THREAD_ROLE_IQ,             // IQ decoding and hand-over to WDSP
+  THREAD_ROLE_RADIO_TX,       // TX IQ, high-priority and mic streams
+  THREAD_ROLE_DSP,            // WDSP channel threads
+  THREAD_ROLE_AUDIO,          // audio to the radio, local mic capture
+  THREAD_ROLE_COUNT
+} THREAD_ROLE;
+
+enum {
+  THREAD_SCHED_NORMAL = 0,
+  THREAD_SCHED_FIFO,
+  THREAD_SCHED_RR
+};
+
+typedef struct {
+  char cpus[64];      // e.g. "2,3" or "2-3", empty: no pinning
+  int policy;         // THREAD_SCHED_*
+  int priority;       // 1...99, only used for FIFO and RR
+} THREAD_ROLE_CONFIG;
+
+#define THREAD_ROLE_MAX_THREADS 64
+
+typedef struct {
+  char name[32];
+  THREAD_ROLE role;
+  int tid;
+  int affinity_ok;    // -1: no pinning requested
+  int sched_ok;       // -1: normal scheduling requested
+} THREAD_ROLE_INFO;
+
+extern THREAD_ROLE_CONFIG thread_role_config[THREAD_ROLE_COUNT];
+
+extern void thread_role_init(void);
+extern const char *thread_role_name(THREAD_ROLE role);
+extern void thread_role_enter(THREAD_ROLE role, const char *name);
+extern void thread_role_apply(THREAD_ROLE role);
+extern int thread_role_list(THREAD_ROLE_INFO *info, int max);
+extern int thread_role_check_cpus(const char *cpus);
+extern void thread_role_save_state(void);
+extern void thread_role_restore_state(void);
+
+#endif
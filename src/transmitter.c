@@ -62,6 +62,7 @@
 #include "toolset.h"
 #include "voice_keyer.h"
 #include "rtty_engine.h"
+#include "notify_bus.h"
 
 #define min(x,y) (x<y?x:y)
 #define max(x,y) (x<y?y:x)
@@ -93,7 +94,14 @@ static const float fir_bandpass_300_2700[] = {
   -0.001942, -0.001149
 };
 #define FIR_TAPS (sizeof(fir_bandpass_300_2700) / sizeof(float))
-static float fir_state[FIR_TAPS] = {0.0f};
+#define FIR_BLOCK 256
+//
+// Doubled delay line: each sample is stored at fir_pos and fir_pos+FIR_TAPS,
+// so the FIR_TAPS most recent samples (newest first) are always contiguous
+// at &fir_hist[fir_pos] and no memmove is needed per sample.
+//
+static float fir_hist[2 * FIR_TAPS] = {0.0f};
+static size_t fir_pos = 0;
 static int mon_enabled = 0;
 
 double ctcss_frequencies[CTCSS_FREQUENCIES] = {
@@ -1458,14 +1466,39 @@ TRANSMITTER *tx_create_transmitter(int id, int pixels, int width, int height) {
   return tx;
 }
 
-float fir_apply(float input) {
-  memmove(&fir_state[1], &fir_state[0], (FIR_TAPS - 1) * sizeof(float));
-  fir_state[0] = input;
-  float acc = 0.0f;
-  for (size_t i = 0; i < FIR_TAPS; i++) {
-    acc += fir_state[i] * fir_bandpass_300_2700[i];
+//
+// Filter n samples from in to out (in == out is allowed).
+//
+static void fir_apply_block(const float *in, float *out, int n) {
+  for (int k = 0; k < n; k++) {
+    fir_pos = (fir_pos == 0) ? FIR_TAPS - 1 : fir_pos - 1;
+    fir_hist[fir_pos] = fir_hist[fir_pos + FIR_TAPS] = in[k];
+    const float *x = &fir_hist[fir_pos];
+    float acc = 0.0f;
+    for (size_t i = 0; i < FIR_TAPS; i++) {
+      acc += x[i] * fir_bandpass_300_2700[i];
+    }
+    out[k] = acc;
+  }
+}
+
+//
+// Local monitor of the TX mic signal: down-mix, band-pass and
+// hand to the audio device in blocks of FIR_BLOCK samples.
+//
+static void tx_monitor_block(const double *mic, int samples, float gain) {
+  float block[FIR_BLOCK];
+  for (int done = 0; done < samples; done += FIR_BLOCK) {
+    int n = min(FIR_BLOCK, samples - done);
+    const double *p = mic + 2 * done;
+    for (int i = 0; i < n; i++) {
+      block[i] = (float)(0.5 * gain * (p[2 * i] + p[2 * i + 1]));
+    }
+    fir_apply_block(block, block, n);
+    for (int i = 0; i < n; i++) {
+      audio_write(receiver[0], block[i], block[i]);  // Stereo out
+    }
   }
-  return acc;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1576,14 +1609,7 @@ static void tx_full_buffer(TRANSMITTER *tx) {
     if (mon_enabled && radio_is_transmitting() &&
         vfo_get_tx_mode() != modeCWU &&
         vfo_get_tx_mode() != modeCWL) {
-      float gain = 1.0f;  // Optional: -6 dB
-      for (int i = 0; i < tx->samples; i++) {
-        float left  = tx->mic_input_buffer[2 * i];
-        float right = tx->mic_input_buffer[2 * i + 1];
-        float mono  = 0.5f * (left + right);
-        float filtered = fir_apply(gain * mono);
-        audio_write(receiver[0], filtered, filtered);  // Stereo out
-      }
+      tx_monitor_block(tx->mic_input_buffer, tx->samples, 1.0f);  // gain optional: -6 dB
     }
     /*
     // test from Siphon of the WDSP
@@ -1975,6 +2001,121 @@ void tx_add_mic_sample(TRANSMITTER *tx, float mic_sample) {
   }
 }
 
+//
+// PureSignal feedback worker.
+//
+// The protocol threads only collect feedback samples. A completed block is
+// copied into one of PS_FEED_BLOCKS slots and handed to the "PS feedback"
+// thread which runs pscc() and the feedback spectrum, such that IQ ingestion
+// for all receivers never waits on the PS calibration.
+// If both slots are still occupied, the block is dropped and counted.
+//
+#define PS_FEED_BLOCKS 2
+
+typedef struct {
+  const TRANSMITTER *tx;
+  double *tx_iq;
+  double *rx_iq;
+  int size;
+  int alloc;
+  int cwmode;
+} PS_FEED_BLOCK;
+
+static GMutex ps_feed_mutex;
+static GCond ps_feed_cond;
+static GThread *ps_feed_thread_id = NULL;
+static PS_FEED_BLOCK ps_feed[PS_FEED_BLOCKS];
+static int ps_feed_wr = 0;                   // next slot to fill
+static int ps_feed_rd = 0;                   // next slot to process
+static int ps_feed_count = 0;                // slots filled or in process
+static unsigned long ps_feed_blocks = 0;     // the following under ps_feed_mutex
+static unsigned long ps_feed_dropped = 0;
+static gint64 ps_feed_time_sum_us = 0;
+static gint64 ps_feed_time_max_us = 0;
+
+static gpointer ps_feed_thread(gpointer data) {
+  for (;;) {
+    g_mutex_lock(&ps_feed_mutex);
+    while (ps_feed_count == 0) {
+      g_cond_wait(&ps_feed_cond, &ps_feed_mutex);
+    }
+    PS_FEED_BLOCK *b = &ps_feed[ps_feed_rd];
+    g_mutex_unlock(&ps_feed_mutex);
+    gint64 t0 = g_get_monotonic_time();
+    //
+    // Feedback that is still queued after going RX is discarded
+    //
+    if (radio_is_transmitting()) {
+      RECEIVER *rx_feedback = receiver[PS_RX_FEEDBACK];
+      if (!b->cwmode) {
+        pscc(b->tx->id, b->size, b->tx_iq, b->rx_iq);
+      }
+      if (b->tx->displaying && b->tx->feedback && rx_feedback != NULL) {
+        g_mutex_lock(&rx_feedback->display_mutex);
+        Spectrum0(1, rx_feedback->id, 0, 0, b->rx_iq);
+        g_mutex_unlock(&rx_feedback->display_mutex);
+      }
+    }
+    gint64 dt = g_get_monotonic_time() - t0;
+    g_mutex_lock(&ps_feed_mutex);
+    ps_feed_blocks++;
+    ps_feed_time_sum_us += dt;
+    if (dt > ps_feed_time_max_us) { ps_feed_time_max_us = dt; }
+    ps_feed_rd = (ps_feed_rd + 1) % PS_FEED_BLOCKS;
+    ps_feed_count--;
+    g_mutex_unlock(&ps_feed_mutex);
+  }
+  return NULL;
+}
+
+static void ps_feed_push(const TRANSMITTER *tx, const double *tx_iq, const double *rx_iq, int size, int cwmode) {
+  g_mutex_lock(&ps_feed_mutex);
+  if (ps_feed_thread_id == NULL) {
+    ps_feed_thread_id = g_thread_new("PS feedback", ps_feed_thread, NULL);
+  }
+  if (ps_feed_count >= PS_FEED_BLOCKS) {
+    ps_feed_dropped++;
+    g_mutex_unlock(&ps_feed_mutex);
+    return;
+  }
+  PS_FEED_BLOCK *b = &ps_feed[ps_feed_wr];
+  g_mutex_unlock(&ps_feed_mutex);
+  //
+  // This slot is neither read by the worker nor written by anybody else
+  // until it is counted, so the copy can be done without the lock.
+  //
+  if (b->alloc < size) {
+    g_free(b->tx_iq);
+    g_free(b->rx_iq);
+    b->tx_iq = g_new(double, 2 * size);
+    b->rx_iq = g_new(double, 2 * size);
+    b->alloc = size;
+  }
+  memcpy(b->tx_iq, tx_iq, (size_t) 2 * size * sizeof(double));
+  memcpy(b->rx_iq, rx_iq, (size_t) 2 * size * sizeof(double));
+  b->tx = tx;
+  b->size = size;
+  b->cwmode = cwmode;
+  g_mutex_lock(&ps_feed_mutex);
+  ps_feed_wr = (ps_feed_wr + 1) % PS_FEED_BLOCKS;
+  ps_feed_count++;
+  g_cond_signal(&ps_feed_cond);
+  g_mutex_unlock(&ps_feed_mutex);
+}
+
+void tx_ps_feedback_get_stats(PS_FEEDBACK_STATS *stats) {
+  g_mutex_lock(&ps_feed_mutex);
+  stats->blocks = ps_feed_blocks;
+  stats->dropped = ps_feed_dropped;
+  stats->avg_ms = ps_feed_blocks > 0 ? 0.001 * (double) ps_feed_time_sum_us / (double) ps_feed_blocks : 0.0;
+  stats->max_ms = 0.001 * (double) ps_feed_time_max_us;
+  ps_feed_blocks = 0;
+  ps_feed_dropped = 0;
+  ps_feed_time_sum_us = 0;
+  ps_feed_time_max_us = 0;
+  g_mutex_unlock(&ps_feed_mutex);
+}
+
 void tx_add_ps_iq_samples(const TRANSMITTER *tx, double i_sample_tx, double q_sample_tx, double i_sample_rx,
                           double q_sample_rx) {
   RECEIVER *tx_feedback = receiver[PS_TX_FEEDBACK];
@@ -1994,18 +2135,13 @@ void tx_add_ps_iq_samples(const TRANSMITTER *tx, double i_sample_tx, double q_sa
   if (rx_feedback->samples >= rx_feedback->buffer_size) {
     if (radio_is_transmitting()) {
       int txmode = vfo_get_tx_mode();
+      //
+      // Since we are not using WDSP in CW transmit, it also makes little sense to
+      // deliver feedback samples
+      //
       int cwmode = (txmode == modeCWL || txmode == modeCWU) && !tune && !tx->twotone && !tx->noise;
-      if (!cwmode) {
-        //
-        // Since we are not using WDSP in CW transmit, it also makes little sense to
-        // deliver feedback samples
-        //
-        pscc(tx->id, rx_feedback->buffer_size, tx_feedback->iq_input_buffer, rx_feedback->iq_input_buffer);
-      }
-      if (tx->displaying && tx->feedback) {
-        g_mutex_lock(&rx_feedback->display_mutex);
-        Spectrum0(1, rx_feedback->id, 0, 0, rx_feedback->iq_input_buffer);
-        g_mutex_unlock(&rx_feedback->display_mutex);
+      if (!cwmode || (tx->displaying && tx->feedback)) {
+        ps_feed_push(tx, tx_feedback->iq_input_buffer, rx_feedback->iq_input_buffer, rx_feedback->buffer_size, cwmode);
       }
     }
     rx_feedback->samples = 0;
@@ -2480,6 +2616,7 @@ void tx_ps_onoff(TRANSMITTER *tx, int state) {
     tx_ps_setparams(tx);
   }
   g_idle_add(ext_vfo_update, NULL);
+  notify_post(NOTIFY_PS);
 }
 
 void tx_ps_reset(const TRANSMITTER *tx) {
@@ -25,6 +25,14 @@
 #include <gtk/gtk.h>
 
 #define CTCSS_FREQUENCIES 38
+
+typedef struct {
+  unsigned long blocks;     // feedback blocks processed by the PS worker
+  unsigned long dropped;    // feedback blocks dropped because the worker was busy
+  double avg_ms;            // avg. time for pscc() and feedback spectrum
+  double max_ms;
+} PS_FEEDBACK_STATS;
+
 extern double ctcss_frequencies[CTCSS_FREQUENCIES];
 
 typedef struct _transmitter {
@@ -246,6 +254,7 @@ extern void   tx_on(const TRANSMITTER *tx);
 extern void   tx_xmit_captured_data_start(const TRANSMITTER *tx);
 extern void   tx_xmit_captured_data_end(const TRANSMITTER *tx);
 
+extern void   tx_ps_feedback_get_stats(PS_FEEDBACK_STATS *stats);
 extern void   tx_ps_getinfo(const TRANSMITTER *tx, int *info);
 extern double tx_ps_getmx(const TRANSMITTER *tx);
 extern double tx_ps_getpk(const TRANSMITTER *tx);
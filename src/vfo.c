@@ -64,6 +64,7 @@ extern int tci_is_applying(void);
 #include "audio.h"
 #include "zoompan.h"
 #include "wdsp.h"
+#include "notify_bus.h"
 
 void vfo_apply_ps_tx_att(void) {
   if (!can_transmit || transmitter == NULL) { return; }
@@ -838,6 +839,8 @@ void vfo_xvtr_changed(void) {
       vfo_adjust_band(1, vfo[1].frequency);
       if (receivers == 2) {
         rx_set_frequency(receiver[1], vfo[1].frequency);
+      } else {
+        notify_post(NOTIFY_VFO_FREQ(1) | NOTIFY_TX_FREQ);
       }
     }
   }
@@ -1131,10 +1134,7 @@ void vfo_id_mode_changed(int id, int m) {
   schedule_high_priority();       // update frequencies
   schedule_transmit_specific();   // update "CW" flag
   g_idle_add(ext_vfo_update, NULL);
-  if (!tci_is_applying()) {
-    tci_mode_changed(id);
-    tci_tx_frequency_changed();
-  }
+  notify_post_from(NOTIFY_VFO_MODE(id) | NOTIFY_TX_FREQ, tci_is_applying() ? NOTIFY_ORIGIN_TCI : NOTIFY_ORIGIN_NONE);
 }
 
 void vfo_deviation_changed(int dev) {
@@ -1197,9 +1197,7 @@ void vfo_vfos_changed(void) {
   //
   schedule_transmit_specific();
   g_idle_add(ext_vfo_update, NULL);
-  if (!tci_is_applying()) {
-    tci_vfos_changed();
-  }
+  notify_post_from(NOTIFY_VFOS, tci_is_applying() ? NOTIFY_ORIGIN_TCI : NOTIFY_ORIGIN_NONE);
 }
 
 void vfo_a_to_b(void) {
@@ -1354,13 +1352,8 @@ void vfo_id_step(int id, int steps) {
       rx_frequency_changed(receiver[id]);
     }
     g_idle_add(ext_vfo_update, NULL);
-    if (!tci_is_applying()) {
-      tci_vfo_changed(id);
-      if (sat_mode != SAT_NONE) {
-        tci_vfo_changed(sid);
-      }
-      tci_tx_frequency_changed();
-    }
+    notify_post_from(NOTIFY_VFO_FREQ(id) | (sat_mode != SAT_NONE ? NOTIFY_VFO_FREQ(sid) : 0) | NOTIFY_TX_FREQ,
+                     tci_is_applying() ? NOTIFY_ORIGIN_TCI : NOTIFY_ORIGIN_NONE);
   }
 }
 
@@ -1380,10 +1373,10 @@ void vfo_id_set_rit_step(int id, int step) {
 }
 
 //
-// vfo_move (and vfo_id_move) are exclusively used
-// to update the radio while dragging with the
-// pointer device in the panadapter area. Therefore,
-// the behaviour is different whether we use CTUN or not.
+// vfo_move (and vfo_id_move) are used to update the
+// radio while dragging with the pointer device in the
+// panadapter area (and by the VFO tuner, see vfo_tuner.c).
+// Therefore, the behaviour is different whether we use CTUN or not.
 //
 // In "normal" (non-CTUN) mode, we "drag the spectrum". This
 // means, when dragging to the right the spectrum moves towards
@@ -1468,13 +1461,8 @@ void vfo_id_move(int id, long long hz, int round) {
       rx_frequency_changed(receiver[id]);
     }
     g_idle_add(ext_vfo_update, NULL);
-    if (!tci_is_applying()) {
-      tci_vfo_changed(id);
-      if (sat_mode != SAT_NONE) {
-        tci_vfo_changed(sid);
-      }
-      tci_tx_frequency_changed();
-    }
+    notify_post_from(NOTIFY_VFO_FREQ(id) | (sat_mode != SAT_NONE ? NOTIFY_VFO_FREQ(sid) : 0) | NOTIFY_TX_FREQ,
+                     tci_is_applying() ? NOTIFY_ORIGIN_TCI : NOTIFY_ORIGIN_NONE);
   }
 }
 
@@ -1562,13 +1550,8 @@ void vfo_id_move_to(int id, long long hz) {
       rx_vfo_changed(receiver[id]);
     }
     g_idle_add(ext_vfo_update, NULL);
-    if (!tci_is_applying()) {
-      tci_vfo_changed(id);
-      if (sat_mode != SAT_NONE) {
-        tci_vfo_changed(sid);
-      }
-      tci_tx_frequency_changed();
-    }
+    notify_post_from(NOTIFY_VFO_FREQ(id) | (sat_mode != SAT_NONE ? NOTIFY_VFO_FREQ(sid) : 0) | NOTIFY_TX_FREQ,
+                     tci_is_applying() ? NOTIFY_ORIGIN_TCI : NOTIFY_ORIGIN_NONE);
   }
 }
 
@@ -2532,6 +2515,7 @@ void vfo_xit_toggle(void) {
   TOGGLE(vfo[id].xit_enabled);
   schedule_high_priority();
   g_idle_add(ext_vfo_update, NULL);
+  notify_post(NOTIFY_RIT_XIT);
   if (!tci_is_applying()) {
     tci_xit_enable_changed();
   }
@@ -2543,6 +2527,7 @@ void vfo_rit_toggle(int id) {
     rx_frequency_changed(receiver[id]);
   }
   g_idle_add(ext_vfo_update, NULL);
+  notify_post(NOTIFY_RIT_XIT);
   if (!tci_is_applying()) {
     tci_rit_enable_changed(id);
   }
@@ -2567,6 +2552,7 @@ void vfo_rit_onoff(int id, int enable) {
     rx_frequency_changed(receiver[id]);
   }
   g_idle_add(ext_vfo_update, NULL);
+  notify_post(NOTIFY_RIT_XIT);
   if (!tci_is_applying() && old_enabled != vfo[id].rit_enabled) {
     tci_rit_enable_changed(id);
   }
@@ -2578,6 +2564,7 @@ void vfo_xit_onoff(int enable) {
   vfo[id].xit_enabled = SET(enable);
   schedule_high_priority();
   g_idle_add(ext_vfo_update, NULL);
+  notify_post(NOTIFY_RIT_XIT);
   if (!tci_is_applying() && old_enabled != vfo[id].xit_enabled) {
     tci_xit_enable_changed();
   }
@@ -2674,10 +2661,8 @@ void vfo_set_frequency(int v, long long f) {
     }
   }
   g_idle_add(ext_vfo_update, NULL);
-  if (!tci_is_applying()) {
-    tci_vfo_changed(v);
-    tci_tx_frequency_changed();
-  }
+  notify_post_from(NOTIFY_VFO_FREQ(v) | NOTIFY_TX_FREQ | NOTIFY_CTUN,
+                   tci_is_applying() ? NOTIFY_ORIGIN_TCI : NOTIFY_ORIGIN_NONE);
 }
 
 //
@@ -2708,4 +2693,5 @@ void vfo_ctun_update(int id, int state) {
       rx_set_frequency(receiver[id], vfo[id].ctun_frequency);
     }
   }
+  notify_post(NOTIFY_CTUN | NOTIFY_VFO_FREQ(id));
 }
@@ -0,0 +1,135 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Smooth VFO tuning for wheels and encoders.
+ *
+ * vfo_tuner_input() may be called from any thread (e.g. MIDI) for each
+ * wheel event. The ticks are accumulated, and the turning speed is tracked.
+ * A timer running at the panadapter frame rate of the active receiver
+ * applies the accumulated ticks once per frame with vfo_id_move(), such
+ * that fast tuning looks continuous but the radio and the GTK main loop
+ * see at most one frequency change per frame.
+ *
+ * Above VFO_TUNER_SLOW steps/sec, each tick moves the VFO by more than one
+ * step, up to VFO_TUNER_MAX_ACCEL steps at VFO_TUNER_FAST steps/sec.
+ * The timer stops itself VFO_TUNER_IDLE_MS after the last event.
+ */
+
+#include <gtk/gtk.h>
+#include <stdlib.h>
+
+#include "radio.h"
+#include "receiver.h"
+#include "vfo.h"
+#include "vfo_tuner.h"
+
+#define VFO_TUNER_SLOW       20.0
+#define VFO_TUNER_FAST      200.0
+#define VFO_TUNER_MAX_ACCEL   8.0
+#define VFO_TUNER_IDLE_MS     250
+
+typedef struct {
+  int pending;          // ticks not yet applied
+  double velocity;      // smoothed speed (ticks/sec)
+  gint64 last_input;    // time of the last event (usec)
+  double carry;         // fraction of a step not yet applied (GTK thread only)
+} VFO_TUNER;
+
+static GMutex tuner_mutex;
+static VFO_TUNER tuner[3];
+static guint tuner_timer = 0;
+
+static double vfo_tuner_accel(double speed) {
+  if (speed <= VFO_TUNER_SLOW) {
+    return 1.0;
+  }
+  if (speed >= VFO_TUNER_FAST) {
+    return VFO_TUNER_MAX_ACCEL;
+  }
+  return 1.0 + (VFO_TUNER_MAX_ACCEL - 1.0) * (speed - VFO_TUNER_SLOW) / (VFO_TUNER_FAST - VFO_TUNER_SLOW);
+}
+
+static gboolean vfo_tuner_frame(gpointer data) {
+  int ticks[3];
+  double accel[3];
+  int busy = 0;
+  int divisor = vfo_encoder_divisor > 0 ? vfo_encoder_divisor : 1;
+  gint64 now = g_get_monotonic_time();
+  g_mutex_lock(&tuner_mutex);
+  for (int i = 0; i < 3; i++) {
+    VFO_TUNER *t = &tuner[i];
+    ticks[i] = t->pending;
+    t->pending = 0;
+    accel[i] = vfo_tuner_accel(t->velocity / divisor);
+    if (now - t->last_input < 1000LL * VFO_TUNER_IDLE_MS) {
+      busy = 1;
+    } else {
+      t->velocity = 0.0;
+    }
+  }
+  if (!busy) {
+    tuner_timer = 0;
+  }
+  g_mutex_unlock(&tuner_mutex);
+  for (int i = 0; i < 3; i++) {
+    VFO_TUNER *t = &tuner[i];
+    if (ticks[i] == 0) {
+      if (!busy) { t->carry = 0.0; }
+      continue;
+    }
+    int id = (i == VFO_TUNER_ACTIVE) ? active_receiver->id : i;
+    double steps = t->carry + (double) ticks[i] * accel[i] / (double) divisor;
+    long long n = (long long) steps;
+    t->carry = steps - (double) n;
+    if (n != 0) {
+      //
+      // vfo_id_move() adds the shift to the CTUN frequency,
+      // but subtracts it from the VFO frequency
+      //
+      long long hz = n * vfo[id].step;
+      vfo_id_move(id, vfo[id].ctun ? hz : -hz, 1);
+    }
+  }
+  return busy ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+}
+
+void vfo_tuner_input(int which, int ticks) {
+  gint64 now = g_get_monotonic_time();
+  if (which < 0 || which > 2 || ticks == 0) {
+    return;
+  }
+  g_mutex_lock(&tuner_mutex);
+  VFO_TUNER *t = &tuner[which];
+  if (t->last_input > 0 && now - t->last_input < 1000LL * VFO_TUNER_IDLE_MS) {
+    double dt = 1.0E-6 * (double)(now - t->last_input);
+    if (dt < 0.001) { dt = 0.001; }
+    t->velocity = 0.7 * t->velocity + 0.3 * (double) abs(ticks) / dt;
+  } else {
+    t->velocity = 0.0;
+  }
+  t->pending += ticks;
+  t->last_input = now;
+  if (tuner_timer == 0) {
+    int fps = active_receiver != NULL ? active_receiver->fps : 25;
+    if (fps < 5) { fps = 5; }
+    if (fps > 100) { fps = 100; }
+    tuner_timer = g_timeout_add(1000 / fps, vfo_tuner_frame, NULL);
+  }
+  g_mutex_unlock(&tuner_mutex);
+}
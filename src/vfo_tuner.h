@@ -0,0 +1,31 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+#ifndef _VFO_TUNER_H
+#define _VFO_TUNER_H
+
+//
+// Which VFO a tuning wheel moves
+//
+#define VFO_TUNER_A      0
+#define VFO_TUNER_B      1
+#define VFO_TUNER_ACTIVE 2     // VFO of the active receiver
+
+extern void vfo_tuner_input(int which, int ticks);
+
+#endif
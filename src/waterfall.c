@@ -41,6 +41,7 @@
 #include "toolset.h"
 #include "waterfall.h"
 #include "rx_panadapter.h"
+#include "rx_render.h"
 #include "message.h"
 
 static int colorLowR = 0; // black
@@ -874,6 +875,114 @@ static gboolean waterfall_scroll_event_cb(GtkWidget *widget, GdkEventScroll *eve
   return rx_scroll_event(widget, event, data);
 }
 
+//
+// Collect everything a waterfall row depends on. Must be called from the
+// GTK thread.
+//
+gboolean waterfall_row_setup(RECEIVER *rx, WATERFALL_ROW *w) {
+  if (!rx || !rx->pixbuf) {
+    return FALSE;
+  }
+  int id = rx->id;
+  int b = vfo[id].band;
+  const BAND *band = band_get_band(b);
+  int calib = rx_gain_calibration - band->gain;
+  w->width = gdk_pixbuf_get_width(rx->pixbuf);
+  w->pan = rx->pan;
+  w->automatic = rx->waterfall_automatic;
+  w->low = rx->waterfall_low;
+  w->high = rx->waterfall_high;
+  //
+  // soffset contains all corrections due to attenuation, preamps, etc.
+  //
+  w->soffset = (float)(calib + adc[rx->adc].attenuation - adc[rx->adc].gain);
+  if (filter_board == ALEX && rx->adc == 0) {
+    w->soffset += (float)(10 * rx->alex_attenuation - 20 * rx->preamp);
+  }
+  if (filter_board == CHARLY25 && rx->adc == 0) {
+    w->soffset += (float)(12 * rx->alex_attenuation - 18 * rx->preamp - 18 * rx->dither);
+  }
+  return TRUE;
+}
+
+gboolean waterfall_row_equal(const WATERFALL_ROW *a, const WATERFALL_ROW *b) {
+  return a->width == b->width && a->pan == b->pan && a->automatic == b->automatic &&
+         a->low == b->low && a->high == b->high && a->soffset == b->soffset;
+}
+
+//
+// Colour-map one row of samples into p (RGB, w->width pixels) and return the
+// level range used. Only touches its arguments and may run on any thread.
+//
+void waterfall_row_render(const WATERFALL_ROW *w, const float *samples, unsigned char *p,
+                          float *low, float *high) {
+  float wf_low, wf_high, rangei;
+  if (w->automatic) {
+    float average = 0.0F;
+    for (int i = 0; i < w->width; i++) {
+      average += samples[i];
+    }
+    wf_low = (average / (float) w->width) + w->soffset - 5.0F;
+    wf_high = wf_low + 55.0F;
+  } else {
+    wf_low  = (float) w->low;
+    wf_high = (float) w->high;
+  }
+  rangei = 1.0F / (wf_high - wf_low);
+  for (int i = 0; i < w->width; i++) {
+    float sample = samples[i + w->pan] + w->soffset;
+    if (sample < wf_low) {
+      *p++ = colorLowR;
+      *p++ = colorLowG;
+      *p++ = colorLowB;
+    } else if (sample > wf_high) {
+      *p++ = colorHighR;
+      *p++ = colorHighG;
+      *p++ = colorHighB;
+    } else {
+      float percent = (sample - wf_low) * rangei;
+      if (percent < 0.222222f) {
+        float local_percent = percent * 4.5f;
+        *p++ = (int)((1.0f - local_percent) * colorLowR);
+        *p++ = (int)((1.0f - local_percent) * colorLowG);
+        *p++ = (int)(colorLowB + local_percent * (255 - colorLowB));
+      } else if (percent < 0.333333f) {
+        float local_percent = (percent - 0.222222f) * 9.0f;
+        *p++ = 0;
+        *p++ = (int)(local_percent * 255);
+        *p++ = 255;
+      } else if (percent < 0.444444f) {
+        float local_percent = (percent - 0.333333) * 9.0f;
+        *p++ = 0;
+        *p++ = 255;
+        *p++ = (int)((1.0f - local_percent) * 255);
+      } else if (percent < 0.555555f) {
+        float local_percent = (percent - 0.444444f) * 9.0f;
+        *p++ = (int)(local_percent * 255);
+        *p++ = 255;
+        *p++ = 0;
+      } else if (percent < 0.777777f) {
+        float local_percent = (percent - 0.555555f) * 4.5f;
+        *p++ = 255;
+        *p++ = (int)((1.0f - local_percent) * 255);
+        *p++ = 0;
+      } else if (percent < 0.888888f) {
+        float local_percent = (percent - 0.777777f) * 9.0f;
+        *p++ = 255;
+        *p++ = 0;
+        *p++ = (int)(local_percent * 255);
+      } else {
+        float local_percent = (percent - 0.888888f) * 9.0f;
+        *p++ = (int)((0.75f + 0.25f * (1.0f - local_percent)) * 255.0f);
+        *p++ = (int)(local_percent * 255.0f * 0.5f);
+        *p++ = 255;
+      }
+    }
+  }
+  *low = wf_low;
+  *high = wf_high;
+}
+
 void waterfall_update(RECEIVER *rx) {
   if (rx->pixbuf) {
     const float *samples;
@@ -992,36 +1101,12 @@ void waterfall_update(RECEIVER *rx) {
     // improvement.
     //
     if (!freq_changed) {
-      float soffset;
+      WATERFALL_ROW w;
+      float wf_low, wf_high;
       unsigned char *p;
       samples = rx->pixel_samples;
-      float wf_low, wf_high, rangei;
-      int id = rx->id;
-      int b = vfo[id].band;
-      const BAND *band = band_get_band(b);
-      int calib = rx_gain_calibration - band->gain;
-      //
-      // soffset contains all corrections due to attenuation, preamps, etc.
-      //
-      soffset = (float)(calib + adc[rx->adc].attenuation - adc[rx->adc].gain);
-      if (filter_board == ALEX && rx->adc == 0) {
-        soffset += (float)(10 * rx->alex_attenuation - 20 * rx->preamp);
-      }
-      if (filter_board == CHARLY25 && rx->adc == 0) {
-        soffset += (float)(12 * rx->alex_attenuation - 18 * rx->preamp - 18 * rx->dither);
-      }
-      if (rx->waterfall_automatic) {
-        float average = 0.0F;
-        for (int i = 0; i < width; i++) {
-          average += samples[i];
-        }
-        wf_low = (average / (float) width) + soffset - 5.0F;
-        wf_high = wf_low + 55.0F;
-      } else {
-        wf_low  = (float) rx->waterfall_low;
-        wf_high = (float) rx->waterfall_high;
-      }
-      rangei = 1.0F / (wf_high - wf_low);
+      waterfall_row_setup(rx, &w);
+      w.pan = pan;
       /* Keep the conventional waterfall in the lower part.  In 3D mode
        * the upper part is reserved for the backward-running spectrum
        * history; the normal panadapter is not touched. */
@@ -1031,60 +1116,17 @@ void waterfall_update(RECEIVER *rx) {
                 pixels + (size_t)terrain_height * rowstride,
                 (size_t)(waterfall_rows - 1) * rowstride);
       }
+      //
+      // Use the row prepared by the render worker if it matches,
+      // else colour-map it here
+      //
+      p = pixels + (size_t)terrain_height * rowstride;
+      if (!rx_render_take_row(rx, &w, p, &wf_low, &wf_high)) {
+        waterfall_row_render(&w, samples, p, &wf_low, &wf_high);
+      }
       if (terrain_height > 0) {
         waterfall_3d_render(rx, pixels, rowstride, width, terrain_height,
-                            samples, pan, soffset, wf_low, wf_high, vfofreq);
-      }
-      p = pixels + (size_t)terrain_height * rowstride;
-      for (int i = 0; i < width; i++) {
-        float sample = samples[i + pan] + soffset;
-        if (sample < wf_low) {
-          *p++ = colorLowR;
-          *p++ = colorLowG;
-          *p++ = colorLowB;
-        } else if (sample > wf_high) {
-          *p++ = colorHighR;
-          *p++ = colorHighG;
-          *p++ = colorHighB;
-        } else {
-          float percent = (sample - wf_low) * rangei;
-          if (percent < 0.222222f) {
-            float local_percent = percent * 4.5f;
-            *p++ = (int)((1.0f - local_percent) * colorLowR);
-            *p++ = (int)((1.0f - local_percent) * colorLowG);
-            *p++ = (int)(colorLowB + local_percent * (255 - colorLowB));
-          } else if (percent < 0.333333f) {
-            float local_percent = (percent - 0.222222f) * 9.0f;
-            *p++ = 0;
-            *p++ = (int)(local_percent * 255);
-            *p++ = 255;
-          } else if (percent < 0.444444f) {
-            float local_percent = (percent - 0.333333) * 9.0f;
-            *p++ = 0;
-            *p++ = 255;
-            *p++ = (int)((1.0f - local_percent) * 255);
-          } else if (percent < 0.555555f) {
-            float local_percent = (percent - 0.444444f) * 9.0f;
-            *p++ = (int)(local_percent * 255);
-            *p++ = 255;
-            *p++ = 0;
-          } else if (percent < 0.777777f) {
-            float local_percent = (percent - 0.555555f) * 4.5f;
-            *p++ = 255;
-            *p++ = (int)((1.0f - local_percent) * 255);
-            *p++ = 0;
-          } else if (percent < 0.888888f) {
-            float local_percent = (percent - 0.777777f) * 9.0f;
-            *p++ = 255;
-            *p++ = 0;
-            *p++ = (int)(local_percent * 255);
-          } else {
-            float local_percent = (percent - 0.888888f) * 9.0f;
-            *p++ = (int)((0.75f + 0.25f * (1.0f - local_percent)) * 255.0f);
-            *p++ = (int)(local_percent * 255.0f * 0.5f);
-            *p++ = 255;
-          }
-        }
+                            samples, pan, w.soffset, wf_low, wf_high, vfofreq);
       }
     }
     gtk_widget_queue_draw(rx->waterfall);
@@ -22,7 +22,23 @@
 #ifndef _WATERFALL_H
 #define _WATERFALL_H
 
+//
+// Parameters of one waterfall row, see waterfall_row_setup()
+//
+typedef struct {
+  int width;
+  int pan;
+  int automatic;
+  int low;
+  int high;
+  float soffset;
+} WATERFALL_ROW;
+
 extern void waterfall_update(RECEIVER *rx);
+extern gboolean waterfall_row_setup(RECEIVER *rx, WATERFALL_ROW *w);
+extern gboolean waterfall_row_equal(const WATERFALL_ROW *a, const WATERFALL_ROW *b);
+extern void waterfall_row_render(const WATERFALL_ROW *w, const float *samples, unsigned char *p,
+                                 float *low, float *high);
 extern void waterfall_3d_clear(RECEIVER *rx);
 extern void waterfall_init(RECEIVER *rx, int width, int height);
 
@@ -0,0 +1,176 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Compares the single precision WDSP fircore (WDSPFLOAT=ON) with the
+ * double precision one. Both cores filter the same noise-plus-tone input
+ * with the same bandpass impulse response, for several buffer sizes and
+ * numbers of partitions, and the maximum deviation is reported relative
+ * to the peak output. The program fails if it exceeds MAX_REL_ERROR.
+ *
+ * For each case, both cores are then timed on TIMING_BUFFERS buffers. The
+ * float time includes the double<->float conversion of the input and
+ * output buffer (fir_load/fir_store), which is also timed on its own, so
+ * the net gain of the float core is what is reported.
+ *
+ * The Makefile links this against the same FFTW libraries (fftw3 and
+ * fftw3f) as deskHPSDR, so both the error bound and the timing refer to
+ * the real FFTs.
+ *
+ * Build and run with "make fircore_test && ./fircore_test".
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "comm.h"
+
+#define MAX_REL_ERROR 1.0E-4    // -80 dB
+#define BUFFERS       64        // buffers filtered per test case
+#define TIMING_BUFFERS 2000     // buffers filtered per core for the timing
+
+//
+// The two variants of firmin.c, see fircore_variant.c
+//
+extern FIRCORE d_create_fircore(int size, double *in, double *out, int nc, int mp, int pfactor, double *impulse);
+extern void d_xfircore(FIRCORE a);
+extern void d_destroy_fircore(FIRCORE a);
+extern FIRCORE f_create_fircore(int size, double *in, double *out, int nc, int mp, int pfactor, double *impulse);
+extern void f_xfircore(FIRCORE a);
+extern void f_destroy_fircore(FIRCORE a);
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1.0E-9 * ts.tv_nsec;
+}
+
+//
+// Time per buffer (in usec) of the double and the float core, and of the
+// float core's input and output conversion alone
+//
+static void time_case(int size, int nc, int mp, double *t_d, double *t_f, double *t_conv) {
+  double *in = (double *) malloc0(size * sizeof(complex));
+  double *dout = (double *) malloc0(2 * size * sizeof(complex));
+  double *fout = (double *) malloc0(2 * size * sizeof(complex));
+  float *fbuf = (float *) malloc0(2 * size * sizeof(complex));
+  double *impulse = fir_bandpass(nc, -2400.0, 2400.0, 48000.0, 1, 1, 1.0 / (double)(2 * size));
+  FIRCORE d = d_create_fircore(size, in, dout, nc, mp, 16, impulse);
+  FIRCORE f = f_create_fircore(size, in, fout, nc, mp, 16, impulse);
+  for (int i = 0; i < 2 * size; i++) {
+    in[i] = 0.1 * (2.0 * rand() / RAND_MAX - 1.0);
+  }
+  double t0 = now();
+  for (int b = 0; b < TIMING_BUFFERS; b++) {
+    d_xfircore(d);
+  }
+  double t1 = now();
+  for (int b = 0; b < TIMING_BUFFERS; b++) {
+    f_xfircore(f);
+  }
+  double t2 = now();
+  //
+  // The loops of fir_load() and fir_store()
+  //
+  for (int b = 0; b < TIMING_BUFFERS; b++) {
+    for (int i = 0; i < 2 * size; i++) {
+      fbuf[i] = (float) in[i];
+    }
+    for (int i = 0; i < 2 * size; i++) {
+      fout[i] = (double) fbuf[i];
+    }
+  }
+  double t3 = now();
+  *t_d = 1.0E6 * (t1 - t0) / TIMING_BUFFERS;
+  *t_f = 1.0E6 * (t2 - t1) / TIMING_BUFFERS;
+  *t_conv = 1.0E6 * (t3 - t2) / TIMING_BUFFERS;
+  d_destroy_fircore(d);
+  f_destroy_fircore(f);
+  _aligned_free(impulse);
+  _aligned_free(fbuf);
+  _aligned_free(fout);
+  _aligned_free(dout);
+  _aligned_free(in);
+}
+
+static double run_case(int size, int nc, int mp) {
+  double *in = (double *) malloc0(size * sizeof(complex));
+  //
+  // The reverse FFT of the double core writes 2 * size samples to 'out'
+  //
+  double *dout = (double *) malloc0(2 * size * sizeof(complex));
+  double *fout = (double *) malloc0(2 * size * sizeof(complex));
+  double *impulse = fir_bandpass(nc, -2400.0, 2400.0, 48000.0, 1, 1, 1.0 / (double)(2 * size));
+  FIRCORE d = d_create_fircore(size, in, dout, nc, mp, 16, impulse);
+  FIRCORE f = f_create_fircore(size, in, fout, nc, mp, 16, impulse);
+  double peak = 0.0;
+  double err = 0.0;
+  double phase = 0.0;
+  for (int b = 0; b < BUFFERS; b++) {
+    for (int i = 0; i < size; i++) {
+      in[2 * i + 0] = 0.5 * cos(phase) + 0.1 * (2.0 * rand() / RAND_MAX - 1.0);
+      in[2 * i + 1] = 0.5 * sin(phase) + 0.1 * (2.0 * rand() / RAND_MAX - 1.0);
+      phase += 2.0 * M_PI * 1000.0 / 48000.0;
+    }
+    d_xfircore(d);
+    f_xfircore(f);
+    for (int i = 0; i < 2 * size; i++) {
+      double e = fabs(dout[i] - fout[i]);
+      if (fabs(dout[i]) > peak) { peak = fabs(dout[i]); }
+      if (e > err) { err = e; }
+    }
+  }
+  d_destroy_fircore(d);
+  f_destroy_fircore(f);
+  _aligned_free(impulse);
+  _aligned_free(fout);
+  _aligned_free(dout);
+  _aligned_free(in);
+  return peak > 0.0 ? err / peak : err;
+}
+
+int main(void) {
+  static const int cases[][3] = {
+    // size, nc, mp
+    {  64,   64, 0 },
+    { 256,  256, 0 },
+    { 256, 2048, 0 },
+    { 256, 2048, 1 },
+    {1024, 4096, 0 },
+    {2048, 2048, 1 },
+  };
+  int fail = 0;
+  srand(1);
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    double rel = run_case(cases[c][0], cases[c][1], cases[c][2]);
+    int bad = !(rel <= MAX_REL_ERROR);
+    printf("size=%5d nc=%5d mp=%d: max error %.3e (%.1f dB) %s\n", cases[c][0], cases[c][1], cases[c][2],
+           rel, 20.0 * log10(rel + 1.0E-300), bad ? "FAIL" : "ok");
+    fail |= bad;
+  }
+  printf("time per buffer (float includes conversion):\n");
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    double t_d, t_f, t_conv;
+    time_case(cases[c][0], cases[c][1], cases[c][2], &t_d, &t_f, &t_conv);
+    printf("size=%5d nc=%5d mp=%d: double %8.2f us, float %8.2f us (conversion %.2f us), speedup %.2f\n",
+           cases[c][0], cases[c][1], cases[c][2], t_d, t_f, t_conv, t_d / t_f);
+  }
+  return fail;
+}
@@ -0,0 +1,68 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Compiles the WDSP firmin.c once more, with all its global functions
+ * renamed, such that the double and the single precision (WDSP_FLOAT_FIR)
+ * fircore can be linked into one test program. This file is compiled
+ * twice by the Makefile, with and without -DWDSP_FLOAT_FIR.
+ *
+ * The renamed functions get the prefix d_ (double) or f_ (float).
+ */
+
+#ifdef WDSP_FLOAT_FIR
+  #define FIRCORE_NAME(n) f_##n
+#else
+  #define FIRCORE_NAME(n) d_##n
+#endif
+
+#define create_firmin        FIRCORE_NAME(create_firmin)
+#define calc_firmin          FIRCORE_NAME(calc_firmin)
+#define destroy_firmin       FIRCORE_NAME(destroy_firmin)
+#define flush_firmin         FIRCORE_NAME(flush_firmin)
+#define xfirmin              FIRCORE_NAME(xfirmin)
+#define setBuffers_firmin    FIRCORE_NAME(setBuffers_firmin)
+#define setSamplerate_firmin FIRCORE_NAME(setSamplerate_firmin)
+#define setSize_firmin       FIRCORE_NAME(setSize_firmin)
+#define setFreqs_firmin      FIRCORE_NAME(setFreqs_firmin)
+#define create_firopt        FIRCORE_NAME(create_firopt)
+#define plan_firopt          FIRCORE_NAME(plan_firopt)
+#define calc_firopt          FIRCORE_NAME(calc_firopt)
+#define deplan_firopt        FIRCORE_NAME(deplan_firopt)
+#define destroy_firopt       FIRCORE_NAME(destroy_firopt)
+#define flush_firopt         FIRCORE_NAME(flush_firopt)
+#define xfiropt              FIRCORE_NAME(xfiropt)
+#define setBuffers_firopt    FIRCORE_NAME(setBuffers_firopt)
+#define setSamplerate_firopt FIRCORE_NAME(setSamplerate_firopt)
+#define setSize_firopt       FIRCORE_NAME(setSize_firopt)
+#define setFreqs_firopt      FIRCORE_NAME(setFreqs_firopt)
+#define create_fircore       FIRCORE_NAME(create_fircore)
+#define plan_fircore         FIRCORE_NAME(plan_fircore)
+#define calc_fircore         FIRCORE_NAME(calc_fircore)
+#define deplan_fircore       FIRCORE_NAME(deplan_fircore)
+#define destroy_fircore      FIRCORE_NAME(destroy_fircore)
+#define flush_fircore        FIRCORE_NAME(flush_fircore)
+#define xfircore             FIRCORE_NAME(xfircore)
+#define setBuffers_fircore   FIRCORE_NAME(setBuffers_fircore)
+#define setSize_fircore      FIRCORE_NAME(setSize_fircore)
+#define setImpulse_fircore   FIRCORE_NAME(setImpulse_fircore)
+#define setNc_fircore        FIRCORE_NAME(setNc_fircore)
+#define setMp_fircore        FIRCORE_NAME(setMp_fircore)
+#define setUpdate_fircore    FIRCORE_NAME(setUpdate_fircore)
+
+#include "firmin.c"
@@ -0,0 +1,271 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Checks that the PureSignal curve fits give identical results whether
+ * the cos/sin (AM/PM) fits run serially, as calc() did before, or on the
+ * doPSFit() workers while AM/AM is fitted on the calling thread. The
+ * knots, control points and weights of all three curves, and the fit
+ * results, must match bit for bit. The time per calibration pass is
+ * reported for both variants.
+ *
+ * Without arguments, a synthetic PA capture is used. A recorded capture
+ * is given as the three files written by the calcc diagnostic dump:
+ *
+ *   ./psfit_test DataPoints-MAG.txt DataPoints-COS.txt DataPoints-SIN.txt
+ *
+ * Build and run with "make psfit_test && ./psfit_test".
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "comm.h"
+
+#define SYNTH_POINTS 4096       // 16 intervals x 256 samples, as in calcc
+#define MAX_POINTS   65536
+#define PASSES       20         // calibration passes per variant
+
+typedef struct {
+  int n;
+  NF_Point2 *pts;
+} CAPTURE;
+
+//
+// The same set-up as in calc()
+//
+static void m_config(NF_Config *cfg) {
+  nf_default_config(cfg);
+  cfg->ordering_mode       = NF_ORDER_BY_X;
+  cfg->n_ctrl              = 20;
+  cfg->adaptive_iters      = 0;
+  cfg->outlier_sigma       = 2.5;
+  cfg->local_outlier_iters = 0;
+  cfg->local_outlier_bands = 20;
+  cfg->x_weight_x0         = 0.15;
+  cfg->x_weight_min        = 0.04;
+  cfg->pre_filter_y_max    = 1.8;
+  cfg->pre_filter_x_min    = 0.04;
+  cfg->fold_detect         = 1;
+  cfg->y_min               = 0.0;
+  cfg->y_max               = 0.0;
+  cfg->pin_end             = 1;
+  cfg->end_pt              = (NF_Point2) { 1.0, 1.0 };
+  cfg->pin_start           = 0;
+}
+
+static void phase_config(NF_Config *cfg, const CAPTURE *c) {
+  //
+  // calc() pins the start point to an extrapolated and averaged value,
+  // here the y value of the sample with the smallest x is good enough
+  //
+  int k0 = 0;
+  for (int k = 1; k < c->n; k++) {
+    if (c->pts[k].x < c->pts[k0].x) { k0 = k; }
+  }
+  nf_default_config(cfg);
+  cfg->ordering_mode       = NF_ORDER_BY_X;
+  cfg->n_ctrl              = 20;
+  cfg->adaptive_iters      = 0;
+  cfg->outlier_sigma       = 2.5;
+  cfg->local_outlier_iters = 0;
+  cfg->y_min               = -1.05;
+  cfg->y_max               = +1.05;
+  cfg->fold_detect         = 1;
+  cfg->pre_filter_x_min    = 0.02;
+  cfg->pin_start           = 1;
+  cfg->start_pt            = (NF_Point2) { 0.0, c->pts[k0].y };
+  cfg->pin_end             = 0;
+}
+
+static double noise(void) {
+  return 2.0 * rand() / RAND_MAX - 1.0;
+}
+
+//
+// A PA with gain compression and AM/PM conversion towards full power,
+// as seen through the feedback path, with some measurement noise
+//
+static void synth_capture(CAPTURE *m, CAPTURE *c, CAPTURE *s) {
+  m->n = c->n = s->n = SYNTH_POINTS;
+  m->pts = malloc(SYNTH_POINTS * sizeof(NF_Point2));
+  c->pts = malloc(SYNTH_POINTS * sizeof(NF_Point2));
+  s->pts = malloc(SYNTH_POINTS * sizeof(NF_Point2));
+  for (int k = 0; k < SYNTH_POINTS; k++) {
+    double x = sqrt((k + 0.5) / SYNTH_POINTS);
+    double phi = 0.35 * x * x * x;
+    m->pts[k].x = c->pts[k].x = s->pts[k].x = x;
+    m->pts[k].y = 1.0 + 0.25 * pow(x, 4.0) + 0.01 * noise();
+    c->pts[k].y = cos(phi) + 0.01 * noise();
+    s->pts[k].y = sin(phi) + 0.01 * noise();
+  }
+}
+
+static int read_capture(const char *path, CAPTURE *c) {
+  FILE *f = fopen(path, "r");
+  double x, y;
+  if (f == NULL) {
+    perror(path);
+    return 0;
+  }
+  c->n = 0;
+  c->pts = malloc(MAX_POINTS * sizeof(NF_Point2));
+  while (c->n < MAX_POINTS && fscanf(f, "%lf %lf", &x, &y) == 2) {
+    c->pts[c->n].x = x;
+    c->pts[c->n].y = y;
+    c->n++;
+  }
+  fclose(f);
+  if (c->n == 0) {
+    fprintf(stderr, "%s: no data points\n", path);
+    return 0;
+  }
+  return 1;
+}
+
+//
+// Copies of fit_start() and fit_wait() from calcc.c
+//
+static void fit_start(calcc_fit *f, const NF_Point2 *pts, int n_pts, const NF_Config *cfg, NF_FitResult *res) {
+  f->pts = pts;
+  f->n_pts = n_pts;
+  f->cfg = cfg;
+  f->res = res;
+  f->curve = NULL;
+  f->pending = 1;
+  ReleaseSemaphore(f->go, 1, 0);
+}
+
+static NF_Curve *fit_wait(calcc_fit *f) {
+  if (!f->pending) { return NULL; }
+  WaitForSingleObject(f->done, INFINITE);
+  f->pending = 0;
+  return f->curve;
+}
+
+static int same_curve(const char *name, const NF_Curve *a, const NF_Curve *b, const NF_FitResult *ra,
+                      const NF_FitResult *rb) {
+  if (a == NULL || b == NULL) {
+    if (a != b) {
+      printf("%s: fit failed in one variant only\n", name);
+      return 0;
+    }
+    return 1;
+  }
+  if (a->degree != b->degree || a->n_ctrl != b->n_ctrl) {
+    printf("%s: degree/n_ctrl differ: %d/%d vs %d/%d\n", name, a->degree, a->n_ctrl, b->degree, b->n_ctrl);
+    return 0;
+  }
+  int n = a->n_ctrl;
+  if (memcmp(a->knots, b->knots, (n + a->degree + 1) * sizeof(double)) != 0 ||
+      memcmp(a->ctrl_wx, b->ctrl_wx, n * sizeof(double)) != 0 ||
+      memcmp(a->ctrl_wy, b->ctrl_wy, n * sizeof(double)) != 0 ||
+      memcmp(a->weights, b->weights, n * sizeof(double)) != 0) {
+    printf("%s: coefficients differ\n", name);
+    return 0;
+  }
+  if (ra->quality != rb->quality || ra->rms != rb->rms || ra->n_outliers != rb->n_outliers ||
+      ra->n_ctrl_final != rb->n_ctrl_final || ra->cv_score != rb->cv_score ||
+      ra->fold_detected != rb->fold_detected) {
+    printf("%s: fit results differ\n", name);
+    return 0;
+  }
+  return 1;
+}
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1.0E-9 * ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+  CAPTURE m, c, s;
+  NF_Config mcfg, ccfg, scfg;
+  NF_FitResult res[2][3];
+  NF_Curve *curve[2][3];
+  calcc_fit fit[CALCC_FIT_WORKERS];
+  double t_serial = 0.0, t_parallel = 0.0;
+  int fail = 0;
+  if (argc == 4) {
+    if (!read_capture(argv[1], &m) || !read_capture(argv[2], &c) || !read_capture(argv[3], &s)) {
+      return 1;
+    }
+    printf("capture: %s, %s, %s\n", argv[1], argv[2], argv[3]);
+  } else if (argc == 1) {
+    srand(1);
+    synth_capture(&m, &c, &s);
+    printf("capture: synthetic, %d points\n", SYNTH_POINTS);
+  } else {
+    fprintf(stderr, "usage: %s [MAG-file COS-file SIN-file]\n", argv[0]);
+    return 1;
+  }
+  m_config(&mcfg);
+  phase_config(&ccfg, &c);
+  phase_config(&scfg, &s);
+  memset(fit, 0, sizeof(fit));
+  for (int i = 0; i < CALCC_FIT_WORKERS; i++) {
+    fit[i].go = CreateSemaphoreW(0, 0, 1, 0);
+    fit[i].done = CreateSemaphoreW(0, 0, 1, 0);
+    _beginthread(doPSFit, 0, (void *)&fit[i]);
+  }
+  for (int pass = 0; pass < PASSES && !fail; pass++) {
+    double t0 = now();
+    curve[0][0] = nf_fit(m.pts, m.n, &mcfg, &res[0][0]);
+    curve[0][1] = nf_fit(c.pts, c.n, &ccfg, &res[0][1]);
+    curve[0][2] = nf_fit(s.pts, s.n, &scfg, &res[0][2]);
+    double t1 = now();
+    fit_start(&fit[0], c.pts, c.n, &ccfg, &res[1][1]);
+    fit_start(&fit[1], s.pts, s.n, &scfg, &res[1][2]);
+    curve[1][0] = nf_fit(m.pts, m.n, &mcfg, &res[1][0]);
+    curve[1][1] = fit_wait(&fit[0]);
+    curve[1][2] = fit_wait(&fit[1]);
+    double t2 = now();
+    t_serial += t1 - t0;
+    t_parallel += t2 - t1;
+    if (!same_curve("AM/AM", curve[0][0], curve[1][0], &res[0][0], &res[1][0]) ||
+        !same_curve("AM/PM cos", curve[0][1], curve[1][1], &res[0][1], &res[1][1]) ||
+        !same_curve("AM/PM sin", curve[0][2], curve[1][2], &res[0][2], &res[1][2])) {
+      printf("pass %d: serial and parallel fits differ\n", pass);
+      fail = 1;
+    }
+    for (int v = 0; v < 2; v++) {
+      for (int i = 0; i < 3; i++) {
+        nf_curve_free(curve[v][i]);
+      }
+    }
+  }
+  for (int i = 0; i < CALCC_FIT_WORKERS; i++) {
+    fit[i].quit = 1;
+    ReleaseSemaphore(fit[i].go, 1, 0);
+    WaitForSingleObject(fit[i].done, INFINITE);
+    CloseHandle(fit[i].go);
+    CloseHandle(fit[i].done);
+  }
+  if (!fail) {
+    printf("%d passes: fits identical, serial %.2f ms, parallel %.2f ms per pass\n", PASSES,
+           1.0E3 * t_serial / PASSES, 1.0E3 * t_parallel / PASSES);
+  }
+  free(m.pts);
+  free(c.pts);
+  free(s.pts);
+  return fail;
+}
@@ -0,0 +1,171 @@
+/* Copyright (C)
+*   2026 - Heiko Amft, DL1BZ (Project deskHPSDR)
+*
+*   This program is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*
+*/
+
+/*
+ * Compares the hashed TCI command and mode name lookup (tci_lookup.c)
+ * with the linear searches it replaced, for every command name of the
+ * dispatch table in tci.c, every mode name in several spellings, and a
+ * few names that must not be found. Both variants are timed.
+ *
+ * The command names are extracted from src/tci.c into tests/tci_commands.h
+ * by the Makefile, so the test always covers the current table.
+ *
+ * Build and run with "make tci_lookup_test && ./tci_lookup_test".
+ */
+
+#include <glib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mode.h"
+#include "tci_lookup.h"
+
+#define ROUNDS 20000            // timing: lookups of all names per variant
+
+typedef struct {
+  const char *name;
+  int index;
+} ENTRY;
+
+static const char *commands[] = {
+#include "tci_commands.h"
+  NULL
+};
+
+static const char *unknown[] = {
+  "", "t", "tr", "trx_", "TRX", "vfo_x", "modulation_", "unknown_command", "x"
+};
+
+static const char *mode_names[] = {
+  "lsb", "usb", "dsb", "cw", "cwl", "cwu", "fmn", "fm", "am", "digu", "spec", "digl", "sam", "drm",
+  "LSB", "Usb", "cW", "DIGU", "Spec", "dRm",
+  "", "c", "cwx", "usbx", "lsb ", "ssb", "wfm", "digitalu", "spectrum"
+};
+
+//
+// The command search from tci_handle_text() before the hash
+//
+static const ENTRY *old_find(const ENTRY *table, const char *cmd) {
+  for (int i = 0; table[i].name != NULL; i++) {
+    const ENTRY *d = &table[i];
+    if (cmd[0] != d->name[0] || strcmp(cmd, d->name) != 0) { continue; }
+    return d;
+  }
+  return NULL;
+}
+
+//
+// tci_parse_mode() before the hash
+//
+static int old_parse_mode(const char *mode_str) {
+  if (mode_str == NULL) { return -1; }
+  if (!g_ascii_strcasecmp(mode_str, "lsb"))  { return modeLSB; }
+  if (!g_ascii_strcasecmp(mode_str, "usb"))  { return modeUSB; }
+  if (!g_ascii_strcasecmp(mode_str, "dsb"))  { return modeDSB; }
+  if (!g_ascii_strcasecmp(mode_str, "cw"))   { return modeCWU; }
+  if (!g_ascii_strcasecmp(mode_str, "cwl"))  { return modeCWL; }
+  if (!g_ascii_strcasecmp(mode_str, "cwu"))  { return modeCWU; }
+  if (!g_ascii_strcasecmp(mode_str, "fmn"))  { return modeFMN; }
+  if (!g_ascii_strcasecmp(mode_str, "fm"))   { return modeFMN; }
+  if (!g_ascii_strcasecmp(mode_str, "am"))   { return modeAM; }
+  if (!g_ascii_strcasecmp(mode_str, "digu")) { return modeDIGU; }
+  if (!g_ascii_strcasecmp(mode_str, "spec")) { return modeSPEC; }
+  if (!g_ascii_strcasecmp(mode_str, "digl")) { return modeDIGL; }
+  if (!g_ascii_strcasecmp(mode_str, "sam"))  { return modeSAM; }
+  if (!g_ascii_strcasecmp(mode_str, "drm"))  { return modeDRM; }
+  return -1;
+}
+
+int main(void) {
+  int ncmd = G_N_ELEMENTS(commands) - 1;
+  int nunk = G_N_ELEMENTS(unknown);
+  int nmode = G_N_ELEMENTS(mode_names);
+  ENTRY *table = g_new0(ENTRY, ncmd + 1);
+  const char **names = g_new(const char *, ncmd + nunk);
+  volatile long sink = 0;
+  int errors = 0;
+  for (int i = 0; i < ncmd; i++) {
+    table[i].name = commands[i];
+    table[i].index = i;
+    names[i] = commands[i];
+  }
+  for (int i = 0; i < nunk; i++) {
+    names[ncmd + i] = unknown[i];
+  }
+  GHashTable *index = tci_lookup_index_new(table, sizeof(ENTRY));
+  //
+  // Every name must give the same entry (or none)
+  //
+  for (int i = 0; i < ncmd + nunk; i++) {
+    const ENTRY *a = old_find(table, names[i]);
+    const ENTRY *b = g_hash_table_lookup(index, names[i]);
+    if (a != b) {
+      printf("command \"%s\": linear %d, hashed %d\n", names[i], a ? a->index : -1, b ? b->index : -1);
+      errors++;
+    }
+  }
+  for (int i = 0; i < nmode; i++) {
+    int a = old_parse_mode(mode_names[i]);
+    int b = tci_lookup_mode(mode_names[i]);
+    if (a != b) {
+      printf("mode \"%s\": linear %d, hashed %d\n", mode_names[i], a, b);
+      errors++;
+    }
+  }
+  if (tci_lookup_mode(NULL) != -1) {
+    printf("mode NULL: not rejected\n");
+    errors++;
+  }
+  printf("%d commands, %d unknown names, %d mode names: %d mismatches\n", ncmd, nunk, nmode, errors);
+  //
+  // Timing
+  //
+  gint64 t0 = g_get_monotonic_time();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < ncmd + nunk; i++) {
+      sink += (long) old_find(table, names[i]);
+    }
+  }
+  gint64 t1 = g_get_monotonic_time();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < ncmd + nunk; i++) {
+      sink += (long) g_hash_table_lookup(index, names[i]);
+    }
+  }
+  gint64 t2 = g_get_monotonic_time();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < nmode; i++) {
+      sink += old_parse_mode(mode_names[i]);
+    }
+  }
+  gint64 t3 = g_get_monotonic_time();
+  for (int r = 0; r < ROUNDS; r++) {
+    for (int i = 0; i < nmode; i++) {
+      sink += tci_lookup_mode(mode_names[i]);
+    }
+  }
+  gint64 t4 = g_get_monotonic_time();
+  double nc = (double) ROUNDS * (ncmd + nunk);
+  double nm = (double) ROUNDS * nmode;
+  printf("command lookup: linear %.1f ns, hashed %.1f ns\n", 1.0E3 * (t1 - t0) / nc, 1.0E3 * (t2 - t1) / nc);
+  printf("mode lookup:    linear %.1f ns, hashed %.1f ns\n", 1.0E3 * (t3 - t2) / nm, 1.0E3 * (t4 - t3) / nm);
+  g_hash_table_destroy(index);
+  g_free(names);
+  g_free(table);
+  return errors != 0;
+}
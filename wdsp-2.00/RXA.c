@@ -602,51 +602,214 @@ void flush_rxa(int channel) {
   flush_resample(rxa[channel].rsmpout.p);
 }
 
+static const char *rxa_stage_name[RXA_ST_LAST] = {
+  "shift", "rsmpin", "gen0", "adcmeter", "bpsnbain0", "nbp0", "smeter", "sender",
+  "amsqcap", "bpsnbaout0", "amd", "wbfm", "fmd", "fmsq", "bpsnbain1", "bpsnbaout1",
+  "snba", "eqp", "anf0", "anr0", "emnr0", "rnnr0", "sbnr0", "bp1_0", "agc",
+  "anf1", "anr1", "emnr1", "rnnr1", "sbnr1", "bp1_1", "agcmeter", "sip1", "cbl",
+  "doublepole", "matched", "gaussian", "speak", "mpeak", "ssql", "panel", "amsq", "rsmpout"
+};
+
+/*
+ * A stage is inactive if its x-function would neither process nor copy,
+ * that is, if it is not running (at this position) and works in-place.
+ * Only stages with such a simple run condition are ever bypassed, meters,
+ * resamplers, the sender and the patch panel always run.
+ */
+static int rxa_stage_active(int channel, int stage) {
+  struct _rxa *r = &rxa[channel];
+  switch (stage) {
+  case RXA_ST_GEN0:
+    return r->gen0.p->run || r->gen0.p->in != r->gen0.p->out;
+  case RXA_ST_BPSNBAIN0:
+  case RXA_ST_BPSNBAOUT0:
+    return r->bpsnba.p->run && r->bpsnba.p->position == 0;
+  case RXA_ST_BPSNBAIN1:
+  case RXA_ST_BPSNBAOUT1:
+    return r->bpsnba.p->run && r->bpsnba.p->position == 1;
+  case RXA_ST_NBP0:
+    return (r->nbp0.p->run && r->nbp0.p->position == 0) || r->nbp0.p->in != r->nbp0.p->out;
+  case RXA_ST_AMD:
+    return r->amd.p->run || r->amd.p->in_buff != r->amd.p->out_buff;
+  case RXA_ST_WBFM:
+    return r->wbfm.p->run || r->wbfm.p->in != r->wbfm.p->out;
+  case RXA_ST_FMD:
+    return r->fmd.p->run || r->fmd.p->in != r->fmd.p->out;
+  case RXA_ST_FMSQ:
+    return r->fmsq.p->run || r->fmsq.p->insig != r->fmsq.p->outsig;
+  case RXA_ST_SNBA:
+    return r->snba.p->run || r->snba.p->in != r->snba.p->out;
+  case RXA_ST_EQP:
+    return r->eqp.p->run || r->eqp.p->in != r->eqp.p->out;
+  case RXA_ST_ANF0:
+  case RXA_ST_ANF1:
+    return (r->anf.p->run && r->anf.p->position == (stage == RXA_ST_ANF1)) || r->anf.p->in_buff != r->anf.p->out_buff;
+  case RXA_ST_ANR0:
+  case RXA_ST_ANR1:
+    return (r->anr.p->run && r->anr.p->position == (stage == RXA_ST_ANR1)) || r->anr.p->in_buff != r->anr.p->out_buff;
+  case RXA_ST_EMNR0:
+  case RXA_ST_EMNR1:
+    return (r->emnr.p->run && r->emnr.p->position == (stage == RXA_ST_EMNR1)) || r->emnr.p->in != r->emnr.p->out;
+  case RXA_ST_RNNR0:
+  case RXA_ST_RNNR1:
+    return (r->rnnr.p->run && r->rnnr.p->position == (stage == RXA_ST_RNNR1)) || r->rnnr.p->in != r->rnnr.p->out;
+  case RXA_ST_SBNR0:
+  case RXA_ST_SBNR1:
+    return (r->sbnr.p->run && r->sbnr.p->position == (stage == RXA_ST_SBNR1)) || r->sbnr.p->in != r->sbnr.p->out;
+  case RXA_ST_BP1_0:
+  case RXA_ST_BP1_1:
+    return (r->bp1.p->run && r->bp1.p->position == (stage == RXA_ST_BP1_1)) || r->bp1.p->in != r->bp1.p->out;
+  case RXA_ST_SIP1:
+    return r->sip1.p->run && r->sip1.p->position == 0;
+  case RXA_ST_CBL:
+    return r->cbl.p->run || r->cbl.p->in_buff != r->cbl.p->out_buff;
+  case RXA_ST_DOUBLEPOLE:
+    return (r->doublepole.p->run && r->doublepole.p->position == 0) || r->doublepole.p->in != r->doublepole.p->out;
+  case RXA_ST_MATCHED:
+    return (r->matched.p->run && r->matched.p->position == 0) || r->matched.p->in != r->matched.p->out;
+  case RXA_ST_GAUSSIAN:
+    return (r->gaussian.p->run && r->gaussian.p->position == 0) || r->gaussian.p->in != r->gaussian.p->out;
+  case RXA_ST_SPEAK:
+    return r->speak.p->run || r->speak.p->in != r->speak.p->out;
+  case RXA_ST_MPEAK:
+    return r->mpeak.p->run || r->mpeak.p->in != r->mpeak.p->out;
+  case RXA_ST_SSQL:
+    return r->ssql.p->run || r->ssql.p->in != r->ssql.p->out;
+  case RXA_ST_AMSQ:
+    return r->amsq.p->run || r->amsq.p->in != r->amsq.p->out;
+  default:
+    return 1;
+  }
+}
+
+static void rxa_stage_run(int channel, int stage) {
+  struct _rxa *r = &rxa[channel];
+  switch (stage) {
+  case RXA_ST_SHIFT:      xshift(r->shift.p); break;
+  case RXA_ST_RSMPIN:     xHBResampler(r->rsmpin.p); break;
+  case RXA_ST_GEN0:       xgen(r->gen0.p); break;
+  case RXA_ST_ADCMETER:   xmeter(r->adcmeter.p); break;
+  case RXA_ST_BPSNBAIN0:  xbpsnbain(r->bpsnba.p, 0); break;
+  case RXA_ST_NBP0:       xnbp(r->nbp0.p, 0); break;
+  case RXA_ST_SMETER:     xmeter(r->smeter.p); break;
+  case RXA_ST_SENDER:     xsender(r->sender.p); break;
+  case RXA_ST_AMSQCAP:    xamsqcap(r->amsq.p); break;
+  case RXA_ST_BPSNBAOUT0: xbpsnbaout(r->bpsnba.p, 0); break;
+  case RXA_ST_AMD:        xamd(r->amd.p); break;
+  case RXA_ST_WBFM:       xwbfm(r->wbfm.p); break;
+  case RXA_ST_FMD:        xfmd(r->fmd.p); break;
+  case RXA_ST_FMSQ:       xfmsq(r->fmsq.p); break;
+  case RXA_ST_BPSNBAIN1:  xbpsnbain(r->bpsnba.p, 1); break;
+  case RXA_ST_BPSNBAOUT1: xbpsnbaout(r->bpsnba.p, 1); break;
+  case RXA_ST_SNBA:       xsnba(r->snba.p); break;
+  case RXA_ST_EQP:        xeqp(r->eqp.p); break;
+  case RXA_ST_ANF0:       xanf(r->anf.p, 0); break;
+  case RXA_ST_ANR0:       xanr(r->anr.p, 0); break;
+  case RXA_ST_EMNR0:      xemnr(r->emnr.p, 0); break;
+  case RXA_ST_RNNR0:      xrnnr(r->rnnr.p, 0); break;    // NR3 + NR4 support (nr3)
+  case RXA_ST_SBNR0:      xsbnr(r->sbnr.p, 0); break;    // NR3 + NR4 support (nr4)
+  case RXA_ST_BP1_0:      xbandpass(r->bp1.p, 0); break;
+  case RXA_ST_AGC:        xwcpagc(r->agc.p); break;
+  case RXA_ST_ANF1:       xanf(r->anf.p, 1); break;
+  case RXA_ST_ANR1:       xanr(r->anr.p, 1); break;
+  case RXA_ST_EMNR1:      xemnr(r->emnr.p, 1); break;
+  case RXA_ST_RNNR1:      xrnnr(r->rnnr.p, 1); break;    // NR3 + NR4 support (nr3)
+  case RXA_ST_SBNR1:      xsbnr(r->sbnr.p, 1); break;    // NR3 + NR4 support (nr4)
+  case RXA_ST_BP1_1:      xbandpass(r->bp1.p, 1); break;
+  case RXA_ST_AGCMETER:   xmeter(r->agcmeter.p); break;
+  case RXA_ST_SIP1:       xsiphon(r->sip1.p, 0); break;
+  case RXA_ST_CBL:        xcbl(r->cbl.p); break;
+  case RXA_ST_DOUBLEPOLE: xdoublepole(r->doublepole.p, 0); break;
+  case RXA_ST_MATCHED:    xmatched(r->matched.p, 0); break;
+  case RXA_ST_GAUSSIAN:   xgaussian(r->gaussian.p, 0); break;
+  case RXA_ST_SPEAK:      xspeak(r->speak.p); break;
+  case RXA_ST_MPEAK:      xmpeak(r->mpeak.p); break;
+  case RXA_ST_SSQL:       xssql(r->ssql.p); break;
+  case RXA_ST_PANEL:      xpanel(r->panel.p); break;
+  case RXA_ST_AMSQ:       xamsq(r->amsq.p); break;
+  case RXA_ST_RSMPOUT:    xresample(r->rsmpout.p); break;
+  }
+}
+
+/*
+ * The run flags, positions and buffers only change under csDSP, which is
+ * also held while xrxa() runs. The activity mask is therefore re-evaluated
+ * once per block (flag reads only), and the list of active stages is only
+ * rebuilt if the mask has changed. Inactive stages are not called at all,
+ * which also saves the critical sections of xspeak/xmpeak/xsiphon.
+ */
 void xrxa(int channel) {
-  xshift(rxa[channel].shift.p);
-  //xresample (rxa[channel].rsmpin.p);
-  xHBResampler(rxa[channel].rsmpin.p);
-  xgen(rxa[channel].gen0.p);
-  xmeter(rxa[channel].adcmeter.p);
-  xbpsnbain(rxa[channel].bpsnba.p, 0);
-  xnbp(rxa[channel].nbp0.p, 0);
-  xmeter(rxa[channel].smeter.p);
-  xsender(rxa[channel].sender.p);
-  xamsqcap(rxa[channel].amsq.p);
-  xbpsnbaout(rxa[channel].bpsnba.p, 0);
-  xamd(rxa[channel].amd.p);
-  xwbfm(rxa[channel].wbfm.p);
-  xfmd(rxa[channel].fmd.p);
-  xfmsq(rxa[channel].fmsq.p);
-  xbpsnbain(rxa[channel].bpsnba.p, 1);
-  xbpsnbaout(rxa[channel].bpsnba.p, 1);
-  xsnba(rxa[channel].snba.p);
-  xeqp(rxa[channel].eqp.p);
-  xanf(rxa[channel].anf.p, 0);
-  xanr(rxa[channel].anr.p, 0);
-  xemnr(rxa[channel].emnr.p, 0);
-  xrnnr(rxa[channel].rnnr.p, 0);    // NR3 + NR4 support (nr3)
-  xsbnr(rxa[channel].sbnr.p, 0);    // NR3 + NR4 support (nr4)
-  xbandpass(rxa[channel].bp1.p, 0);
-  xwcpagc(rxa[channel].agc.p);
-  xanf(rxa[channel].anf.p, 1);
-  xanr(rxa[channel].anr.p, 1);
-  xemnr(rxa[channel].emnr.p, 1);
-  xrnnr(rxa[channel].rnnr.p, 1);    // NR3 + NR4 support (nr3)
-  xsbnr(rxa[channel].sbnr.p, 1);    // NR3 + NR4 support (nr4)
-  xbandpass(rxa[channel].bp1.p, 1);
-  xmeter(rxa[channel].agcmeter.p);
-  xsiphon(rxa[channel].sip1.p, 0);
-  xcbl(rxa[channel].cbl.p);
-  xdoublepole(rxa[channel].doublepole.p, 0);
-  xmatched(rxa[channel].matched.p, 0);
-  xgaussian(rxa[channel].gaussian.p, 0);
-  xspeak(rxa[channel].speak.p);
-  xmpeak(rxa[channel].mpeak.p);
-  xssql(rxa[channel].ssql.p);
-  xpanel(rxa[channel].panel.p);
-  xamsq(rxa[channel].amsq.p);
-  xresample(rxa[channel].rsmpout.p);
+  struct _rxa *r = &rxa[channel];
+  unsigned long long mask = 0;
+  int i;
+  for (i = 0; i < RXA_ST_LAST; i++) {
+    if (rxa_stage_active(channel, i)) {
+      mask |= 1ULL << i;
+    }
+  }
+  if (mask != r->stage_mask || r->n_active == 0) {
+    r->stage_mask = mask;
+    r->n_active = 0;
+    for (i = 0; i < RXA_ST_LAST; i++) {
+      if (mask & (1ULL << i)) {
+        r->active[r->n_active++] = (unsigned char) i;
+      }
+    }
+  }
+  if (r->prof_run) {
+    for (i = 0; i < r->n_active; i++) {
+      int stage = r->active[i];
+      double t0 = wdsp_time_ms();
+      rxa_stage_run(channel, stage);
+      double dt = wdsp_time_ms() - t0;
+      r->prof[stage].calls++;
+      r->prof[stage].sum_ms += dt;
+      if (dt > r->prof[stage].max_ms) { r->prof[stage].max_ms = dt; }
+    }
+  } else {
+    for (i = 0; i < r->n_active; i++) {
+      rxa_stage_run(channel, r->active[i]);
+    }
+  }
+}
+
+/********************************************************************************************************
+*                                                   *
+*                   RXA Stage Profiling                     *
+*                                                   *
+********************************************************************************************************/
+
+PORT
+int GetRXAStageCount(void) {
+  return RXA_ST_LAST;
+}
+
+PORT
+const char *GetRXAStageName(int stage) {
+  if (stage < 0 || stage >= RXA_ST_LAST) { return ""; }
+  return rxa_stage_name[stage];
+}
+
+// switching the profiler on or off resets the counters
+PORT
+void SetRXAStageProfile(int channel, int run) {
+  EnterCriticalSection(&ch[channel].csDSP);
+  memset(rxa[channel].prof, 0, sizeof(rxa[channel].prof));
+  rxa[channel].prof_run = run;
+  LeaveCriticalSection(&ch[channel].csDSP);
+}
+
+// returns 1 if the stage is currently active. Times in micro-seconds.
+PORT
+int GetRXAStageProfile(int channel, int stage, long *calls, double *avg_us, double *max_us) {
+  int active;
+  if (stage < 0 || stage >= RXA_ST_LAST) { return 0; }
+  // no csDSP here, to not stall the caller for a DSP block; values may be slightly inconsistent
+  *calls = rxa[channel].prof[stage].calls;
+  *avg_us = *calls > 0 ? 1000.0 * rxa[channel].prof[stage].sum_ms / (double) * calls : 0.0;
+  *max_us = 1000.0 * rxa[channel].prof[stage].max_ms;
+  active = (rxa[channel].stage_mask >> stage) & 1;
+  return active;
 }
 
 void setInputSamplerate_rxa(int channel) {
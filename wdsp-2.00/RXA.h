@@ -44,6 +44,54 @@ enum rxaMode {
   RXA_WBFM = 12
 };
 
+// stages of the receive chain, in processing order
+enum rxaStage {
+  RXA_ST_SHIFT,
+  RXA_ST_RSMPIN,
+  RXA_ST_GEN0,
+  RXA_ST_ADCMETER,
+  RXA_ST_BPSNBAIN0,
+  RXA_ST_NBP0,
+  RXA_ST_SMETER,
+  RXA_ST_SENDER,
+  RXA_ST_AMSQCAP,
+  RXA_ST_BPSNBAOUT0,
+  RXA_ST_AMD,
+  RXA_ST_WBFM,
+  RXA_ST_FMD,
+  RXA_ST_FMSQ,
+  RXA_ST_BPSNBAIN1,
+  RXA_ST_BPSNBAOUT1,
+  RXA_ST_SNBA,
+  RXA_ST_EQP,
+  RXA_ST_ANF0,
+  RXA_ST_ANR0,
+  RXA_ST_EMNR0,
+  RXA_ST_RNNR0,
+  RXA_ST_SBNR0,
+  RXA_ST_BP1_0,
+  RXA_ST_AGC,
+  RXA_ST_ANF1,
+  RXA_ST_ANR1,
+  RXA_ST_EMNR1,
+  RXA_ST_RNNR1,
+  RXA_ST_SBNR1,
+  RXA_ST_BP1_1,
+  RXA_ST_AGCMETER,
+  RXA_ST_SIP1,
+  RXA_ST_CBL,
+  RXA_ST_DOUBLEPOLE,
+  RXA_ST_MATCHED,
+  RXA_ST_GAUSSIAN,
+  RXA_ST_SPEAK,
+  RXA_ST_MPEAK,
+  RXA_ST_SSQL,
+  RXA_ST_PANEL,
+  RXA_ST_AMSQ,
+  RXA_ST_RSMPOUT,
+  RXA_ST_LAST
+};
+
 enum rxaMeterType {
   RXA_S_PK,
   RXA_S_AV,
@@ -60,6 +108,17 @@ struct _rxa {
   double *outbuff;
   double *midbuff;
   int mode;
+  // compact list of the stages that do something, rebuilt when the mask changes
+  unsigned long long stage_mask;
+  int n_active;
+  unsigned char active[RXA_ST_LAST];
+  // optional per-stage timing
+  int prof_run;
+  struct {
+    long calls;
+    double sum_ms;
+    double max_ms;
+  } prof[RXA_ST_LAST];
   double meter[RXA_METERTYPE_LAST];
   CRITICAL_SECTION *pmtupdate[RXA_METERTYPE_LAST];
   struct {
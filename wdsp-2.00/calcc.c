@@ -345,6 +345,11 @@ CALCC create_calcc(int channel, int runcal, int size, int rate, double hw_scale,
   }
   a->hCorrChangeExited = CreateEvent(NULL, FALSE, FALSE, NULL);
   _beginthread(doPSCorrChange, 0, (void *)a);
+  for (int i = 0; i < CALCC_FIT_WORKERS; i++) {
+    a->fit[i].go = CreateSemaphoreW(0, 0, 1, 0);
+    a->fit[i].done = CreateSemaphoreW(0, 0, 1, 0);
+    _beginthread(doPSFit, 0, (void *)&a->fit[i]);
+  }
   return a;
 }
 
@@ -368,6 +373,22 @@ void destroy_calcc(CALCC a) {
   ReleaseSemaphore(a->SemsPSCorr[4], 1, 0);
   WaitForSingleObject(a->hCorrChangeExited, 500);
   CloseHandle(a->hCorrChangeExited);
+  //
+  // The fit workers use a->fit[i], which is freed below, so wait for them
+  // without a timeout. A fit always completes in bounded time.
+  //
+  for (int i = 0; i < CALCC_FIT_WORKERS; i++) {
+    if (a->fit[i].pending) {
+      WaitForSingleObject(a->fit[i].done, INFINITE);
+      nf_curve_free(a->fit[i].curve);
+      a->fit[i].pending = 0;
+    }
+    a->fit[i].quit = 1;
+    ReleaseSemaphore(a->fit[i].go, 1, 0);
+    WaitForSingleObject(a->fit[i].done, INFINITE);
+    CloseHandle(a->fit[i].go);
+    CloseHandle(a->fit[i].done);
+  }
   ns_free(a->m_spline);
   a->m_spline = NULL;
   ns_free(a->c_spline);
@@ -595,6 +616,85 @@ static int equalize_density(CALCC a) {
   return n;
 }
 
+void __cdecl doPSFit(void *arg) {
+  calcc_fit *f = (calcc_fit *)arg;
+  while (1) {
+    WaitForSingleObject(f->go, INFINITE);
+    if (f->quit) {
+      SetEvent(f->done);
+      return;
+    }
+    f->curve = nf_fit(f->pts, f->n_pts, f->cfg, f->res);
+    SetEvent(f->done);
+  }
+}
+
+static void fit_start(calcc_fit *f, const NF_Point2 *pts, int n_pts, const NF_Config *cfg, NF_FitResult *res) {
+  f->pts = pts;
+  f->n_pts = n_pts;
+  f->cfg = cfg;
+  f->res = res;
+  f->curve = NULL;
+  f->pending = 1;
+  ReleaseSemaphore(f->go, 1, 0);
+}
+
+static NF_Curve *fit_wait(calcc_fit *f) {
+  if (!f->pending) { return NULL; }
+  WaitForSingleObject(f->done, INFINITE);
+  f->pending = 0;
+  return f->curve;
+}
+
+//
+// Data, start-point pin and config for a cos/sin (AM/PM) fit. The updated
+// pin EMA state is returned in new_ema/new_cycle and committed by the caller.
+//
+static void phase_fit_setup(CALCC a, const double *y, NF_Point2 *data, NF_Config *cfg,
+                            double pin_ema, int pin_valid, int pin_cycle,
+                            double *new_ema, int *new_cycle) {
+  for (int k = 0; k < a->nsamps; k++) {
+    data[k].x = a->x[k];
+    data[k].y = y[k];
+  }
+  ExtrapolationResult pin_res = extrapolate_y_at_0(
+                                        a->x, y, a->nsamps,
+                                        0.001,
+                                        0.15);
+  double y_pin_raw = pin_res.y_at_1;
+  if (y_pin_raw < -1.1) { y_pin_raw = -1.1; }
+  if (y_pin_raw >  1.1) { y_pin_raw =  1.1; }
+  if (!pin_valid) {
+    *new_ema   = y_pin_raw;
+    *new_cycle = 1;
+  } else {
+    const int    PIN_WARMUP_CYCLES = 5;
+    const double PIN_WARMUP_ALPHA  = 0.40;
+    double eff_alpha;
+    if (pin_cycle <= PIN_WARMUP_CYCLES) {
+      eff_alpha = PIN_WARMUP_ALPHA;
+    } else
+      eff_alpha = (pin_res.confidence == EXTRAP_CONFIDENT)
+                  ? a->pin_alpha : a->pin_alpha * 0.5;
+    *new_ema = eff_alpha * y_pin_raw
+               + (1.0 - eff_alpha) * pin_ema;
+    *new_cycle = (pin_cycle <= PIN_WARMUP_CYCLES) ? pin_cycle + 1 : pin_cycle;
+  }
+  nf_default_config(cfg);
+  cfg->ordering_mode       = NF_ORDER_BY_X;
+  cfg->n_ctrl              = 20;
+  cfg->adaptive_iters      = 0;
+  cfg->outlier_sigma       = 2.5;
+  cfg->local_outlier_iters = 0;
+  cfg->y_min               = -1.05;
+  cfg->y_max               = +1.05;
+  cfg->fold_detect         = 1;
+  cfg->pre_filter_x_min    = 0.02;
+  cfg->pin_start           = 1;
+  cfg->start_pt            = (NF_Point2) { 0.0, *new_ema };
+  cfg->pin_end             = 0;
+}
+
 static void calc(CALCC a) {
   a->binfo[7]++;
   a->m_nurb = NULL;
@@ -671,6 +771,24 @@ static void calc(CALCC a) {
     a->eq_n = equalize_density(a);
     if (a->eq_n >= a->eq_min_pts) { eq_used = 1; }
   }
+  //
+  // The cos/sin fits do not depend on the AM/AM result, so they run on the
+  // fit workers while AM/AM is fitted here. Their pin EMA state is only
+  // committed once the AM/AM curve has been accepted, as before.
+  //
+  double c_pin_ema, s_pin_ema;
+  int c_pin_cycle, s_pin_cycle;
+  phase_fit_setup(a, a->yc, a->c_data, a->c_config, a->c_y_pin_ema, a->c_y_pin_valid, a->c_pin_cycle,
+                  &c_pin_ema, &c_pin_cycle);
+  phase_fit_setup(a, a->ys, a->s_data, a->s_config, a->s_y_pin_ema, a->s_y_pin_valid, a->s_pin_cycle,
+                  &s_pin_ema, &s_pin_cycle);
+  if (eq_used) {
+    fit_start(&a->fit[0], a->c_eqd, a->eq_n, a->c_config, a->c_nfres);
+    fit_start(&a->fit[1], a->s_eqd, a->eq_n, a->s_config, a->s_nfres);
+  } else {
+    fit_start(&a->fit[0], a->c_data, a->nsamps, a->c_config, a->c_nfres);
+    fit_start(&a->fit[1], a->s_data, a->nsamps, a->s_config, a->s_nfres);
+  }
   for (int k = 0; k < a->nsamps; k++) {
     a->m_data[k].x = a->x[k];
     a->m_data[k].y = a->ym[k];
@@ -763,52 +881,11 @@ static void calc(CALCC a) {
   }
   a->m_prev_y = a->m_calavg.ys[0];
   a->binfo[2] = 0x0000;
-  for (int k = 0; k < a->nsamps; k++) {
-    a->c_data[k].x = a->x[k];
-    a->c_data[k].y = a->yc[k];
-  }
-  {
-    ExtrapolationResult pin_res = extrapolate_y_at_0(
-                                          a->x, a->yc, a->nsamps,
-                                          0.001,
-                                          0.15);
-    double y_pin_raw = pin_res.y_at_1;
-    if (y_pin_raw < -1.1) { y_pin_raw = -1.1; }
-    if (y_pin_raw >  1.1) { y_pin_raw =  1.1; }
-    if (!a->c_y_pin_valid) {
-      a->c_y_pin_ema   = y_pin_raw;
-      a->c_y_pin_valid = 1;
-      a->c_pin_cycle   = 1;
-    } else {
-      const int    PIN_WARMUP_CYCLES = 5;
-      const double PIN_WARMUP_ALPHA  = 0.40;
-      double eff_alpha;
-      if (a->c_pin_cycle <= PIN_WARMUP_CYCLES) {
-        eff_alpha = PIN_WARMUP_ALPHA;
-      } else
-        eff_alpha = (pin_res.confidence == EXTRAP_CONFIDENT)
-                    ? a->pin_alpha : a->pin_alpha * 0.5;
-      a->c_y_pin_ema = eff_alpha * y_pin_raw
-                       + (1.0 - eff_alpha) * a->c_y_pin_ema;
-      if (a->c_pin_cycle <= PIN_WARMUP_CYCLES) { a->c_pin_cycle++; }
-    }
-  }
-  nf_default_config(a->c_config);
-  a->c_config->ordering_mode       = NF_ORDER_BY_X;
-  a->c_config->n_ctrl              = 20;
-  a->c_config->adaptive_iters      = 0;
-  a->c_config->outlier_sigma       = 2.5;
-  a->c_config->local_outlier_iters = 0;
-  a->c_config->y_min               = -1.05;
-  a->c_config->y_max               = +1.05;
-  a->c_config->fold_detect         = 1;
-  a->c_config->pre_filter_x_min    = 0.02;
-  a->c_config->pin_start           = 1;
-  a->c_config->start_pt            = (NF_Point2) { 0.0, a->c_y_pin_ema };
-  a->c_config->pin_end             = 0;
+  a->c_y_pin_ema   = c_pin_ema;
+  a->c_y_pin_valid = 1;
+  a->c_pin_cycle   = c_pin_cycle;
   a->c_ctrl_n = a->c_config->n_ctrl;
-  if (eq_used) { a->c_nurb = nf_fit(a->c_eqd, a->eq_n, a->c_config, a->c_nfres); }
-  else { a->c_nurb = nf_fit(a->c_data, a->nsamps, a->c_config, a->c_nfres); }
+  a->c_nurb = fit_wait(&a->fit[0]);
   if (a->c_nurb == NULL) {
     a->binfo[2] |= 0b0001;
     goto cleanup;
@@ -867,52 +944,11 @@ static void calc(CALCC a) {
   curve_ema_update(&a->c_calavg, a->c_spline);
   a->c_prev_y = a->c_calavg.ys[0];
   a->binfo[3] = 0x0000;
-  for (int k = 0; k < a->nsamps; k++) {
-    a->s_data[k].x = a->x[k];
-    a->s_data[k].y = a->ys[k];
-  }
-  {
-    ExtrapolationResult pin_res = extrapolate_y_at_0(
-                                          a->x, a->ys, a->nsamps,
-                                          0.001,
-                                          0.15);
-    double y_pin_raw = pin_res.y_at_1;
-    if (y_pin_raw < -1.1) { y_pin_raw = -1.1; }
-    if (y_pin_raw >  1.1) { y_pin_raw =  1.1; }
-    if (!a->s_y_pin_valid) {
-      a->s_y_pin_ema   = y_pin_raw;
-      a->s_y_pin_valid = 1;
-      a->s_pin_cycle   = 1;
-    } else {
-      const int    PIN_WARMUP_CYCLES = 5;
-      const double PIN_WARMUP_ALPHA  = 0.40;
-      double eff_alpha;
-      if (a->s_pin_cycle <= PIN_WARMUP_CYCLES) {
-        eff_alpha = PIN_WARMUP_ALPHA;
-      } else
-        eff_alpha = (pin_res.confidence == EXTRAP_CONFIDENT)
-                    ? a->pin_alpha : a->pin_alpha * 0.5;
-      a->s_y_pin_ema = eff_alpha * y_pin_raw
-                       + (1.0 - eff_alpha) * a->s_y_pin_ema;
-      if (a->s_pin_cycle <= PIN_WARMUP_CYCLES) { a->s_pin_cycle++; }
-    }
-  }
-  nf_default_config(a->s_config);
-  a->s_config->ordering_mode       = NF_ORDER_BY_X;
-  a->s_config->n_ctrl              = 20;
-  a->s_config->adaptive_iters      = 0;
-  a->s_config->outlier_sigma       = 2.5;
-  a->s_config->local_outlier_iters = 0;
-  a->s_config->y_min               = -1.05;
-  a->s_config->y_max               = +1.05;
-  a->s_config->fold_detect         = 1;
-  a->s_config->pre_filter_x_min    = 0.02;
-  a->s_config->pin_start           = 1;
-  a->s_config->start_pt            = (NF_Point2) { 0.0, a->s_y_pin_ema };
-  a->s_config->pin_end             = 0;
+  a->s_y_pin_ema   = s_pin_ema;
+  a->s_y_pin_valid = 1;
+  a->s_pin_cycle   = s_pin_cycle;
   a->s_ctrl_n = a->s_config->n_ctrl;
-  if (eq_used) { a->s_nurb = nf_fit(a->s_eqd, a->eq_n, a->s_config, a->s_nfres); }
-  else { a->s_nurb = nf_fit(a->s_data, a->nsamps, a->s_config, a->s_nfres); }
+  a->s_nurb = fit_wait(&a->fit[1]);
   if (a->s_nurb == NULL) {
     a->binfo[3] |= 0b0001;
     goto cleanup;
@@ -1068,6 +1104,10 @@ static void calc(CALCC a) {
   }
   LeaveCriticalSection(&a->disp.cs_disp);
 cleanup:
+  for (int i = 0; i < CALCC_FIT_WORKERS; i++) {
+    // fits not collected because of an early exit
+    nf_curve_free(fit_wait(&a->fit[i]));
+  }
   nf_curve_free(a->m_nurb);
   a->m_nurb = NULL;
   nf_curve_free(a->c_nurb);
@@ -1173,6 +1213,7 @@ void __cdecl doPSCorrChange(void *arg) {
           a->c_spline = NULL;
           a->s_spline = NULL;
         }
+        a->binfo[8] = (int)(wdsp_time_ms() - a->calc_t0 + 0.5);
         InterlockedBitTestAndSet(&a->ctrl.calcdone, 0);
         break;
       case 4:
@@ -1361,10 +1402,12 @@ void pscc(int channel, int size, double *tx, double *rx) {
       InterlockedExchange(&a->ctrl.current_state, LCALC);
       if (!a->ctrl.calcinprogress) {
         a->ctrl.calcinprogress = 1;
+        a->calc_t0 = wdsp_time_ms();
         ReleaseSemaphore(a->SemsPSCorr[3], 1, 0);
       }
       if (InterlockedBitTestAndReset(&a->ctrl.calcdone, 0)) {
         memcpy(a->info, a->binfo, 8 * sizeof(int));
+        a->info[8] = a->binfo[8];
         a->info[14] = _InterlockedAnd(&a->ctrl.running, 1);
         a->ctrl.calcinprogress = 0;
         if (a->ctrl.reset) {
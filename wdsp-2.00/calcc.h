@@ -57,6 +57,24 @@ typedef struct _psCollection {
   int nfull;
 } psCollection;
 
+//
+// Worker for one NURBS fit. The AM/PM fits (cos, sin) run on these
+// while the calculation thread does the AM/AM fit.
+//
+#define CALCC_FIT_WORKERS 2
+
+typedef struct _calcc_fit {
+  const NF_Point2 *pts;
+  int n_pts;
+  const NF_Config *cfg;
+  NF_FitResult *res;
+  NF_Curve *curve;
+  int pending;
+  volatile int quit;
+  HANDLE go;
+  HANDLE done;
+} calcc_fit;
+
 typedef struct _calcc {
   int channel;
   int runcal;
@@ -83,6 +101,8 @@ typedef struct _calcc {
   double txdel;
 
   HANDLE SemsPSCorr[5];
+  calcc_fit fit[CALCC_FIT_WORKERS];
+  double calc_t0;
 
   NF_Config    *m_config, *c_config, *s_config;
   NF_Point2    *m_data,   *c_data,   *s_data;
@@ -230,6 +250,8 @@ extern __declspec(dllexport) void pscc (int channel, int size, double *tx, doubl
 
 extern void __cdecl doPSCorrChange(void *arg);
 
+extern void __cdecl doPSFit(void *arg);
+
 extern void print_FitResult_and_Data(CALCC a, char *type, int printWhat);
 
 extern void print_OriginalAndFitSamples(CALCC a);
@@ -264,6 +286,7 @@ extern void print_OriginalAndFitSamples(CALCC a);
 //              0b0001 = New-Old Soln Compare Check
 //          0b0010 = Stuck, Can't FIll Buckets, Probable Over-Drive
 //     7 - count of attempted calibrations
+//     8 - time-to-correction of the last calculation in ms
 //
 //      12 - file write/read error
 //    13 -
@@ -263,6 +263,32 @@ void setFreqs_firopt(FIROPT a, double f_low, double f_high) {
 ********************************************************************************************************/
 
 
+//
+// Copy 'n' complex samples between the double-precision caller buffers and
+// the kernel buffers. These are plain memcpy's unless WDSP_FLOAT_FIR is set.
+//
+static inline void fir_load(fir_real *dst, const double *src, int n) {
+#ifdef WDSP_FLOAT_FIR
+  for (int i = 0; i < 2 * n; i++) {
+    dst[i] = (fir_real)src[i];
+  }
+#else
+  memcpy(dst, src, n * sizeof(complex));
+#endif
+}
+
+static inline void fir_store(double *dst, const fir_real *src, int n) {
+#ifdef WDSP_FLOAT_FIR
+  for (int i = 0; i < 2 * n; i++) {
+    dst[i] = (double)src[i];
+  }
+#else
+  if (dst != src) {
+    memcpy(dst, src, n * sizeof(complex));
+  }
+#endif
+}
+
 void plan_fircore(FIRCORE a) {
   // must call for change in 'nc', 'size', 'out', 'pfactor'
   int i;
@@ -270,29 +296,34 @@ void plan_fircore(FIRCORE a) {
   a->cset = 0;
   a->buffidx = 0;
   a->idxmask = a->nfor - 1;
-  a->fftin = (double *) malloc0(2 * a->size * sizeof(complex));
-  a->fftout   = (double **) malloc0(a->nfor * sizeof(double *));
-  a->fmask    = (double ***) malloc0(2 * sizeof(double **));
-  a->fmask[0] = (double **) malloc0(a->nfor * sizeof(double *));
-  a->fmask[1] = (double **) malloc0(a->nfor * sizeof(double *));
-  a->maskgen = (double *) malloc0(2 * a->size * sizeof(complex));
-  a->pcfor = (fftw_plan *) malloc0(a->nfor * sizeof(fftw_plan));
-  a->maskplan    = (fftw_plan **) malloc0(2 * sizeof(fftw_plan *));
-  a->maskplan[0] = (fftw_plan *) malloc0(a->nfor * sizeof(fftw_plan));
-  a->maskplan[1] = (fftw_plan *) malloc0(a->nfor * sizeof(fftw_plan));
+  a->fftin = (fir_real *) malloc0(2 * a->size * sizeof(fir_complex));
+  a->fftout   = (fir_real **) malloc0(a->nfor * sizeof(fir_real *));
+  a->fmask    = (fir_real ***) malloc0(2 * sizeof(fir_real **));
+  a->fmask[0] = (fir_real **) malloc0(a->nfor * sizeof(fir_real *));
+  a->fmask[1] = (fir_real **) malloc0(a->nfor * sizeof(fir_real *));
+  a->maskgen = (fir_real *) malloc0(2 * a->size * sizeof(fir_complex));
+  a->pcfor = (fir_plan *) malloc0(a->nfor * sizeof(fir_plan));
+  a->maskplan    = (fir_plan **) malloc0(2 * sizeof(fir_plan *));
+  a->maskplan[0] = (fir_plan *) malloc0(a->nfor * sizeof(fir_plan));
+  a->maskplan[1] = (fir_plan *) malloc0(a->nfor * sizeof(fir_plan));
   for (i = 0; i < a->nfor; i++) {
-    a->fftout[i]   = (double *) malloc0(2 * a->size * sizeof(complex));
-    a->fmask[0][i] = (double *) malloc0(2 * a->size * sizeof(complex));
-    a->fmask[1][i] = (double *) malloc0(2 * a->size * sizeof(complex));
-    a->pcfor[i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->fftin, (fftw_complex *)a->fftout[i], FFTW_FORWARD,
-                                   FFTW_PATIENT);
-    a->maskplan[0][i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[0][i],
-                                         FFTW_FORWARD, FFTW_PATIENT);
-    a->maskplan[1][i] = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->maskgen, (fftw_complex *)a->fmask[1][i],
-                                         FFTW_FORWARD, FFTW_PATIENT);
+    a->fftout[i]   = (fir_real *) malloc0(2 * a->size * sizeof(fir_complex));
+    a->fmask[0][i] = (fir_real *) malloc0(2 * a->size * sizeof(fir_complex));
+    a->fmask[1][i] = (fir_real *) malloc0(2 * a->size * sizeof(fir_complex));
+    a->pcfor[i] = fir_plan_dft_1d(2 * a->size, (fir_complex *)a->fftin, (fir_complex *)a->fftout[i], FFTW_FORWARD,
+                                  FFTW_PATIENT);
+    a->maskplan[0][i] = fir_plan_dft_1d(2 * a->size, (fir_complex *)a->maskgen, (fir_complex *)a->fmask[0][i],
+                                        FFTW_FORWARD, FFTW_PATIENT);
+    a->maskplan[1][i] = fir_plan_dft_1d(2 * a->size, (fir_complex *)a->maskgen, (fir_complex *)a->fmask[1][i],
+                                        FFTW_FORWARD, FFTW_PATIENT);
   }
-  a->accum = (double *) malloc0(2 * a->size * sizeof(complex));
-  a->crev = fftw_plan_dft_1d(2 * a->size, (fftw_complex *)a->accum, (fftw_complex *)a->out, FFTW_BACKWARD, FFTW_PATIENT);
+  a->accum = (fir_real *) malloc0(2 * a->size * sizeof(fir_complex));
+#ifdef WDSP_FLOAT_FIR
+  a->fout = (fir_real *) malloc0(2 * a->size * sizeof(fir_complex));
+#else
+  a->fout = a->out;
+#endif
+  a->crev = fir_plan_dft_1d(2 * a->size, (fir_complex *)a->accum, (fir_complex *)a->fout, FFTW_BACKWARD, FFTW_PATIENT);
   a->masks_ready = 0;
   a->pminphase = create_minphase(a->nc, a->pfactor);
 }
@@ -309,8 +340,8 @@ void calc_fircore(FIRCORE a, int flip) {
   for (i = 0; i < a->nfor; i++) {
     // I right-justified the impulse response => take output from left side of output buff, discard right side
     // Be careful about flipping an asymmetrical impulse response.
-    memcpy(&(a->maskgen[2 * a->size]), &(a->imp[2 * a->size * i]), a->size * sizeof(complex));
-    fftw_execute(a->maskplan[1 - a->cset][i]);
+    fir_load(&(a->maskgen[2 * a->size]), &(a->imp[2 * a->size * i]), a->size);
+    fir_execute(a->maskplan[1 - a->cset][i]);
   }
   a->masks_ready = 1;
   if (flip) {
@@ -341,15 +372,18 @@ FIRCORE create_fircore(int size, double *in, double *out, int nc,
 
 void deplan_fircore(FIRCORE a) {
   destroy_minphase(a->pminphase);
-  fftw_destroy_plan(a->crev);
+  fir_destroy_plan(a->crev);
+#ifdef WDSP_FLOAT_FIR
+  _aligned_free(a->fout);
+#endif
   _aligned_free(a->accum);
   for (int i = 0; i < a->nfor; i++) {
     _aligned_free(a->fftout[i]);
     _aligned_free(a->fmask[0][i]);
     _aligned_free(a->fmask[1][i]);
-    fftw_destroy_plan(a->pcfor[i]);
-    fftw_destroy_plan(a->maskplan[0][i]);
-    fftw_destroy_plan(a->maskplan[1][i]);
+    fir_destroy_plan(a->pcfor[i]);
+    fir_destroy_plan(a->maskplan[0][i]);
+    fir_destroy_plan(a->maskplan[1][i]);
   }
   _aligned_free(a->maskplan[0]);
   _aligned_free(a->maskplan[1]);
@@ -373,23 +407,23 @@ void destroy_fircore(FIRCORE a) {
 
 void flush_fircore(FIRCORE a) {
   int i;
-  memset(a->fftin, 0, 2 * a->size * sizeof(complex));
+  memset(a->fftin, 0, 2 * a->size * sizeof(fir_complex));
   for (i = 0; i < a->nfor; i++) {
-    memset(a->fftout[i], 0, 2 * a->size * sizeof(complex));
+    memset(a->fftout[i], 0, 2 * a->size * sizeof(fir_complex));
   }
   a->buffidx = 0;
 }
 
 void xfircore(FIRCORE a) {
   int i, j, k;
-  memcpy(&(a->fftin[2 * a->size]), a->in, a->size * sizeof(complex));
-  fftw_execute(a->pcfor[a->buffidx]);
+  fir_load(&(a->fftin[2 * a->size]), a->in, a->size);
+  fir_execute(a->pcfor[a->buffidx]);
   k = a->buffidx;
-  memset(a->accum, 0, 2 * a->size * sizeof(complex));
+  memset(a->accum, 0, 2 * a->size * sizeof(fir_complex));
   EnterCriticalSection(&a->update);
-  double *accum = a->accum;
-  double **fftout = a->fftout;
-  double ***fmask = a->fmask;
+  fir_real *accum = a->accum;
+  fir_real **fftout = a->fftout;
+  fir_real ***fmask = a->fmask;
   int cset = a->cset;
   int idxmask = a->idxmask;
   int sz = a->size;
@@ -403,8 +437,9 @@ void xfircore(FIRCORE a) {
   }
   LeaveCriticalSection(&a->update);
   a->buffidx = (a->buffidx + 1) & idxmask;
-  fftw_execute(a->crev);
-  memcpy(a->fftin, &(a->fftin[2 * a->size]), a->size * sizeof(complex));
+  fir_execute(a->crev);
+  fir_store(a->out, a->fout, a->size);
+  memcpy(a->fftin, &(a->fftin[2 * a->size]), a->size * sizeof(fir_complex));
 }
 
 void setBuffers_fircore(FIRCORE a, double *in, double *out) {
@@ -135,6 +135,27 @@ extern void setFreqs_firopt (FIROPT a, double f_low, double f_high);
 
 #include "fir.h"
 
+//
+// With WDSP_FLOAT_FIR the frequency-domain part of the kernel (FFTs, masks,
+// delay line, MAC loop) runs in single precision. The in/out buffers and the
+// impulse response stay double, so callers are not affected.
+//
+#ifdef WDSP_FLOAT_FIR
+typedef float fir_real;
+typedef fftwf_plan fir_plan;
+typedef fftwf_complex fir_complex;
+#define fir_plan_dft_1d fftwf_plan_dft_1d
+#define fir_execute fftwf_execute
+#define fir_destroy_plan fftwf_destroy_plan
+#else
+typedef double fir_real;
+typedef fftw_plan fir_plan;
+typedef fftw_complex fir_complex;
+#define fir_plan_dft_1d fftw_plan_dft_1d
+#define fir_execute fftw_execute
+#define fir_destroy_plan fftw_destroy_plan
+#endif
+
 typedef struct _fircore {
   int size;       // input/output buffer size, power of two
   double *in;       // input buffer
@@ -143,16 +164,17 @@ typedef struct _fircore {
   double *impulse;    // impulse response of filter
   double *imp;
   int nfor;       // number of buffers in delay line
-  double *fftin;      // fft input buffer
-  double ***fmask;    // frequency domain masks
-  double **fftout;    // fftout delay line
-  double *accum;      // frequency domain accumulator
+  fir_real *fftin;    // fft input buffer
+  fir_real ***fmask;  // frequency domain masks
+  fir_real **fftout;  // fftout delay line
+  fir_real *accum;    // frequency domain accumulator
+  fir_real *fout;     // reverse fft output (== out in the double build)
   int buffidx;      // fft out buffer index
   int idxmask;      // mask for index computations
-  double *maskgen;    // input for mask generation FFT
-  fftw_plan *pcfor;   // array of forward FFT plans
-  fftw_plan crev;     // reverse fft plan
-  fftw_plan **maskplan; // plans for frequency domain masks
+  fir_real *maskgen;  // input for mask generation FFT
+  fir_plan *pcfor;    // array of forward FFT plans
+  fir_plan crev;      // reverse fft plan
+  fir_plan **maskplan; // plans for frequency domain masks
   CRITICAL_SECTION update;
   int cset;
   int mp;
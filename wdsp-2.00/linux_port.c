@@ -27,6 +27,7 @@ john.d.melton@googlemail.com
 
 #include <errno.h>
 #include <inttypes.h>
+#include <sched.h>
 #include <semaphore.h>
 #include <time.h>
 
@@ -60,6 +61,12 @@ void wdsp_aligned_free(void *ptr) {
   free(ptr);
 }
 
+double wdsp_time_ms(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return 1000.0 * (double)now.tv_sec + 1.0e-6 * (double)now.tv_nsec;
+}
+
 void wdsp_sleep_ms(unsigned int milliseconds) {
   struct timespec request = {
     .tv_sec = milliseconds / 1000U,
@@ -69,6 +76,19 @@ void wdsp_sleep_ms(unsigned int milliseconds) {
   }
 }
 
+#ifdef __linux__
+//
+// CPU mask of the process, taken at start-up before any thread is pinned.
+// Threads started by _beginthread() get this mask, see there.
+//
+static cpu_set_t process_cpus;
+static int process_cpus_valid = 0;
+
+__attribute__((constructor)) static void save_process_cpus(void) {
+  process_cpus_valid = sched_getaffinity(0, sizeof(process_cpus), &process_cpus) == 0;
+}
+#endif
+
 void QueueUserWorkItem(void *function, void *context, int flags) {
   pthread_t t;
   pthread_create(&t, NULL, function, context);
@@ -263,6 +283,24 @@ HANDLE _beginthread(void(__cdecl *start_address)(void *), unsigned stack_size, v
     pthread_attr_destroy(&attr);
     return (HANDLE) -1;
   }
+#ifdef __linux__
+  //
+  // Helper threads (analyzer, flushChannel, PureSignal) are often started
+  // from a pinned real-time thread, e.g. the spectrum thread from the IQ
+  // thread. Do not let them inherit its policy and CPU mask, where they
+  // would compete with their creator. WDSP channel threads get the settings
+  // of their own role via the channel thread callback.
+  //
+  {
+    struct sched_param param = { 0 };
+    (void) pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    (void) pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+    (void) pthread_attr_setschedparam(&attr, &param);
+    if (process_cpus_valid) {
+      (void) pthread_attr_setaffinity_np(&attr, sizeof(process_cpus), &process_cpus);
+    }
+  }
+#endif
   if (pthread_create(&threadid, &attr, (void * (*)(void *))start_address, arglist)) {
     pthread_attr_destroy(&attr);
     return (HANDLE) -1;
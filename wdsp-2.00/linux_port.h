@@ -70,6 +70,7 @@ john.d.melton@googlemail.com
   void *wdsp_aligned_malloc(size_t size, size_t alignment);
   void wdsp_aligned_free(void *ptr);
   void wdsp_sleep_ms(unsigned int milliseconds);
+  double wdsp_time_ms(void);
 
   #define _aligned_malloc(size, alignment) wdsp_aligned_malloc((size), (alignment))
   #define _aligned_free(ptr) wdsp_aligned_free(ptr)
@@ -26,6 +26,17 @@ warren@wpratt.com
 
 #include "comm.h"
 
+//
+// Called at the start of each channel thread, such that the application
+// can set CPU affinity and scheduling of the channel threads.
+//
+static void (*channel_thread_cb)(int channel) = NULL;
+
+PORT
+void SetChannelThreadCallback(void (*cb)(int channel)) {
+  channel_thread_cb = cb;
+}
+
 void wdspmain(void *pargs) {
 #if defined(_WIN32)
   DWORD taskIndex = 0;
@@ -34,6 +45,9 @@ void wdspmain(void *pargs) {
   else { SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST); }
 #endif
   int channel = (int)(uintptr_t)pargs;
+  if (channel_thread_cb != NULL) {
+    channel_thread_cb(channel);
+  }
   while (_InterlockedAnd(&ch[channel].run, 1)) {
     WaitForSingleObject(ch[channel].iob.pd->Sem_BuffReady, INFINITE);
     EnterCriticalSection(&ch[channel].csDSP);
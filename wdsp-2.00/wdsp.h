@@ -99,6 +99,10 @@ extern void SetRXAMode(int channel, int mode);
 extern void RXASetPassband(int channel, double f_low, double f_high);
 extern void RXASetNC(int channel, int nc);
 extern void RXASetMP(int channel, int mp);
+extern int GetRXAStageCount(void);
+extern const char *GetRXAStageName(int stage);
+extern void SetRXAStageProfile(int channel, int run);
+extern int GetRXAStageProfile(int channel, int stage, long *calls, double *avg_us, double *max_us);
 
 //
 // Interfaces from TXA.c
@@ -339,6 +343,12 @@ extern void SetChannelTSlewUp(int channel, double time);
 extern void SetChannelTDelayDown(int channel, double time);
 extern void SetChannelTSlewDown(int channel, double time);
 
+//
+// Interfaces from main.c
+//
+
+extern void SetChannelThreadCallback(void (*cb)(int channel));
+
 //
 // Interfaces from compress.c
 //
@@ -34,6 +34,49 @@ char *wisdom_get_status() {
   return status;
 }
 
+#ifdef WDSP_FLOAT_FIR
+//
+// The single-precision fircore kernel plans complex fftwf transforms with
+// FFTW_PATIENT. Their wisdom lives in a separate file, without it every
+// filter (re-)plan would do the full PATIENT search at run time.
+//
+static int WDSPwisdom_float(char *directory) {
+  fftwf_plan tplan;
+  int psize;
+  float *fftin;
+  float *fftout;
+  char wisdom_file[1024];
+  const int maxsize = MAX_WISDOM_SIZE + 1;
+  strcpy(wisdom_file, directory);
+  strncat(wisdom_file, "wdspWisdom01f", 16);
+  if (fftwf_import_wisdom_from_filename(wisdom_file)) {
+    return 0;
+  }
+  fftin = (float *) malloc0(maxsize * sizeof(fftwf_complex));
+  fftout = (float *) malloc0(maxsize * sizeof(fftwf_complex));
+  psize = 64;
+  while (psize <= MAX_WISDOM_SIZE) {
+    fprintf(stdout, "Planning FLOAT COMPLEX FORWARD  FFT size %d\n", psize);
+    fflush(stdout);
+    sprintf(status, "Planning FLOAT COMPLEX FORWARD  FFT size %d\n", psize);
+    tplan = fftwf_plan_dft_1d(psize, (fftwf_complex *)fftin, (fftwf_complex *)fftout, FFTW_FORWARD, FFTW_PATIENT);
+    fftwf_execute(tplan);
+    fftwf_destroy_plan(tplan);
+    fprintf(stdout, "Planning FLOAT COMPLEX BACKWARD FFT size %d\n", psize);
+    fflush(stdout);
+    sprintf(status, "Planning FLOAT COMPLEX BACKWARD FFT size %d\n", psize);
+    tplan = fftwf_plan_dft_1d(psize, (fftwf_complex *)fftin, (fftwf_complex *)fftout, FFTW_BACKWARD, FFTW_PATIENT);
+    fftwf_execute(tplan);
+    fftwf_destroy_plan(tplan);
+    psize *= 2;
+  }
+  fftwf_export_wisdom_to_filename(wisdom_file);
+  _aligned_free(fftout);
+  _aligned_free(fftin);
+  return 1;
+}
+#endif
+
 PORT
 int WDSPwisdom(char *directory) {
   int wisdom_return = 0; // 0 from existing, 1 rebuilt
@@ -107,5 +150,10 @@ int WDSPwisdom(char *directory) {
 #endif
     wisdom_return = 1;
   }
+#ifdef WDSP_FLOAT_FIR
+  if (WDSPwisdom_float(directory)) {
+    wisdom_return = 1;
+  }
+#endif
   return wisdom_return;
 }